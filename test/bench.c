@@ -0,0 +1,255 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bench.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Benchmark suite.
+ * @details Runs seeded workloads covering each condition type, each
+ * prediction type and both learning modes, and reports the trials per
+ * second, per-phase times, population memory and peak resident set size as
+ * JSON.
+ *
+ * Usage: bench [seed] [filter]
+ *
+ * Only workloads whose name contains the filter string are run.
+ */
+
+#include "../xcsf/action.h"
+#include "../xcsf/clset.h"
+#include "../xcsf/condition.h"
+#include "../xcsf/env.h"
+#include "../xcsf/pa.h"
+#include "../xcsf/param.h"
+#include "../xcsf/prediction.h"
+#include "../xcsf/prof.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcs_rl.h"
+#include "../xcsf/xcs_supervised.h"
+#include "../xcsf/xcsf.h"
+
+#ifndef _WIN32
+    #include <sys/resource.h>
+#endif
+
+#ifndef BENCH_MAZE
+    #define BENCH_MAZE ("env/maze/maze4.txt") //!< Maze used for benchmarking
+#endif
+
+#define BENCH_SUPERVISED (0) //!< Synthetic regression workload
+#define BENCH_MUX (1) //!< Real multiplexer workload
+#define BENCH_MAZE_RL (2) //!< Maze workload
+
+#define BENCH_X_DIM (4) //!< Synthetic regression input dimensions
+#define BENCH_SAMPLES (1000) //!< Synthetic regression training samples
+#define BENCH_POP_SIZE (1000) //!< Maximum population size
+#define BENCH_SEED (1) //!< Default random number generator seed
+
+/**
+ * @brief Benchmark workload data structure.
+ */
+struct BenchCase {
+    const char *name; //!< Workload name
+    int mode; //!< Learning mode
+    int cond; //!< Condition type
+    int pred; //!< Prediction type
+    int trials; //!< Number of learning trials
+};
+
+static const struct BenchCase bench_cases[] = {
+    { "supervised/rectangle/nlms", BENCH_SUPERVISED, COND_TYPE_HYPERRECTANGLE,
+      PRED_TYPE_NLMS_LINEAR, 20000 },
+    { "supervised/ellipsoid/nlms", BENCH_SUPERVISED, COND_TYPE_HYPERELLIPSOID,
+      PRED_TYPE_NLMS_LINEAR, 20000 },
+    { "supervised/ternary/nlms", BENCH_SUPERVISED, COND_TYPE_TERNARY,
+      PRED_TYPE_NLMS_LINEAR, 20000 },
+    { "supervised/gp/nlms", BENCH_SUPERVISED, COND_TYPE_GP,
+      PRED_TYPE_NLMS_LINEAR, 5000 },
+    { "supervised/dgp/nlms", BENCH_SUPERVISED, COND_TYPE_DGP,
+      PRED_TYPE_NLMS_LINEAR, 5000 },
+    { "supervised/neural/nlms", BENCH_SUPERVISED, COND_TYPE_NEURAL,
+      PRED_TYPE_NLMS_LINEAR, 5000 },
+    { "supervised/rectangle/constant", BENCH_SUPERVISED,
+      COND_TYPE_HYPERRECTANGLE, PRED_TYPE_CONSTANT, 20000 },
+    { "supervised/rectangle/rls", BENCH_SUPERVISED, COND_TYPE_HYPERRECTANGLE,
+      PRED_TYPE_RLS_LINEAR, 20000 },
+    { "supervised/rectangle/neural", BENCH_SUPERVISED,
+      COND_TYPE_HYPERRECTANGLE, PRED_TYPE_NEURAL, 5000 },
+    { "mux/rectangle/constant", BENCH_MUX, COND_TYPE_HYPERRECTANGLE,
+      PRED_TYPE_CONSTANT, 10000 },
+    { "maze/rectangle/constant", BENCH_MAZE_RL, COND_TYPE_HYPERRECTANGLE,
+      PRED_TYPE_CONSTANT, 500 },
+}; //!< Benchmark workloads
+
+/**
+ * @brief Returns the peak resident set size of the process.
+ * @return The peak resident set size in kilobytes (0 if unavailable).
+ */
+static long
+bench_peak_rss(void)
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    #ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+    #else
+    return usage.ru_maxrss;
+    #endif
+#endif
+}
+
+/**
+ * @brief Creates a synthetic regression problem.
+ * @return The training data.
+ */
+static struct Input *
+bench_data(void)
+{
+    struct Input *data = malloc(sizeof(struct Input));
+    data->x_dim = BENCH_X_DIM;
+    data->y_dim = 1;
+    data->n_samples = BENCH_SAMPLES;
+    data->x = malloc(sizeof(double) * BENCH_X_DIM * BENCH_SAMPLES);
+    data->y = malloc(sizeof(double) * BENCH_SAMPLES);
+    for (int i = 0; i < BENCH_SAMPLES; ++i) {
+        double *x = &data->x[i * BENCH_X_DIM];
+        for (int j = 0; j < BENCH_X_DIM; ++j) {
+            x[j] = rand_uniform(0, 1);
+        }
+        data->y[i] = sin(2 * M_PI * x[0]) * x[1] + x[2] * x[2] - x[3];
+    }
+    return data;
+}
+
+/**
+ * @brief Prints the per-phase timers of a workload as JSON.
+ * @param [in] xcsf The XCSF data structure.
+ */
+static void
+bench_print_phases(const struct XCSF *xcsf)
+{
+    printf("\"phases\": {");
+    for (int i = 0; i < PROF_PHASES; ++i) {
+        printf("%s\"%s\": {\"calls\": %" PRIu64
+               ", \"time\": %.6f, \"self_time\": %.6f}",
+               (i > 0) ? ", " : "", prof_phase_as_string(i),
+               xcsf->prof->calls[i], xcsf->prof->time[i],
+               xcsf->prof->self[i]);
+    }
+    printf("}");
+}
+
+/**
+ * @brief Runs a workload and prints the results as JSON.
+ * @param [in] bc The workload to run.
+ * @param [in] seed The random number generator seed.
+ */
+static void
+bench_run(const struct BenchCase *bc, const uint32_t seed)
+{
+    struct XCSF *xcsf = malloc(sizeof(struct XCSF));
+    struct Input *data = NULL;
+    rand_init_seed(seed);
+    if (bc->mode == BENCH_SUPERVISED) {
+        param_init(xcsf, BENCH_X_DIM, 1, 1);
+        data = bench_data();
+    } else {
+        char type[5] = "mp";
+        char problem[FILENAME_MAX] = "6";
+        if (bc->mode == BENCH_MAZE_RL) {
+            snprintf(type, sizeof(type), "maze");
+            snprintf(problem, sizeof(problem), "%s", BENCH_MAZE);
+        }
+        char *argv[3] = { NULL, type, problem };
+        env_init(xcsf, argv);
+    }
+    param_set_max_trials(xcsf, bc->trials);
+    param_set_perf_trials(xcsf, bc->trials + 1); // no performance output
+    param_set_pop_size(xcsf, BENCH_POP_SIZE);
+    param_set_profile(xcsf, true);
+    action_param_set_type(xcsf, ACT_TYPE_INTEGER);
+    cond_param_set_type(xcsf, bc->cond);
+    pred_param_set_type(xcsf, bc->pred);
+    xcsf_init(xcsf);
+    clset_pset_init(xcsf);
+    pa_init(xcsf);
+    const double start = prof_time();
+    if (bc->mode == BENCH_SUPERVISED) {
+        xcs_supervised_fit(xcsf, data, NULL, true);
+    } else {
+        xcs_rl_exp(xcsf);
+    }
+    const double seconds = prof_time() - start;
+    printf("    {\"name\": \"%s\", \"trials\": %d, \"seconds\": %.6f, ", bc->name,
+           bc->trials, seconds);
+    struct SetMemSize mem;
+    clset_mem_size(xcsf, &xcsf->pset, &mem);
+    printf("\"trials_per_sec\": %.3f, \"pset_size\": %d, ",
+           bc->trials / seconds, xcsf->pset.size);
+    printf("\"pset_bytes\": {\"cond\": %zu, \"pred\": %zu, ", mem.cond,
+           mem.pred);
+    printf("\"act\": %zu, \"total\": %zu}, ", mem.act, mem.total);
+    bench_print_phases(xcsf);
+    printf(", \"peak_rss_kb\": %ld}", bench_peak_rss());
+    fflush(stdout);
+    pa_free(xcsf);
+    if (data != NULL) {
+        free(data->x);
+        free(data->y);
+        free(data);
+    } else {
+        env_free(xcsf);
+    }
+    xcsf_free(xcsf);
+    param_free(xcsf);
+    free(xcsf);
+}
+
+int
+main(int argc, char **argv)
+{
+    if (argc > 3) {
+        printf("Usage: bench [seed] [filter]\n");
+        exit(EXIT_FAILURE);
+    }
+    const uint32_t seed =
+        (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 10) : BENCH_SEED;
+    const char *filter = (argc > 2) ? argv[2] : "";
+#ifdef PARALLEL
+    const bool parallel = true;
+#else
+    const bool parallel = false;
+#endif
+    printf("{\"version\": \"%d.%d.%d\", \"seed\": %u, \"parallel\": %s,\n",
+           VERSION_MAJOR, VERSION_MINOR, VERSION_BUILD, (unsigned) seed,
+           parallel ? "true" : "false");
+    printf("  \"results\": [\n");
+    const int n = sizeof(bench_cases) / sizeof(bench_cases[0]);
+    bool first = true;
+    for (int i = 0; i < n; ++i) {
+        if (strstr(bench_cases[i].name, filter) != NULL) {
+            printf("%s", first ? "" : ",\n");
+            bench_run(&bench_cases[i], seed);
+            first = false;
+        }
+    }
+    printf("\n  ]\n}\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,502 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bench_kernels.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Microbenchmarks of the numerical kernels.
+ * @details Times the blas routines, im2col/col2im, the activation functions,
+ * and the forward and backward passes of each neural network layer type,
+ * and prints one line per kernel: the name, GFLOP/s (0 where not
+ * applicable), and nanoseconds per element. The output may be saved and
+ * later supplied as a baseline, in which case the speedup relative to the
+ * baseline is also printed and kernels more than 20% slower are marked.
+ *
+ * Usage: bench_kernels [baseline.txt]
+ */
+
+#include "../xcsf/blas.h"
+#include "../xcsf/image.h"
+#include "../xcsf/neural.h"
+#include "../xcsf/neural_activations.h"
+#include "../xcsf/neural_layer.h"
+#include "../xcsf/prof.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcsf.h"
+
+#define KB_MIN_TIME (0.05) //!< Minimum seconds per timing round
+#define KB_ROUNDS (5) //!< Number of timing rounds per kernel
+#define KB_MAX_BASE (256) //!< Maximum number of baseline entries
+#define KB_NAME_LEN (64) //!< Maximum length of a kernel name
+#define KB_SLOWER (0.8) //!< Speedup below which a regression is marked
+
+/**
+ * @brief Baseline kernel timings data structure.
+ */
+struct KbBaseline {
+    char name[KB_MAX_BASE][KB_NAME_LEN]; //!< Kernel names
+    double ns[KB_MAX_BASE]; //!< Nanoseconds per element
+    int size; //!< Number of entries
+};
+
+/**
+ * @brief Matrix multiplication benchmark arguments.
+ */
+struct KbGemm {
+    int ta; //!< Whether to transpose A
+    int tb; //!< Whether to transpose B
+    int m; //!< Rows of C
+    int n; //!< Columns of C
+    int k; //!< Inner dimension
+    double *a; //!< Matrix A
+    double *b; //!< Matrix B
+    double *c; //!< Matrix C
+};
+
+/**
+ * @brief Vector benchmark arguments.
+ */
+struct KbVec {
+    int n; //!< Number of elements
+    int a; //!< Activation function (activation benchmarks only)
+    double *x; //!< First vector
+    double *y; //!< Second vector
+};
+
+/**
+ * @brief Image benchmark arguments.
+ */
+struct KbImage {
+    int channels; //!< Number of image channels
+    int height; //!< Image height
+    int width; //!< Image width
+    int ksize; //!< Kernel size
+    int stride; //!< Kernel stride
+    int pad; //!< Padding
+    double *im; //!< Image
+    double *col; //!< Columns
+};
+
+/**
+ * @brief Layer benchmark arguments.
+ */
+struct KbLayer {
+    struct Layer *l; //!< The layer
+    struct Net net; //!< Network containing the layer
+    double *input; //!< Layer input
+    double *delta; //!< Previous layer delta
+};
+
+static volatile double kb_sink = 0; //!< Prevents results being optimised out
+
+/**
+ * @brief Returns a vector of random values.
+ * @param [in] n The number of elements.
+ * @return The vector.
+ */
+static double *
+kb_rand_vec(const int n)
+{
+    double *x = malloc(sizeof(double) * n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = rand_uniform(-1, 1);
+    }
+    return x;
+}
+
+/**
+ * @brief Returns the mean seconds taken by a number of calls to a kernel.
+ * @param [in] fn The kernel.
+ * @param [in] arg The kernel arguments.
+ * @param [in] reps The number of calls.
+ * @return The mean seconds per call.
+ */
+static double
+kb_time_reps(void (*fn)(const void *), const void *arg, const int reps)
+{
+    const double start = prof_time();
+    for (int i = 0; i < reps; ++i) {
+        fn(arg);
+    }
+    return (prof_time() - start) / reps;
+}
+
+/**
+ * @brief Returns the seconds per call of a kernel.
+ * @details The number of calls per round is doubled until a round takes at
+ * least KB_MIN_TIME seconds, and the fastest of KB_ROUNDS such rounds is
+ * returned to reduce the noise from other processes.
+ * @param [in] fn The kernel.
+ * @param [in] arg The kernel arguments.
+ * @return The mean seconds per call of the fastest round.
+ */
+static double
+kb_time(void (*fn)(const void *), const void *arg)
+{
+    fn(arg);
+    int reps = 1;
+    double best = kb_time_reps(fn, arg, reps);
+    while (best * reps < KB_MIN_TIME) {
+        reps *= 2;
+        best = kb_time_reps(fn, arg, reps);
+    }
+    for (int i = 1; i < KB_ROUNDS; ++i) {
+        best = fmin(best, kb_time_reps(fn, arg, reps));
+    }
+    return best;
+}
+
+/**
+ * @brief Reads a baseline file.
+ * @param [in] filename The name of the baseline file.
+ * @param [out] base The baseline timings.
+ */
+static void
+kb_baseline_read(const char *filename, struct KbBaseline *base)
+{
+    base->size = 0;
+    FILE *fp = fopen(filename, "rt");
+    if (fp == 0) {
+        printf("Error opening file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    char line[256];
+    while (base->size < KB_MAX_BASE && fgets(line, sizeof(line), fp) != NULL) {
+        double gflops = 0;
+        if (line[0] != '#' &&
+            sscanf(line, "%63s %lf %lf", base->name[base->size], &gflops,
+                   &base->ns[base->size]) == 3) {
+            ++(base->size);
+        }
+    }
+    fclose(fp);
+}
+
+/**
+ * @brief Times a kernel and prints the results.
+ * @param [in] name The name of the kernel.
+ * @param [in] fn The kernel.
+ * @param [in] arg The kernel arguments.
+ * @param [in] flops The floating point operations per call (0 if none).
+ * @param [in] elems The elements processed per call.
+ * @param [in] base The baseline timings (NULL if none).
+ */
+static void
+kb_run(const char *name, void (*fn)(const void *), const void *arg,
+       const double flops, const double elems, const struct KbBaseline *base)
+{
+    const double secs = kb_time(fn, arg);
+    const double gflops = flops / secs * 1e-9;
+    const double ns = secs * 1e9 / elems;
+    printf("%-36s %10.4f %12.4f", name, gflops, ns);
+    if (base != NULL) {
+        for (int i = 0; i < base->size; ++i) {
+            if (strcmp(base->name[i], name) == 0) {
+                const double speedup = base->ns[i] / ns;
+                printf(" %8.3fx%s", speedup,
+                       (speedup < KB_SLOWER) ? " REGRESSION" : "");
+                break;
+            }
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+/**
+ * @brief Matrix multiplication kernel.
+ * @param [in] arg The matrix multiplication arguments.
+ */
+static void
+kb_gemm(const void *arg)
+{
+    const struct KbGemm *g = arg;
+    const int lda = g->ta ? g->m : g->k;
+    const int ldb = g->tb ? g->k : g->n;
+    blas_gemm(g->ta, g->tb, g->m, g->n, g->k, 1, g->a, lda, g->b, ldb, 1,
+              g->c, g->n);
+}
+
+/**
+ * @brief Dot product kernel.
+ * @param [in] arg The vector arguments.
+ */
+static void
+kb_dot(const void *arg)
+{
+    const struct KbVec *v = arg;
+    kb_sink += blas_dot(v->n, v->x, 1, v->y, 1);
+}
+
+/**
+ * @brief Scaled vector addition kernel.
+ * @param [in] arg The vector arguments.
+ */
+static void
+kb_axpy(const void *arg)
+{
+    const struct KbVec *v = arg;
+    blas_axpy(v->n, 1e-6, v->x, 1, v->y, 1);
+}
+
+/**
+ * @brief Activation function kernel.
+ * @param [in] arg The vector arguments.
+ */
+static void
+kb_activate(const void *arg)
+{
+    const struct KbVec *v = arg;
+    neural_activate_array(v->x, v->y, v->n, v->a);
+}
+
+/**
+ * @brief Image to column kernel.
+ * @param [in] arg The image arguments.
+ */
+static void
+kb_im2col(const void *arg)
+{
+    const struct KbImage *m = arg;
+    im2col(m->im, m->channels, m->height, m->width, m->ksize, m->stride,
+           m->pad, m->col);
+}
+
+/**
+ * @brief Column to image kernel.
+ * @param [in] arg The image arguments.
+ */
+static void
+kb_col2im(const void *arg)
+{
+    const struct KbImage *m = arg;
+    col2im(m->col, m->channels, m->height, m->width, m->ksize, m->stride,
+           m->pad, m->im);
+}
+
+/**
+ * @brief Layer forward propagation kernel.
+ * @param [in] arg The layer arguments.
+ */
+static void
+kb_forward(const void *arg)
+{
+    const struct KbLayer *b = arg;
+    layer_forward(b->l, &b->net, b->input);
+}
+
+/**
+ * @brief Layer backward propagation kernel.
+ * @param [in] arg The layer arguments.
+ */
+static void
+kb_backward(const void *arg)
+{
+    const struct KbLayer *b = arg;
+    layer_backward(b->l, &b->net, b->input, b->delta);
+}
+
+/**
+ * @brief Benchmarks the matrix multiplication variants.
+ * @param [in] base The baseline timings (NULL if none).
+ */
+static void
+kb_bench_gemm(const struct KbBaseline *base)
+{
+    const int sizes[5][5] = {
+        { 0, 0, 128, 128, 128 }, { 0, 1, 128, 128, 128 },
+        { 1, 0, 128, 128, 128 }, { 1, 1, 128, 128, 128 },
+        { 0, 1, 1, 128, 256 }, // connected layer forward
+    };
+    for (int i = 0; i < 5; ++i) {
+        struct KbGemm g = { sizes[i][0], sizes[i][1], sizes[i][2],
+                            sizes[i][3], sizes[i][4], NULL, NULL, NULL };
+        g.a = kb_rand_vec(g.m * g.k);
+        g.b = kb_rand_vec(g.k * g.n);
+        g.c = kb_rand_vec(g.m * g.n);
+        char name[KB_NAME_LEN];
+        snprintf(name, sizeof(name), "gemm_%s%s_%dx%dx%d", g.ta ? "t" : "n",
+                 g.tb ? "t" : "n", g.m, g.n, g.k);
+        kb_run(name, kb_gemm, &g, 2. * g.m * g.n * g.k, (double) g.m * g.n,
+               base);
+        free(g.a);
+        free(g.b);
+        free(g.c);
+    }
+}
+
+/**
+ * @brief Benchmarks the vector kernels and activation functions.
+ * @param [in] base The baseline timings (NULL if none).
+ */
+static void
+kb_bench_vec(const struct KbBaseline *base)
+{
+    struct KbVec v = { 4096, 0, kb_rand_vec(4096), kb_rand_vec(4096) };
+    kb_run("dot_4096", kb_dot, &v, 2. * v.n, v.n, base);
+    kb_run("axpy_4096", kb_axpy, &v, 2. * v.n, v.n, base);
+    for (int a = 0; a < NUM_ACTIVATIONS; ++a) {
+        char name[KB_NAME_LEN];
+        snprintf(name, sizeof(name), "activate_%s_4096",
+                 neural_activation_string(a));
+        v.a = a;
+        kb_run(name, kb_activate, &v, 0, v.n, base);
+    }
+    free(v.x);
+    free(v.y);
+}
+
+/**
+ * @brief Benchmarks the image to column conversions.
+ * @param [in] base The baseline timings (NULL if none).
+ */
+static void
+kb_bench_image(const struct KbBaseline *base)
+{
+    struct KbImage m = { 3, 32, 32, 3, 1, 1, NULL, NULL };
+    const int n_col = m.channels * m.ksize * m.ksize * m.height * m.width;
+    m.im = kb_rand_vec(m.channels * m.height * m.width);
+    m.col = kb_rand_vec(n_col);
+    kb_run("im2col_3x32x32_k3", kb_im2col, &m, 0, n_col, base);
+    kb_run("col2im_3x32x32_k3", kb_col2im, &m, 0, n_col, base);
+    free(m.im);
+    free(m.col);
+}
+
+/**
+ * @brief Benchmarks the forward and backward passes of a layer.
+ * @param [in] name The name of the layer benchmark.
+ * @param [in] args The layer parameters.
+ * @param [in] flops The floating point operations per forward pass.
+ * @param [in] base The baseline timings (NULL if none).
+ */
+static void
+kb_bench_layer(const char *name, const struct ArgsLayer *args,
+               const double flops, const struct KbBaseline *base)
+{
+    struct KbLayer b;
+    neural_init(&b.net);
+    b.net.train = true;
+    b.l = layer_init(args);
+    b.input = kb_rand_vec(b.l->n_inputs);
+    b.delta = kb_rand_vec(b.l->n_inputs);
+    for (int i = 0; i < b.l->n_outputs; ++i) {
+        b.l->delta[i] = rand_uniform(-1e-3, 1e-3);
+    }
+    char fname[KB_NAME_LEN];
+    snprintf(fname, sizeof(fname), "%s_forward", name);
+    kb_run(fname, kb_forward, &b, flops, b.l->n_outputs, base);
+    snprintf(fname, sizeof(fname), "%s_backward", name);
+    kb_run(fname, kb_backward, &b, 2 * flops, b.l->n_outputs, base);
+    layer_free(b.l);
+    free(b.l);
+    free(b.input);
+    free(b.delta);
+}
+
+/**
+ * @brief Benchmarks each layer type at a representative size.
+ * @param [in] base The baseline timings (NULL if none).
+ */
+static void
+kb_bench_layers(const struct KbBaseline *base)
+{
+    struct ArgsLayer args;
+    layer_args_init(&args);
+    args.type = CONNECTED;
+    args.function = RELU;
+    args.n_inputs = 256;
+    args.n_init = 128;
+    args.n_max = 128;
+    args.eta = 0.01;
+    args.sgd_weights = true;
+    kb_bench_layer("connected_256x128", &args, 2. * 256 * 128, base);
+    args.type = RECURRENT;
+    args.n_inputs = 128;
+    kb_bench_layer("recurrent_128x128", &args, 3 * 2. * 128 * 128, base);
+    args.type = LSTM;
+    args.function = TANH;
+    args.recurrent_function = LOGISTIC;
+    args.n_inputs = 64;
+    args.n_init = 64;
+    args.n_max = 64;
+    kb_bench_layer("lstm_64x64", &args, 8 * 2. * 64 * 64, base);
+    layer_args_init(&args);
+    args.type = SOFTMAX;
+    args.n_inputs = 1024;
+    args.scale = 1;
+    kb_bench_layer("softmax_1024", &args, 0, base);
+    args.type = DROPOUT;
+    args.n_inputs = 4096;
+    args.probability = 0.5;
+    kb_bench_layer("dropout_4096", &args, 0, base);
+    args.type = NOISE;
+    args.scale = 0.5;
+    kb_bench_layer("noise_4096", &args, 0, base);
+    layer_args_init(&args);
+    args.type = CONVOLUTIONAL;
+    args.function = RELU;
+    args.height = 32;
+    args.width = 32;
+    args.channels = 3;
+    args.n_init = 16;
+    args.n_max = 16;
+    args.size = 3;
+    args.stride = 1;
+    args.pad = 1;
+    args.eta = 0.01;
+    args.sgd_weights = true;
+    kb_bench_layer("convolutional_3x32x32_f16", &args,
+                   2. * 16 * 3 * 3 * 3 * 32 * 32, base);
+    layer_args_init(&args);
+    args.type = MAXPOOL;
+    args.height = 32;
+    args.width = 32;
+    args.channels = 16;
+    args.size = 2;
+    args.stride = 2;
+    kb_bench_layer("maxpool_16x32x32", &args, 0, base);
+    args.type = AVGPOOL;
+    kb_bench_layer("avgpool_16x32x32", &args, 0, base);
+    args.type = UPSAMPLE;
+    args.height = 16;
+    args.width = 16;
+    kb_bench_layer("upsample_16x16x16", &args, 0, base);
+}
+
+int
+main(int argc, char **argv)
+{
+    if (argc > 2) {
+        printf("Usage: bench_kernels [baseline.txt]\n");
+        exit(EXIT_FAILURE);
+    }
+    struct KbBaseline *base = NULL;
+    if (argc == 2) {
+        base = malloc(sizeof(struct KbBaseline));
+        kb_baseline_read(argv[1], base);
+    }
+    rand_init_seed(1);
+    printf("# %-34s %10s %12s%s\n", "kernel", "GFLOP/s", "ns/element",
+           (base != NULL) ? "  speedup" : "");
+    kb_bench_gemm(base);
+    kb_bench_vec(base);
+    kb_bench_image(base);
+    kb_bench_layers(base);
+    free(base);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file checkpoint_test.cpp
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Checkpoint resume tests.
+ */
+
+#include "../lib/doctest/doctest/doctest.h"
+
+extern "C" {
+#include "../xcsf/checkpoint.h"
+#include "../xcsf/clset.h"
+#include "../xcsf/ea.h"
+#include "../xcsf/pa.h"
+#include "../xcsf/param.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcs_supervised.h"
+#include "../xcsf/xcsf.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+}
+
+#define CKPT_TEST_TRIALS (1000) //!< Number of trials of each run
+#define CKPT_TEST_EVERY (400) //!< Number of trials between checkpoints
+#define CKPT_TEST_SEED (11) //!< Random number generator seed of the runs
+
+/**
+ * @brief Initialises XCSF for a small regression problem.
+ * @details The EA runs at almost every trial so that an asynchronous EA
+ * request is pending when each checkpoint is taken, and a single thread is
+ * used so that the runs are reproducible to the last bit.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] async Whether to create offspring asynchronously.
+ */
+static void
+checkpoint_test_init(struct XCSF *xcsf, const bool async)
+{
+    param_init(xcsf, 2, 1, 1);
+    param_set_omp_num_threads(xcsf, 1); // reductions run in a fixed order
+    param_set_pop_size(xcsf, 50);
+    param_set_max_trials(xcsf, CKPT_TEST_TRIALS);
+    param_set_perf_trials(xcsf, CKPT_TEST_TRIALS + 1);
+    ea_param_set_theta(xcsf, 1);
+    ea_param_set_async(xcsf, async);
+    xcsf_init(xcsf);
+    pa_init(xcsf);
+}
+
+/**
+ * @brief Frees XCSF.
+ * @param [in] xcsf The XCSF data structure.
+ */
+static void
+checkpoint_test_free(struct XCSF *xcsf)
+{
+    xcsf_free(xcsf);
+    pa_free(xcsf);
+    param_free(xcsf);
+}
+
+/**
+ * @brief Checks whether two populations are identical.
+ * @param [in] a The first XCSF data structure.
+ * @param [in] b The second XCSF data structure.
+ */
+static void
+checkpoint_test_compare(const struct XCSF *a, const struct XCSF *b)
+{
+    char *buf_a = NULL;
+    char *buf_b = NULL;
+    size_t len_a = 0;
+    size_t len_b = 0;
+    xcsf_serialise_pset(a, &buf_a, &len_a);
+    xcsf_serialise_pset(b, &buf_b, &len_b);
+    CHECK_EQ(a->time, b->time);
+    CHECK_EQ(a->pset.size, b->pset.size);
+    CHECK_EQ(a->pset.num, b->pset.num);
+    REQUIRE_EQ(len_a, len_b);
+    CHECK_EQ(memcmp(buf_a, buf_b, len_a), 0);
+    free(buf_a);
+    free(buf_b);
+}
+
+/**
+ * @brief Runs an experiment uninterrupted and resumed from a checkpoint.
+ * @param [in] async Whether to create offspring asynchronously.
+ */
+static void
+checkpoint_test_resume(const bool async)
+{
+    const char *filename = "checkpoint_test.bin";
+    double x[40];
+    double y[20];
+    for (int i = 0; i < 20; ++i) {
+        x[i * 2] = i / 20.;
+        x[i * 2 + 1] = 1 - i / 20.;
+        y[i] = x[i * 2] * x[i * 2 + 1];
+    }
+    const struct Input data = { x, y, 2, 1, 20 };
+    // uninterrupted run without checkpointing
+    struct XCSF plain;
+    rand_init_seed(CKPT_TEST_SEED);
+    checkpoint_test_init(&plain, async);
+    clset_pset_init(&plain);
+    const double err = xcs_supervised_fit(&plain, &data, NULL, true);
+    // the same run checkpointed; the file is last written at trial 800
+    struct XCSF run;
+    rand_init_seed(CKPT_TEST_SEED);
+    checkpoint_test_init(&run, async);
+    clset_pset_init(&run);
+    param_set_checkpoint_trials(&run, CKPT_TEST_EVERY);
+    checkpoint_init(&run, filename);
+    CHECK_EQ(xcs_supervised_fit(&run, &data, NULL, true), err);
+    checkpoint_test_compare(&plain, &run);
+    // resumed from the checkpoint with a different random number stream
+    struct XCSF resumed;
+    rand_init_seed(CKPT_TEST_SEED + 1);
+    checkpoint_test_init(&resumed, async);
+    checkpoint_load(&resumed, filename);
+    CHECK_EQ(resumed.time, 2 * CKPT_TEST_EVERY);
+    if (async) {
+        REQUIRE(resumed.ea_async != NULL);
+        CHECK(resumed.ea_async->head != NULL);
+    }
+    CHECK_EQ(xcs_supervised_fit(&resumed, &data, NULL, true), err);
+    checkpoint_test_compare(&plain, &resumed);
+    checkpoint_test_free(&plain);
+    checkpoint_test_free(&run);
+    checkpoint_test_free(&resumed);
+    remove(filename);
+}
+
+TEST_CASE("CHECKPOINT RESUME")
+{
+    checkpoint_test_resume(false);
+}
+
+TEST_CASE("CHECKPOINT RESUME ASYNC EA")
+{
+    checkpoint_test_resume(true);
+}
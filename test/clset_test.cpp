@@ -0,0 +1,215 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file clset_test.cpp
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Classifier set tests.
+ */
+
+#include "../lib/doctest/doctest/doctest.h"
+
+extern "C" {
+#include "../xcsf/action.h"
+#include "../xcsf/cl.h"
+#include "../xcsf/clset.h"
+#include "../xcsf/cond_rectangle.h"
+#include "../xcsf/condition.h"
+#include "../xcsf/pa.h"
+#include "../xcsf/param.h"
+#include "../xcsf/pred_nlms.h"
+#include "../xcsf/prediction.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcs_supervised.h"
+#include "../xcsf/xcsf.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+}
+
+TEST_CASE("CLSET_STORE_RETRIEVE")
+{
+    /* random population */
+    struct XCSF xcsf;
+    rand_init();
+    param_init(&xcsf, 2, 1, 1);
+    param_set_pop_size(&xcsf, 100);
+    param_set_pop_init(&xcsf, true);
+    param_set_max_trials(&xcsf, 500);
+    action_param_set_type(&xcsf, ACT_TYPE_INTEGER);
+    cond_param_set_type(&xcsf, COND_TYPE_HYPERRECTANGLE);
+    pred_param_set_type(&xcsf, PRED_TYPE_NLMS_LINEAR);
+    xcsf_init(&xcsf);
+    pa_init(&xcsf);
+    clset_pset_init(&xcsf);
+    /* stored classifiers share structures with the population */
+    struct Set ref;
+    clset_copy(&xcsf, &ref, &xcsf.pset);
+    xcsf_store_pset(&xcsf);
+    CHECK_EQ(xcsf.prev_pset.size, xcsf.pset.size);
+    CHECK_EQ(xcsf.prev_pset.num, xcsf.pset.num);
+    for (const struct Clist *iter = xcsf.pset.list; iter != NULL;
+         iter = iter->next) {
+        CHECK_EQ(iter->cl->twin->twin, iter->cl);
+        CHECK_EQ(iter->cl->twin->cond, iter->cl->cond);
+        CHECK_EQ(iter->cl->twin->pred, iter->cl->pred);
+    }
+    /* train the current population */
+    double x[200];
+    double y[100];
+    for (int i = 0; i < 100; ++i) {
+        x[i * 2] = rand_uniform(0, 1);
+        x[i * 2 + 1] = rand_uniform(0, 1);
+        y[i] = x[i * 2] * x[i * 2 + 1];
+    }
+    const struct Input data = { x, y, 2, 1, 100 };
+    xcs_supervised_fit(&xcsf, &data, NULL, true);
+    /* the retrieved population is identical to that stored */
+    xcsf_retrieve_pset(&xcsf);
+    CHECK_EQ(xcsf.pset.size, ref.size);
+    CHECK_EQ(xcsf.pset.num, ref.num);
+    const struct Clist *a = xcsf.pset.list;
+    const struct Clist *b = ref.list;
+    while (a != NULL && b != NULL) {
+        CHECK(a->cl->twin == NULL);
+        CHECK_EQ(a->cl->fit, b->cl->fit);
+        CHECK_EQ(a->cl->err, b->cl->err);
+        CHECK_EQ(a->cl->exp, b->cl->exp);
+        CHECK_EQ(a->cl->num, b->cl->num);
+        const struct CondRectangle *c1 = (struct CondRectangle *) a->cl->cond;
+        const struct CondRectangle *c2 = (struct CondRectangle *) b->cl->cond;
+        const struct PredNLMS *p1 = (struct PredNLMS *) a->cl->pred;
+        const struct PredNLMS *p2 = (struct PredNLMS *) b->cl->pred;
+        for (int i = 0; i < 2; ++i) {
+            CHECK_EQ(c1->center[i], c2->center[i]);
+            CHECK_EQ(c1->spread[i], c2->spread[i]);
+        }
+        for (int i = 0; i < p1->n_weights; ++i) {
+            CHECK_EQ(p1->weights[i], p2->weights[i]);
+        }
+        a = a->next;
+        b = b->next;
+    }
+    CHECK(a == NULL);
+    CHECK(b == NULL);
+    clset_kill(&xcsf, &ref);
+    xcsf_free(&xcsf);
+    pa_free(&xcsf);
+    param_free(&xcsf);
+}
+
+TEST_CASE("CLSET_MEM_SIZE")
+{
+    struct XCSF xcsf;
+    rand_init();
+    param_init(&xcsf, 2, 1, 1);
+    param_set_pop_size(&xcsf, 100);
+    param_set_pop_init(&xcsf, true);
+    action_param_set_type(&xcsf, ACT_TYPE_INTEGER);
+    cond_param_set_type(&xcsf, COND_TYPE_HYPERRECTANGLE);
+    pred_param_set_type(&xcsf, PRED_TYPE_NLMS_LINEAR);
+    xcsf_init(&xcsf);
+    pa_init(&xcsf);
+    clset_pset_init(&xcsf);
+    /* hyperrectangle: centers, spreads and 1 mutation rate */
+    const size_t cond = sizeof(struct CondRectangle) + sizeof(double) * 5;
+    /* linear NLMS: 3 weights, 3 temporary inputs and 1 mutation rate */
+    const size_t pred = sizeof(struct PredNLMS) + sizeof(double) * 7;
+    const size_t cl = sizeof(struct Cl) + sizeof(double);
+    const struct Cl *c = xcsf.pset.list->cl;
+    CHECK_EQ(cond_mem_size(&xcsf, c), cond);
+    CHECK_EQ(pred_mem_size(&xcsf, c), pred);
+    CHECK_EQ(cl_mem_size(&xcsf, c),
+             cl + cond + pred + act_mem_size(&xcsf, c));
+    struct SetMemSize size;
+    clset_mem_size(&xcsf, &xcsf.pset, &size);
+    const size_t n = xcsf.pset.size;
+    CHECK_EQ(size.list, n * sizeof(struct Clist));
+    CHECK_EQ(size.cl, n * cl);
+    CHECK_EQ(size.cond, n * cond);
+    CHECK_EQ(size.pred, n * pred);
+    CHECK_EQ(size.total,
+             size.list + size.cl + size.cond + size.pred + size.act);
+    /* the running total matches a full recount */
+    CHECK_EQ(xcsf.pset_mem, size.total);
+    xcsf_free(&xcsf);
+    pa_free(&xcsf);
+    param_free(&xcsf);
+}
+
+TEST_CASE("CLSET_MEM_LIMIT")
+{
+    struct XCSF xcsf;
+    rand_init();
+    param_init(&xcsf, 2, 1, 1);
+    param_set_pop_size(&xcsf, 100);
+    param_set_pop_init(&xcsf, true);
+    action_param_set_type(&xcsf, ACT_TYPE_INTEGER);
+    cond_param_set_type(&xcsf, COND_TYPE_HYPERRECTANGLE);
+    pred_param_set_type(&xcsf, PRED_TYPE_NLMS_LINEAR);
+    xcsf_init(&xcsf);
+    pa_init(&xcsf);
+    clset_pset_init(&xcsf);
+    clset_init(&xcsf.kset);
+    param_set_pop_mem_size(&xcsf, 4);
+    clset_pset_enforce_limit(&xcsf);
+    struct SetMemSize size;
+    clset_mem_size(&xcsf, &xcsf.pset, &size);
+    CHECK(size.total <= 4 * 1024);
+    CHECK_EQ(xcsf.pset_mem, size.total);
+    CHECK(xcsf.pset.size > 0);
+    CHECK(xcsf.pset.size < 100);
+    clset_kill(&xcsf, &xcsf.kset);
+    xcsf_free(&xcsf);
+    pa_free(&xcsf);
+    param_free(&xcsf);
+}
+
+TEST_CASE("CLSET_MERGE")
+{
+    struct XCSF xcsf;
+    rand_init();
+    param_init(&xcsf, 2, 1, 1);
+    param_set_pop_size(&xcsf, 100);
+    param_set_pop_init(&xcsf, true);
+    action_param_set_type(&xcsf, ACT_TYPE_INTEGER);
+    cond_param_set_type(&xcsf, COND_TYPE_HYPERRECTANGLE);
+    pred_param_set_type(&xcsf, PRED_TYPE_NLMS_LINEAR);
+    xcsf_init(&xcsf);
+    pa_init(&xcsf);
+    clset_pset_init(&xcsf);
+    const char *filename = "clset_merge_test.bin";
+    xcsf_save(&xcsf, filename);
+    const int size = xcsf.pset.size;
+    const double fit = clset_total_fit(&xcsf.pset);
+    const char *filenames[2] = { filename, filename };
+    /* identical rules are combined and the total fitness is unchanged */
+    param_set_pop_size(&xcsf, 1000);
+    xcsf_merge(&xcsf, filenames, 2);
+    CHECK_EQ(xcsf.pset.size, size);
+    CHECK_EQ(xcsf.pset.num, 3 * size);
+    CHECK_EQ(doctest::Approx(clset_total_fit(&xcsf.pset)), fit);
+    /* the population size limit is enforced */
+    param_set_pop_size(&xcsf, 150);
+    xcsf_merge(&xcsf, filenames, 1);
+    CHECK(xcsf.pset.num <= 150);
+    remove(filename);
+    xcsf_free(&xcsf);
+    pa_free(&xcsf);
+    param_free(&xcsf);
+}
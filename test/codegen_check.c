@@ -0,0 +1,105 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file codegen_check.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Checks a generated standalone C model against the library.
+ * @details Linked with a file written by codegen_export(). Reads the inputs
+ * and expected predictions written by codegen_gen and fails if the output of
+ * xcsf_predict() differs, or if no classifier matches any of the inputs.
+ *
+ * Usage: codegen_check expected
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK_TOL (1e-9) //!< Relative tolerance of each prediction
+
+void
+xcsf_predict(const double *x, double *pred);
+
+/**
+ * @brief Reads the next value from the expected predictions file.
+ * @param [in] fp Pointer to the file.
+ * @return The value read.
+ */
+static double
+check_read(FILE *fp)
+{
+    double v = 0;
+    if (fscanf(fp, "%lf", &v) != 1) {
+        printf("codegen_check: truncated expected predictions\n");
+        exit(EXIT_FAILURE);
+    }
+    return v;
+}
+
+int
+main(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("Usage: codegen_check expected\n");
+        exit(EXIT_FAILURE);
+    }
+    FILE *fp = fopen(argv[1], "r");
+    if (fp == 0) {
+        printf("Error opening file: %s\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+    int n_samples = 0;
+    int x_dim = 0;
+    int n = 0;
+    if (fscanf(fp, "%d %d %d", &n_samples, &x_dim, &n) != 3) {
+        printf("codegen_check: invalid expected predictions\n");
+        exit(EXIT_FAILURE);
+    }
+    double *x = malloc(sizeof(double) * x_dim);
+    double *pred = malloc(sizeof(double) * n);
+    int n_failed = 0;
+    bool matched = false;
+    for (int i = 0; i < n_samples; ++i) {
+        for (int j = 0; j < x_dim; ++j) {
+            x[j] = check_read(fp);
+        }
+        xcsf_predict(x, pred);
+        for (int k = 0; k < n; ++k) {
+            const double expected = check_read(fp);
+            if (expected != 0) {
+                matched = true;
+            }
+            const double tol = CHECK_TOL * fmax(1, fabs(expected));
+            if (fabs(pred[k] - expected) > tol) {
+                printf("sample %d output %d: %.17g, expected %.17g\n", i, k,
+                       pred[k], expected);
+                ++n_failed;
+            }
+        }
+    }
+    fclose(fp);
+    free(x);
+    free(pred);
+    if (!matched) {
+        printf("codegen_check: no classifier matched any input\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("%d samples, %d failed outputs\n", n_samples, n_failed);
+    return (n_failed > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
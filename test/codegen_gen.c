@@ -0,0 +1,215 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file codegen_gen.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Generates standalone C models and their expected predictions.
+ * @details Trains a seeded population for the named model, exports it with
+ * codegen_export() and writes test inputs together with the fitness weighted
+ * predictions of the matching classifiers computed by the library. The
+ * generated file is compiled with codegen_check.c, which compares the output
+ * of xcsf_predict() with these predictions.
+ *
+ * Usage: codegen_gen model source expected
+ */
+
+#include "../xcsf/action.h"
+#include "../xcsf/cl.h"
+#include "../xcsf/clset.h"
+#include "../xcsf/codegen.h"
+#include "../xcsf/condition.h"
+#include "../xcsf/pa.h"
+#include "../xcsf/param.h"
+#include "../xcsf/prediction.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcs_supervised.h"
+#include "../xcsf/xcsf.h"
+#include <errno.h>
+#include <string.h>
+
+#define GEN_X_DIM (3) //!< Input dimensions
+#define GEN_Y_DIM (2) //!< Output dimensions
+#define GEN_TRAIN (200) //!< Training samples
+#define GEN_TEST (50) //!< Test samples written with their predictions
+#define GEN_POP_SIZE (200) //!< Maximum population size
+#define GEN_TRIALS (2000) //!< Number of learning trials
+#define GEN_SEED (1) //!< Random number generator seed
+
+/**
+ * @brief Generated model data structure.
+ */
+struct GenCase {
+    const char *name; //!< Model name
+    int cond; //!< Condition type
+    int pred; //!< Prediction type
+    int n_actions; //!< Number of integer actions
+};
+
+static const struct GenCase gen_cases[] = {
+    { "dummy", COND_TYPE_DUMMY, PRED_TYPE_NLMS_LINEAR, 1 },
+    { "rectangle", COND_TYPE_HYPERRECTANGLE, PRED_TYPE_NLMS_QUADRATIC, 1 },
+    { "ellipsoid", COND_TYPE_HYPERELLIPSOID, PRED_TYPE_RLS_LINEAR, 1 },
+    { "ternary", COND_TYPE_TERNARY, PRED_TYPE_CONSTANT, 2 },
+    { "gp", COND_TYPE_GP, PRED_TYPE_NLMS_LINEAR, 1 },
+    { "neural", COND_TYPE_NEURAL, PRED_TYPE_NEURAL, 1 },
+};
+
+/**
+ * @brief Creates a synthetic regression problem.
+ * @param [in] n_samples The number of samples to create.
+ * @return The data.
+ */
+static struct Input *
+gen_data(const int n_samples)
+{
+    struct Input *data = malloc(sizeof(struct Input));
+    data->x_dim = GEN_X_DIM;
+    data->y_dim = GEN_Y_DIM;
+    data->n_samples = n_samples;
+    data->x = malloc(sizeof(double) * GEN_X_DIM * n_samples);
+    data->y = malloc(sizeof(double) * GEN_Y_DIM * n_samples);
+    for (int i = 0; i < n_samples; ++i) {
+        double *x = &data->x[i * GEN_X_DIM];
+        for (int j = 0; j < GEN_X_DIM; ++j) {
+            x[j] = rand_uniform(0, 1);
+        }
+        data->y[i * GEN_Y_DIM] = sin(2 * M_PI * x[0]) * x[1];
+        data->y[i * GEN_Y_DIM + 1] = x[2] * x[2] - x[1];
+    }
+    return data;
+}
+
+/**
+ * @brief Frees a synthetic regression problem.
+ * @param [in] data The data to free.
+ */
+static void
+gen_data_free(struct Input *data)
+{
+    free(data->x);
+    free(data->y);
+    free(data);
+}
+
+/**
+ * @brief Computes the fitness weighted prediction of the matching
+ * classifiers for each action, as written by codegen_export().
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] x The input to predict.
+ * @param [out] pred The predictions of each action.
+ */
+static void
+gen_predict(const struct XCSF *xcsf, const double *x, double *pred)
+{
+    const int n = xcsf->n_actions * xcsf->y_dim;
+    double *nr = calloc(n, sizeof(double));
+    for (int k = 0; k < n; ++k) {
+        pred[k] = 0;
+    }
+    for (const struct Clist *iter = xcsf->pset.list; iter != NULL;
+         iter = iter->next) {
+        struct Cl *c = iter->cl;
+        if (!cond_match(xcsf, c, x)) {
+            continue;
+        }
+        const double *p = cl_predict(xcsf, c, x);
+        const int offset = cl_action(xcsf, c, x) * xcsf->y_dim;
+        for (int j = 0; j < xcsf->y_dim; ++j) {
+            pred[offset + j] += p[j] * c->fit;
+            nr[offset + j] += c->fit;
+        }
+    }
+    for (int k = 0; k < n; ++k) {
+        pred[k] = (nr[k] != 0) ? pred[k] / nr[k] : 0;
+    }
+    free(nr);
+}
+
+/**
+ * @brief Writes the test inputs and their expected predictions.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] filename The name of the output file.
+ */
+static void
+gen_expected(const struct XCSF *xcsf, const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+    if (fp == 0) {
+        printf("Error saving file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    const int n = xcsf->n_actions * xcsf->y_dim;
+    double *pred = malloc(sizeof(double) * n);
+    struct Input *test = gen_data(GEN_TEST);
+    fprintf(fp, "%d %d %d\n", GEN_TEST, GEN_X_DIM, n);
+    for (int i = 0; i < GEN_TEST; ++i) {
+        const double *x = &test->x[i * GEN_X_DIM];
+        gen_predict(xcsf, x, pred);
+        for (int j = 0; j < GEN_X_DIM; ++j) {
+            fprintf(fp, "%.17g ", x[j]);
+        }
+        for (int k = 0; k < n; ++k) {
+            fprintf(fp, "%.17g%s", pred[k], (k < n - 1) ? " " : "\n");
+        }
+    }
+    gen_data_free(test);
+    free(pred);
+    fclose(fp);
+}
+
+int
+main(int argc, char **argv)
+{
+    if (argc != 4) {
+        printf("Usage: codegen_gen model source expected\n");
+        exit(EXIT_FAILURE);
+    }
+    const struct GenCase *gc = NULL;
+    const int n = sizeof(gen_cases) / sizeof(gen_cases[0]);
+    for (int i = 0; i < n; ++i) {
+        if (strcmp(gen_cases[i].name, argv[1]) == 0) {
+            gc = &gen_cases[i];
+        }
+    }
+    if (gc == NULL) {
+        printf("codegen_gen: unknown model: %s\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+    struct XCSF *xcsf = malloc(sizeof(struct XCSF));
+    rand_init_seed(GEN_SEED);
+    param_init(xcsf, GEN_X_DIM, GEN_Y_DIM, gc->n_actions);
+    param_set_max_trials(xcsf, GEN_TRIALS);
+    param_set_perf_trials(xcsf, GEN_TRIALS + 1); // no performance output
+    param_set_pop_size(xcsf, GEN_POP_SIZE);
+    action_param_set_type(xcsf, ACT_TYPE_INTEGER);
+    cond_param_set_type(xcsf, gc->cond);
+    pred_param_set_type(xcsf, gc->pred);
+    xcsf_init(xcsf);
+    clset_pset_init(xcsf);
+    pa_init(xcsf);
+    struct Input *train = gen_data(GEN_TRAIN);
+    xcs_supervised_fit(xcsf, train, NULL, true);
+    gen_data_free(train);
+    codegen_export(xcsf, argv[2]);
+    gen_expected(xcsf, argv[3]);
+    pa_free(xcsf);
+    xcsf_free(xcsf);
+    param_free(xcsf);
+    free(xcsf);
+    return EXIT_SUCCESS;
+}
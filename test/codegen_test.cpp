@@ -0,0 +1,77 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file codegen_test.cpp
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Standalone C source code generation tests.
+ */
+
+#include "../lib/doctest/doctest/doctest.h"
+
+extern "C" {
+#include "../xcsf/clset.h"
+#include "../xcsf/codegen.h"
+#include "../xcsf/condition.h"
+#include "../xcsf/param.h"
+#include "../xcsf/prediction.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcsf.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+}
+
+TEST_CASE("CODEGEN")
+{
+    struct XCSF xcsf;
+    rand_init();
+    param_init(&xcsf, 3, 2, 1);
+    param_set_pop_size(&xcsf, 20);
+    param_set_pop_init(&xcsf, true);
+    cond_param_set_type(&xcsf, COND_TYPE_GP);
+    pred_param_set_type(&xcsf, PRED_TYPE_NLMS_LINEAR);
+    xcsf_init(&xcsf);
+    clset_pset_init(&xcsf);
+    codegen_export(&xcsf, "codegen_test.c");
+    FILE *fp = fopen("codegen_test.c", "r");
+    REQUIRE(fp != NULL);
+    fseek(fp, 0, SEEK_END);
+    const long len = ftell(fp);
+    rewind(fp);
+    char *src = (char *) calloc(len + 1, sizeof(char));
+    CHECK_EQ(fread(src, sizeof(char), len, fp), (size_t) len);
+    fclose(fp);
+    remove("codegen_test.c");
+    /* dimensions are compile-time constants */
+    char line[64];
+    snprintf(line, sizeof(line), "#define XCSF_N_CL (%d)", xcsf.pset.size);
+    CHECK(strstr(src, line) != NULL);
+    CHECK(strstr(src, "#define XCSF_X_DIM (3)") != NULL);
+    CHECK(strstr(src, "#define XCSF_PRED_N (4)") != NULL);
+    /* each GP tree is written as its own function */
+    snprintf(line, sizeof(line), "xcsf_cond_%d(const double *x)",
+             xcsf.pset.size - 1);
+    CHECK(strstr(src, line) != NULL);
+    /* the generated code has no dependencies beyond the C library */
+    CHECK(strstr(src, "malloc") == NULL);
+    CHECK(strstr(src, "#include \"") == NULL);
+    free(src);
+    xcsf_free(&xcsf);
+    param_free(&xcsf);
+}
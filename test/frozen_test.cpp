@@ -0,0 +1,92 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file frozen_test.cpp
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Frozen model tests.
+ */
+
+#include "../lib/doctest/doctest/doctest.h"
+
+extern "C" {
+#include "../xcsf/cl.h"
+#include "../xcsf/clset.h"
+#include "../xcsf/condition.h"
+#include "../xcsf/frozen.h"
+#include "../xcsf/param.h"
+#include "../xcsf/prediction.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcsf.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+}
+
+TEST_CASE("FROZEN")
+{
+    /* random population */
+    struct XCSF xcsf;
+    rand_init();
+    param_init(&xcsf, 3, 2, 1);
+    param_set_pop_size(&xcsf, 200);
+    param_set_pop_init(&xcsf, true);
+    cond_param_set_type(&xcsf, COND_TYPE_HYPERRECTANGLE);
+    pred_param_set_type(&xcsf, PRED_TYPE_NLMS_QUADRATIC);
+    xcsf_init(&xcsf);
+    clset_pset_init(&xcsf);
+    /* export and reopen */
+    frozen_export(&xcsf, "frozen_test.bin");
+    struct Frozen frozen;
+    frozen_open(&frozen, "frozen_test.bin");
+    CHECK_EQ(frozen.header->n_cl, xcsf.pset.size);
+    CHECK_EQ((uintptr_t) frozen.pred % FROZEN_ALIGN, 0);
+    /* compare with the fitness weighted prediction of matching rules */
+    const int n_samples = 20;
+    double x[60];
+    for (int i = 0; i < 60; ++i) {
+        x[i] = rand_uniform(0, 1);
+    }
+    double pred[40];
+    frozen_predict(&frozen, x, pred, n_samples);
+    int n_matched = 0;
+    for (int row = 0; row < n_samples; ++row) {
+        double pa[2] = { 0, 0 };
+        double nr = 0;
+        for (const struct Clist *iter = xcsf.pset.list; iter != NULL;
+             iter = iter->next) {
+            if (cond_match(&xcsf, iter->cl, &x[row * 3])) {
+                const double *p = cl_predict(&xcsf, iter->cl, &x[row * 3]);
+                pa[0] += p[0] * iter->cl->fit;
+                pa[1] += p[1] * iter->cl->fit;
+                nr += iter->cl->fit;
+            }
+        }
+        if (nr != 0) {
+            ++n_matched;
+            pa[0] /= nr;
+            pa[1] /= nr;
+        }
+        CHECK_EQ(doctest::Approx(pred[row * 2]), pa[0]);
+        CHECK_EQ(doctest::Approx(pred[row * 2 + 1]), pa[1]);
+    }
+    CHECK(n_matched > 0);
+    frozen_close(&frozen);
+    remove("frozen_test.bin");
+}
@@ -0,0 +1,115 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file island_test.cpp
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Island model tests.
+ */
+
+#include "../lib/doctest/doctest/doctest.h"
+
+extern "C" {
+#include "../xcsf/clset.h"
+#include "../xcsf/island.h"
+#include "../xcsf/pa.h"
+#include "../xcsf/param.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcs_supervised.h"
+#include "../xcsf/xcsf.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+}
+
+/**
+ * @brief Trains XCSF on a small regression problem with the island model.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] seed The random number generator seed.
+ * @return The average training error.
+ */
+static double
+island_test_fit(struct XCSF *xcsf, const uint32_t seed)
+{
+    double x[40];
+    double y[20];
+    for (int i = 0; i < 20; ++i) {
+        x[i * 2] = i / 20.;
+        x[i * 2 + 1] = 1 - i / 20.;
+        y[i] = x[i * 2] * x[i * 2 + 1];
+    }
+    const struct Input data = { x, y, 2, 1, 20 };
+    rand_init_seed(seed);
+    param_init(xcsf, 2, 1, 1);
+    param_set_pop_size(xcsf, 50);
+    param_set_max_trials(xcsf, 500);
+    param_set_perf_trials(xcsf, 1000);
+    param_set_islands(xcsf, 3);
+    param_set_migration_trials(xcsf, 100);
+    param_set_migration_size(xcsf, 5);
+    xcsf_init(xcsf);
+    pa_init(xcsf);
+    clset_pset_init(xcsf);
+    return xcs_supervised_fit(xcsf, &data, NULL, true);
+}
+
+TEST_CASE("ISLAND")
+{
+    // the island populations are merged within the population size limit
+    struct XCSF a;
+    const double err = island_test_fit(&a, 7);
+    CHECK_EQ(a.time, 500);
+    CHECK(a.pset.num <= a.POP_SIZE);
+    // results are reproducible regardless of the thread scheduling
+    struct XCSF b;
+    CHECK_EQ(island_test_fit(&b, 7), doctest::Approx(err).epsilon(0));
+    CHECK_EQ(a.pset.size, b.pset.size);
+    // migration inserts copies of the fittest classifiers into the next island
+    struct Islands isl;
+    param_set_islands(&a, 2);
+    island_init(&a, &isl);
+    const int num = isl.xcsf[1].pset.num;
+    param_set_pop_size(&isl.xcsf[1], num + 5);
+    island_migrate(&isl);
+    CHECK_EQ(isl.xcsf[1].pset.num, num + 5);
+    // copies of the same rule are combined when merging
+    const int size = a.pset.size;
+    double fit = 0;
+    for (const struct Clist *iter = a.pset.list; iter != NULL;
+         iter = iter->next) {
+        fit += iter->cl->fit;
+    }
+    param_set_pop_size(&a, 2 * num + 5);
+    island_merge(&a, &isl);
+    CHECK_EQ(isl.n, 0);
+    CHECK_EQ(a.pset.size, size);
+    CHECK_EQ(a.pset.num, 2 * num + 5);
+    double merged_fit = 0;
+    for (const struct Clist *iter = a.pset.list; iter != NULL;
+         iter = iter->next) {
+        merged_fit += iter->cl->fit;
+    }
+    CHECK(merged_fit > fit);
+    CHECK(merged_fit < 1.5 * fit);
+    xcsf_free(&a);
+    pa_free(&a);
+    param_free(&a);
+    xcsf_free(&b);
+    pa_free(&b);
+    param_free(&b);
+}
@@ -0,0 +1,100 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file publish_test.cpp
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Published population snapshot tests.
+ */
+
+#include "../lib/doctest/doctest/doctest.h"
+
+extern "C" {
+#include "../xcsf/clset.h"
+#include "../xcsf/condition.h"
+#include "../xcsf/frozen.h"
+#include "../xcsf/param.h"
+#include "../xcsf/prediction.h"
+#include "../xcsf/publish.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcsf.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+}
+
+TEST_CASE("PUBLISH")
+{
+    struct XCSF xcsf;
+    rand_init();
+    param_init(&xcsf, 3, 2, 1);
+    param_set_pop_size(&xcsf, 100);
+    param_set_pop_init(&xcsf, true);
+    param_set_publish_trials(&xcsf, 10);
+    /* only configurations that can be frozen may be published */
+    cond_param_set_type(&xcsf, COND_TYPE_GP);
+    CHECK(!frozen_supported(&xcsf));
+    cond_param_set_type(&xcsf, COND_TYPE_HYPERRECTANGLE);
+    pred_param_set_type(&xcsf, PRED_TYPE_NEURAL);
+    CHECK(!frozen_supported(&xcsf));
+    pred_param_set_type(&xcsf, PRED_TYPE_NLMS_LINEAR);
+    CHECK(frozen_supported(&xcsf));
+    xcsf_init(&xcsf);
+    clset_pset_init(&xcsf);
+    double x[30];
+    for (int i = 0; i < 30; ++i) {
+        x[i] = rand_uniform(0, 1);
+    }
+    double pred[20];
+    double expected[20];
+    /* nothing published yet */
+    CHECK(publish_acquire(&xcsf) == NULL);
+    CHECK(!publish_predict(&xcsf, x, pred, 10));
+    publish_trial(&xcsf, 0);
+    CHECK(publish_acquire(&xcsf) == NULL);
+    /* the snapshot matches a frozen model of the population */
+    publish_trial(&xcsf, 9);
+    struct Frozen frozen;
+    frozen_init(&frozen, &xcsf);
+    frozen_predict(&frozen, x, expected, 10);
+    frozen_close(&frozen);
+    struct Frozen *old = publish_acquire(&xcsf);
+    REQUIRE(old != NULL);
+    CHECK_EQ(old->header->n_cl, xcsf.pset.size);
+    /* a held snapshot is unaffected by training and later publication */
+    clset_kill(&xcsf, &xcsf.pset);
+    clset_init(&xcsf.pset);
+    clset_pset_init(&xcsf);
+    publish_snapshot(&xcsf);
+    frozen_predict(old, x, pred, 10);
+    for (int i = 0; i < 20; ++i) {
+        CHECK_EQ(pred[i], expected[i]);
+    }
+    publish_release(&xcsf, old);
+    /* new readers see the latest snapshot */
+    frozen_init(&frozen, &xcsf);
+    frozen_predict(&frozen, x, expected, 10);
+    frozen_close(&frozen);
+    CHECK(publish_predict(&xcsf, x, pred, 10));
+    for (int i = 0; i < 20; ++i) {
+        CHECK_EQ(pred[i], expected[i]);
+    }
+    publish_snapshot(&xcsf);
+    xcsf_free(&xcsf);
+    param_free(&xcsf);
+}
@@ -0,0 +1,108 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file stream_test.cpp
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Streaming input data tests.
+ */
+
+#include "../lib/doctest/doctest/doctest.h"
+
+extern "C" {
+#include "../xcsf/stream.h"
+#include "../xcsf/utils.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+}
+
+TEST_CASE("STREAM")
+{
+    rand_init();
+    const int n = 7;
+    double x[14];
+    double y[7];
+    for (int i = 0; i < n; ++i) {
+        x[i * 2] = i;
+        x[i * 2 + 1] = -i;
+        y[i] = i * 10;
+    }
+    // binary files read in order across several chunks
+    FILE *fp = fopen("stream_test_x.bin", "wb");
+    fwrite(x, sizeof(double), n * 2, fp);
+    fclose(fp);
+    fp = fopen("stream_test_y.bin", "wb");
+    fwrite(y, sizeof(double), n, fp);
+    fclose(fp);
+    struct Stream stream;
+    stream_init(&stream, "stream_test_x.bin", "stream_test_y.bin",
+                STREAM_BINARY, 2, 1, 4, 3, false, false);
+    const double *sx = NULL;
+    const double *sy = NULL;
+    for (int i = 0; i < n; ++i) {
+        CHECK(stream_next(&stream, &sx, &sy));
+        CHECK_EQ(sx[0], x[i * 2]);
+        CHECK_EQ(sx[1], x[i * 2 + 1]);
+        CHECK_EQ(sy[0], y[i]);
+    }
+    CHECK(!stream_next(&stream, &sx, &sy));
+    CHECK(!stream_next(&stream, &sx, &sy));
+    stream_free(&stream);
+    // shuffled samples are each returned exactly once
+    stream_init(&stream, "stream_test_x.bin", "stream_test_y.bin",
+                STREAM_BINARY, 2, 1, 3, 2, true, false);
+    int seen[7] = { 0 };
+    int cnt = 0;
+    while (stream_next(&stream, &sx, &sy)) {
+        const int i = (int) sx[0];
+        CHECK_EQ(sx[1], -i);
+        CHECK_EQ(sy[0], i * 10);
+        ++seen[i];
+        ++cnt;
+    }
+    CHECK_EQ(cnt, n);
+    for (int i = 0; i < n; ++i) {
+        CHECK_EQ(seen[i], 1);
+    }
+    stream_free(&stream);
+    remove("stream_test_x.bin");
+    remove("stream_test_y.bin");
+    // csv files with detected dimensions and looping
+    fp = fopen("stream_test_x.csv", "w");
+    fprintf(fp, "1.5,2\n3,-4.25\n");
+    fclose(fp);
+    fp = fopen("stream_test_y.csv", "w");
+    fprintf(fp, "0.5\n1\n");
+    fclose(fp);
+    stream_init(&stream, "stream_test_x.csv", "stream_test_y.csv", STREAM_CSV,
+                0, 0, 1, 3, false, true);
+    CHECK_EQ(stream.x_dim, 2);
+    CHECK_EQ(stream.y_dim, 1);
+    const double csv_x[4] = { 1.5, 2, 3, -4.25 };
+    const double csv_y[2] = { 0.5, 1 };
+    for (int i = 0; i < 5; ++i) {
+        CHECK(stream_next(&stream, &sx, &sy));
+        CHECK_EQ(sx[0], csv_x[(i % 2) * 2]);
+        CHECK_EQ(sx[1], csv_x[(i % 2) * 2 + 1]);
+        CHECK_EQ(sy[0], csv_y[i % 2]);
+    }
+    stream_free(&stream);
+    remove("stream_test_x.csv");
+    remove("stream_test_y.csv");
+}
@@ -24,13 +24,24 @@
 #include "../lib/doctest/doctest/doctest.h"
 
 extern "C" {
+#include "../xcsf/action.h"
+#include "../xcsf/clset.h"
+#include "../xcsf/condition.h"
+#include "../xcsf/neural_layer.h"
+#include "../xcsf/pa.h"
+#include "../xcsf/param.h"
+#include "../xcsf/prediction.h"
 #include "../xcsf/utils.h"
+#include "../xcsf/xcs_supervised.h"
+#include "../xcsf/xcsf.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 }
 
+#include <thread>
+
 TEST_CASE("UTIL")
 {
     rand_init();
@@ -98,3 +109,87 @@ TEST_CASE("UTIL")
     max = max_index(x, 5);
     CHECK_EQ(max, 4);
 }
+
+TEST_CASE("UTIL RAND THREADS")
+{
+    // each thread draws from its own stream so that concurrent runs are
+    // unaffected by one another
+    const int n = 1000;
+    double serial[n];
+    rand_init_seed(7);
+    for (int i = 0; i < n; ++i) {
+        serial[i] = (i % 2) ? rand_uniform(0, 1) : rand_normal(0, 1);
+    }
+    double main_draws[n];
+    double thread_draws[n];
+    rand_init_seed(7);
+    std::thread t([&thread_draws]() {
+        rand_init_seed(7);
+        for (int i = 0; i < n; ++i) {
+            thread_draws[i] = (i % 2) ? rand_uniform(0, 1) : rand_normal(0, 1);
+        }
+    });
+    for (int i = 0; i < n; ++i) {
+        main_draws[i] = (i % 2) ? rand_uniform(0, 1) : rand_normal(0, 1);
+    }
+    t.join();
+    for (int i = 0; i < n; ++i) {
+        CHECK_EQ(main_draws[i], serial[i]);
+        CHECK_EQ(thread_draws[i], serial[i]);
+    }
+}
+
+/**
+ * @brief Trains neural predictions with input dropout on two threads.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] seed The random number generator seed.
+ * @return The average training error.
+ */
+static double
+util_test_fit_dropout(struct XCSF *xcsf, const uint32_t seed)
+{
+    double x[40];
+    double y[20];
+    for (int i = 0; i < 20; ++i) {
+        x[i * 2] = i / 20.;
+        x[i * 2 + 1] = 1 - i / 20.;
+        y[i] = x[i * 2] * x[i * 2 + 1];
+    }
+    const struct Input data = { x, y, 2, 1, 20 };
+    rand_init_seed(seed);
+    param_init(xcsf, 2, 1, 1);
+    param_set_omp_num_threads(xcsf, 2);
+    param_set_pop_size(xcsf, 50);
+    param_set_max_trials(xcsf, 300);
+    param_set_perf_trials(xcsf, 1000);
+    action_param_set_type(xcsf, ACT_TYPE_INTEGER);
+    cond_param_set_type(xcsf, COND_TYPE_HYPERRECTANGLE);
+    pred_param_set_type(xcsf, PRED_TYPE_NEURAL);
+    struct ArgsLayer *dropout = (struct ArgsLayer *) malloc(sizeof(*dropout));
+    layer_args_init(dropout);
+    dropout->type = DROPOUT;
+    dropout->n_inputs = 2;
+    dropout->probability = 0.5;
+    dropout->next = xcsf->pred->largs;
+    xcsf->pred->largs = dropout;
+    xcsf_init(xcsf);
+    pa_init(xcsf);
+    clset_pset_init(xcsf);
+    return xcs_supervised_fit(xcsf, &data, NULL, true);
+}
+
+TEST_CASE("UTIL RAND WORKERS")
+{
+    // numbers drawn by worker threads are reproducible for a given seed
+    struct XCSF a;
+    struct XCSF b;
+    const double err = util_test_fit_dropout(&a, 3);
+    CHECK_EQ(util_test_fit_dropout(&b, 3), doctest::Approx(err).epsilon(0));
+    CHECK_EQ(a.pset.size, b.pset.size);
+    xcsf_free(&a);
+    pa_free(&a);
+    param_free(&a);
+    xcsf_free(&b);
+    pa_free(&b);
+    param_free(&b);
+}
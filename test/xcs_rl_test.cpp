@@ -0,0 +1,220 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file xcs_rl_test.cpp
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Reinforcement learning tests.
+ */
+
+#include "../lib/doctest/doctest/doctest.h"
+
+extern "C" {
+#include "../xcsf/clset.h"
+#include "../xcsf/env.h"
+#include "../xcsf/pa.h"
+#include "../xcsf/param.h"
+#include "../xcsf/replay.h"
+#include "../xcsf/utils.h"
+#include "../xcsf/xcs_rl.h"
+#include "../xcsf/xcsf.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+}
+
+#define RL_TEST_TRIALS (50) //!< Number of explore and exploit trial pairs
+#define RL_TEST_FITS (200) //!< Number of transitions learned
+#define RL_TEST_SEED (5) //!< Random number generator seed
+
+/**
+ * @brief Checks whether two populations are identical.
+ * @param [in] a The first XCSF data structure.
+ * @param [in] b The second XCSF data structure.
+ */
+static void
+xcs_rl_test_compare(const struct XCSF *a, const struct XCSF *b)
+{
+    char *buf_a = NULL;
+    char *buf_b = NULL;
+    size_t len_a = 0;
+    size_t len_b = 0;
+    xcsf_serialise_pset(a, &buf_a, &len_a);
+    xcsf_serialise_pset(b, &buf_b, &len_b);
+    CHECK_EQ(a->time, b->time);
+    CHECK_EQ(a->pset.size, b->pset.size);
+    CHECK_EQ(a->pset.num, b->pset.num);
+    REQUIRE_EQ(len_a, len_b);
+    CHECK_EQ(memcmp(buf_a, buf_b, len_a), 0);
+    free(buf_a);
+    free(buf_b);
+}
+
+/**
+ * @brief Initialises XCSF with the maze environment.
+ * @details A single thread is used so that the runs are reproducible to the
+ * last bit.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] replay The experience replay buffer to initialise.
+ * @param [in] replay_size The capacity of the experience replay buffer.
+ */
+static void
+xcs_rl_test_init(struct XCSF *xcsf, struct Replay *replay,
+                 const int replay_size)
+{
+    char prog[] = "xcsf";
+    char type[] = "maze";
+    char maze[] = XCS_RL_TEST_MAZE;
+    char *argv[] = { prog, type, maze };
+    rand_init_seed(RL_TEST_SEED);
+    env_init(xcsf, argv);
+    param_set_omp_num_threads(xcsf, 1);
+    param_set_pop_size(xcsf, 200);
+    param_set_teletransportation(xcsf, 20);
+    param_set_replay_size(xcsf, replay_size);
+    param_set_replay_batch(xcsf, 4);
+    xcsf_init(xcsf);
+    pa_init(xcsf);
+    clset_pset_init(xcsf);
+    replay_init(replay, xcsf->x_dim, replay_size);
+}
+
+/**
+ * @brief Frees XCSF and the maze environment.
+ * @param [in] xcsf The XCSF data structure.
+ */
+static void
+xcs_rl_test_free(struct XCSF *xcsf)
+{
+    pa_free(xcsf);
+    env_free(xcsf);
+    xcsf_free(xcsf);
+    param_free(xcsf);
+}
+
+/**
+ * @brief Performs explore and exploit trials with the maze environment.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] replay_size The capacity of the experience replay buffer.
+ * @param [in] vec Whether to step the environment as with N_ENVS > 1.
+ * @param [out] perf The performance of each trial.
+ * @param [out] error The mean prediction error of each trial.
+ */
+static void
+xcs_rl_test_trials(struct XCSF *xcsf, const int replay_size, const bool vec,
+                   double *perf, double *error)
+{
+    struct Replay replay;
+    xcs_rl_test_init(xcsf, &replay, replay_size);
+    struct RLTrial trial;
+    trial.env = xcsf->env;
+    for (int i = 0; i < 2 * RL_TEST_TRIALS; ++i) {
+        const bool explore = (i % 2 == 0);
+        if (vec) {
+            perf[i] =
+                xcs_rl_vec_trial(xcsf, &trial, 1, &replay, &error[i], explore);
+        } else {
+            perf[i] = xcs_rl_trial(xcsf, &replay, &error[i], explore);
+        }
+    }
+    CHECK_EQ(replay.size, replay_size);
+    replay_free(&replay);
+}
+
+/**
+ * @brief Checks that a single environment instance stepped as with
+ * N_ENVS > 1 reproduces the serial trials.
+ * @param [in] replay_size The capacity of the experience replay buffer.
+ */
+static void
+xcs_rl_test_vec_trial(const int replay_size)
+{
+    double perf_a[2 * RL_TEST_TRIALS];
+    double perf_b[2 * RL_TEST_TRIALS];
+    double err_a[2 * RL_TEST_TRIALS];
+    double err_b[2 * RL_TEST_TRIALS];
+    struct XCSF a;
+    xcs_rl_test_trials(&a, replay_size, false, perf_a, err_a);
+    struct XCSF b;
+    xcs_rl_test_trials(&b, replay_size, true, perf_b, err_b);
+    for (int i = 0; i < 2 * RL_TEST_TRIALS; ++i) {
+        CHECK_EQ(perf_a[i], perf_b[i]);
+        CHECK_EQ(err_a[i], err_b[i]);
+    }
+    xcs_rl_test_compare(&a, &b);
+    xcs_rl_test_free(&a);
+    xcs_rl_test_free(&b);
+}
+
+TEST_CASE("XCS RL N_ENVS=1")
+{
+    xcs_rl_test_vec_trial(0);
+}
+
+TEST_CASE("XCS RL N_ENVS=1 REPLAY")
+{
+    xcs_rl_test_vec_trial(100);
+}
+
+/**
+ * @brief Learns a sequence of terminal transitions from the maze.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] batch Whether to learn with xcs_rl_fit_batch().
+ * @param [out] error The prediction error of each transition.
+ */
+static void
+xcs_rl_test_fit(struct XCSF *xcsf, const bool batch, double *error)
+{
+    struct Replay replay;
+    xcs_rl_test_init(xcsf, &replay, 0);
+    replay_free(&replay);
+    double state[8];
+    double next_state[8];
+    const bool done = true;
+    for (int i = 0; i < RL_TEST_FITS; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            state[j] = ((i >> (j % 4)) & 1) ? 0.1 : 0.5;
+            next_state[j] = 0.1;
+        }
+        const int action = i % xcsf->n_actions;
+        const double reward = (i % 3 == 0) ? 1000 : 0;
+        if (batch) {
+            error[i] = xcs_rl_fit_batch(xcsf, state, &action, &reward,
+                                        next_state, &done, 1);
+        } else {
+            error[i] = xcs_rl_fit(xcsf, state, action, reward);
+        }
+    }
+}
+
+TEST_CASE("XCS RL FIT BATCH")
+{
+    // a batch of one terminal transition learns the reward as the target
+    double err_a[RL_TEST_FITS];
+    double err_b[RL_TEST_FITS];
+    struct XCSF a;
+    xcs_rl_test_fit(&a, false, err_a);
+    struct XCSF b;
+    xcs_rl_test_fit(&b, true, err_b);
+    for (int i = 0; i < RL_TEST_FITS; ++i) {
+        CHECK_EQ(err_a[i], err_b[i]);
+    }
+    xcs_rl_test_compare(&a, &b);
+    xcs_rl_test_free(&a);
+    xcs_rl_test_free(&b);
+}
@@ -238,3 +238,17 @@ act_integer_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     c->act = new;
     return s;
 }
+
+/**
+ * @brief Returns the memory size of an integer action.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose action memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+act_integer_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    (void) c;
+    return sizeof(struct ActInteger) + sizeof(double) * N_MU;
+}
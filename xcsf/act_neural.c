@@ -221,3 +221,17 @@ act_neural_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     c->act = new;
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a neural network action.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose action memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+act_neural_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct ActNeural *act = c->act;
+    return sizeof(struct ActNeural) + neural_mem_size(&act->net);
+}
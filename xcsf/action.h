@@ -87,8 +87,21 @@ struct ActVtbl {
     size_t (*act_impl_save)(const struct XCSF *xcsf, const struct Cl *c,
                             FILE *fp);
     size_t (*act_impl_load)(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
+    size_t (*act_impl_mem_size)(const struct XCSF *xcsf, const struct Cl *c);
 };
 
+/**
+ * @brief Returns the number of bytes of memory allocated for the action.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose action memory size to return.
+ * @return The memory size in bytes.
+ */
+static inline size_t
+act_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    return (*c->act_vptr->act_impl_mem_size)(xcsf, c);
+}
+
 /**
  * @brief Writes the action to a file.
  * @param [in] xcsf The XCSF data structure.
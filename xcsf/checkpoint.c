@@ -0,0 +1,403 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file checkpoint.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Periodic background checkpointing of training runs.
+ * @details A checkpoint file contains a magic number, the size of the
+ * serialised XCSF state, the serialised state, the trial counter and
+ * accumulated performance measures, and the random number generator state.
+ */
+
+#include "checkpoint.h"
+#include "cl.h"
+#include "clset.h"
+#include "ea.h"
+#include "utils.h"
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+/**
+ * @brief Flushes a file to the storage device.
+ * @param [in] fp Pointer to the file.
+ * @return Whether the file was flushed successfully.
+ */
+static bool
+checkpoint_sync(FILE *fp)
+{
+    if (fflush(fp) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(fp)) == 0;
+#else
+    return fsync(fileno(fp)) == 0;
+#endif
+}
+
+/**
+ * @brief Writes a checkpoint file.
+ * @param [in] ckpt The checkpoint data structure.
+ * @param [in] filename The name of the file to write.
+ * @param [in] pset The serialised population.
+ * @param [in] len The length of the serialised population.
+ * @return Whether the file was written and flushed successfully.
+ */
+static bool
+checkpoint_save(const struct Checkpoint *ckpt, const char *filename,
+                const char *pset, const size_t len)
+{
+    FILE *fp = fopen(filename, "wb");
+    if (fp == 0) {
+        return false;
+    }
+    const uint64_t size = ckpt->params_len + len;
+    const size_t n_rand = rand_state_size();
+    bool ok = fwrite(CHECKPOINT_MAGIC, sizeof(char), sizeof(CHECKPOINT_MAGIC),
+                     fp) == sizeof(CHECKPOINT_MAGIC) &&
+        fwrite(&size, sizeof(uint64_t), 1, fp) == 1 &&
+        fwrite(ckpt->params, sizeof(char), ckpt->params_len, fp) ==
+            ckpt->params_len &&
+        fwrite(pset, sizeof(char), len, fp) == len &&
+        fwrite(&ckpt->trial, sizeof(int), 1, fp) == 1 &&
+        fwrite(ckpt->perf, sizeof(double), 3, fp) == 3 &&
+        fwrite(ckpt->rand_state, sizeof(unsigned char), n_rand, fp) ==
+            n_rand &&
+        fwrite(ckpt->ea, sizeof(char), ckpt->ea_len, fp) == ckpt->ea_len &&
+        checkpoint_sync(fp);
+    ok = (fclose(fp) == 0) && ok;
+    return ok;
+}
+
+/**
+ * @brief Writes a checkpoint to disk; executed on the background thread.
+ * @details The checkpoint is written and flushed to a temporary file that
+ * then replaces the previous checkpoint so that a complete checkpoint always
+ * exists. The snapshot is only read here; it is freed by the training thread.
+ * @param [in] arg The checkpoint data structure.
+ * @return NULL.
+ */
+static void *
+checkpoint_write(void *arg)
+{
+    struct Checkpoint *ckpt = arg;
+    char *buf = ckpt->pset;
+    size_t len = ckpt->pset_len;
+    if (buf == NULL) {
+        xcsf_serialise_pset(&ckpt->snapshot, &buf, &len);
+    }
+    const size_t n = strlen(ckpt->filename);
+    char *tmp = malloc(n + 5);
+    memcpy(tmp, ckpt->filename, n);
+    memcpy(tmp + n, ".tmp", 5);
+    if (!checkpoint_save(ckpt, tmp, buf, len)) {
+        printf("Error saving checkpoint: %s. %s.\n", tmp, strerror(errno));
+        remove(tmp);
+    } else {
+#ifdef _WIN32
+        remove(ckpt->filename);
+#endif
+        if (rename(tmp, ckpt->filename) != 0) {
+            printf("Error saving checkpoint: %s. %s.\n", ckpt->filename,
+                   strerror(errno));
+        }
+    }
+    if (buf != ckpt->pset) {
+        free(buf);
+    }
+    free(tmp);
+    pthread_mutex_lock(&ckpt->lock);
+    ckpt->done = true;
+    pthread_mutex_unlock(&ckpt->lock);
+    return NULL;
+}
+
+/**
+ * @brief Enables checkpointing to the specified file.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] filename The name of the checkpoint file (NULL to not write).
+ */
+void
+checkpoint_init(struct XCSF *xcsf, const char *filename)
+{
+    if (xcsf->checkpoint == NULL) {
+        struct Checkpoint *ckpt = malloc(sizeof(struct Checkpoint));
+        ckpt->filename = NULL;
+        ckpt->params = NULL;
+        ckpt->params_len = 0;
+        ckpt->pset = NULL;
+        ckpt->pset_len = 0;
+        ckpt->ea = NULL;
+        ckpt->ea_len = 0;
+        clset_init(&ckpt->snapshot.pset);
+        ckpt->rand_state = malloc(rand_state_size());
+        ckpt->trial = 0;
+        memset(ckpt->perf, 0, sizeof(ckpt->perf));
+        ckpt->resume = false;
+        ckpt->pending = false;
+        ckpt->done = false;
+        pthread_mutex_init(&ckpt->lock, NULL);
+        xcsf->checkpoint = ckpt;
+    }
+    checkpoint_wait(xcsf);
+    struct Checkpoint *ckpt = xcsf->checkpoint;
+    free(ckpt->filename);
+    ckpt->filename = NULL;
+    if (filename != NULL) {
+        const size_t n = strlen(filename) + 1;
+        ckpt->filename = malloc(n);
+        memcpy(ckpt->filename, filename, n);
+    }
+}
+
+/**
+ * @brief Frees the snapshot of a checkpoint that has been written.
+ * @param [in] xcsf The XCSF data structure.
+ */
+static void
+checkpoint_release(const struct XCSF *xcsf)
+{
+    struct Checkpoint *ckpt = xcsf->checkpoint;
+    ckpt->done = false;
+    clset_kill(xcsf, &ckpt->snapshot.pset);
+    clset_init(&ckpt->snapshot.pset);
+    free(ckpt->params);
+    ckpt->params = NULL;
+    free(ckpt->pset);
+    ckpt->pset = NULL;
+    free(ckpt->ea);
+    ckpt->ea = NULL;
+}
+
+/**
+ * @brief Waits for any checkpoint being written to finish and frees its
+ * snapshot.
+ * @details Must be called from the training thread.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+checkpoint_wait(const struct XCSF *xcsf)
+{
+    struct Checkpoint *ckpt = xcsf->checkpoint;
+    if (ckpt != NULL && ckpt->pending) {
+        pthread_join(ckpt->thread, NULL);
+        ckpt->pending = false;
+        checkpoint_release(xcsf);
+    }
+}
+
+/**
+ * @brief Waits for any checkpoint being written and disables checkpointing.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+checkpoint_free(struct XCSF *xcsf)
+{
+    struct Checkpoint *ckpt = xcsf->checkpoint;
+    if (ckpt != NULL) {
+        checkpoint_wait(xcsf);
+        pthread_mutex_destroy(&ckpt->lock);
+        free(ckpt->filename);
+        free(ckpt->rand_state);
+        free(ckpt);
+        xcsf->checkpoint = NULL;
+    }
+}
+
+/**
+ * @brief Frees the snapshot of a checkpoint that has finished being written.
+ * @details Releasing the snapshot early means that classifiers updated
+ * before the next checkpoint no longer need to be copied.
+ * @param [in] xcsf The XCSF data structure.
+ */
+static void
+checkpoint_reclaim(const struct XCSF *xcsf)
+{
+    struct Checkpoint *ckpt = xcsf->checkpoint;
+    if (ckpt->pending) {
+        pthread_mutex_lock(&ckpt->lock);
+        const bool done = ckpt->done;
+        pthread_mutex_unlock(&ckpt->lock);
+        if (done) {
+            checkpoint_wait(xcsf);
+        }
+    }
+}
+
+/**
+ * @brief Starts writing a checkpoint if one is due after the current trial.
+ * @details The parameters are serialised and the random number generator
+ * state copied on the calling thread. The population snapshot shares the
+ * classifiers' structures copy-on-write, pinned so that a classifier updated
+ * while the checkpoint is written receives new copies and leaves the shared
+ * structures unchanged. Serialising the population and writing to disk are
+ * then performed on a background thread, except for populations that cannot
+ * be shared, which are serialised first. Offspring still to be inserted by an
+ * asynchronous EA request are waited for and saved so that a resumed run
+ * inserts them at the same trial.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] cnt The trial just completed.
+ * @param [in] p0 First accumulated performance measure of the run.
+ * @param [in] p1 Second accumulated performance measure of the run.
+ * @param [in] p2 Third accumulated performance measure of the run.
+ */
+void
+checkpoint_trial(struct XCSF *xcsf, const int cnt, const double p0,
+                 const double p1, const double p2)
+{
+    struct Checkpoint *ckpt = xcsf->checkpoint;
+    if (ckpt == NULL) {
+        return;
+    }
+    checkpoint_reclaim(xcsf);
+    if (ckpt->filename == NULL || xcsf->CHECKPOINT_TRIALS < 1 ||
+        (cnt + 1) % xcsf->CHECKPOINT_TRIALS != 0) {
+        return;
+    }
+    checkpoint_wait(xcsf);
+    xcsf_serialise_params(xcsf, &ckpt->params, &ckpt->params_len);
+    struct XCSF *snapshot = &ckpt->snapshot;
+    snapshot->x_dim = xcsf->x_dim;
+    snapshot->y_dim = xcsf->y_dim;
+    if (cl_shareable(xcsf)) {
+        clset_share(xcsf, &snapshot->pset, &xcsf->pset);
+        for (const struct Clist *iter = snapshot->pset.list; iter != NULL;
+             iter = iter->next) {
+            iter->cl->pinned = true;
+        }
+    } else {
+        xcsf_serialise_pset(xcsf, &ckpt->pset, &ckpt->pset_len);
+    }
+    FILE *fp = xcsf_mem_open_write(&ckpt->ea, &ckpt->ea_len);
+    ea_async_save(xcsf, fp);
+    xcsf_mem_close_write(fp, &ckpt->ea, &ckpt->ea_len);
+    rand_state_get(ckpt->rand_state);
+    ckpt->trial = cnt + 1;
+    ckpt->perf[0] = p0;
+    ckpt->perf[1] = p1;
+    ckpt->perf[2] = p2;
+    ckpt->pending = true;
+    if (pthread_create(&ckpt->thread, NULL, checkpoint_write, ckpt) != 0) {
+        printf("checkpoint_trial(): failed to create writer thread\n");
+        ckpt->pending = false;
+        checkpoint_write(ckpt);
+        checkpoint_release(xcsf);
+    }
+}
+
+/**
+ * @brief Returns the trial from which to resume a loaded checkpoint.
+ * @details The accumulated performance measures are restored if a run is
+ * being resumed; otherwise they are left unchanged and zero is returned.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [out] p0 First accumulated performance measure of the run.
+ * @param [out] p1 Second accumulated performance measure of the run.
+ * @param [out] p2 Third accumulated performance measure of the run.
+ * @return The trial from which to resume.
+ */
+int
+checkpoint_resume(struct XCSF *xcsf, double *p0, double *p1, double *p2)
+{
+    struct Checkpoint *ckpt = xcsf->checkpoint;
+    if (ckpt == NULL || !ckpt->resume) {
+        return 0;
+    }
+    ckpt->resume = false;
+    *p0 = ckpt->perf[0];
+    *p1 = ckpt->perf[1];
+    *p2 = ckpt->perf[2];
+    return ckpt->trial;
+}
+
+/**
+ * @brief Reads the state of XCSF from a checkpoint or saved file.
+ * @details If the file is a checkpoint, the random number generator state and
+ * the offspring of any pending asynchronous EA request are restored and the
+ * next training run resumes from the checkpointed trial.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] filename The name of the input file.
+ * @return The total number of elements read.
+ */
+size_t
+checkpoint_load(struct XCSF *xcsf, const char *filename)
+{
+    FILE *fp = fopen(filename, "rb");
+    if (fp == 0) {
+        printf("Error loading file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    fseek(fp, 0, SEEK_END);
+    const long len = ftell(fp);
+    rewind(fp);
+    if (len < 0) {
+        printf("Error loading file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    char *buf = malloc(len);
+    if (fread(buf, 1, len, fp) != (size_t) len) {
+        printf("Error loading file: %s. Failed to read.\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    fclose(fp);
+    const size_t header = sizeof(CHECKPOINT_MAGIC) + sizeof(uint64_t);
+    if ((size_t) len < header ||
+        memcmp(buf, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        const size_t s = xcsf_deserialise(xcsf, buf, len);
+        free(buf);
+        return s;
+    }
+    uint64_t size = 0;
+    memcpy(&size, buf + sizeof(CHECKPOINT_MAGIC), sizeof(uint64_t));
+    const size_t progress =
+        sizeof(int) + sizeof(double) * 3 + rand_state_size();
+    if (size > (uint64_t) len - header ||
+        (size_t) len - header - size < progress) {
+        printf("Error loading file: %s. Corrupt checkpoint.\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    size_t s = xcsf_deserialise(xcsf, buf + header, size);
+    if (xcsf->checkpoint == NULL) {
+        checkpoint_init(xcsf, NULL);
+    }
+    struct Checkpoint *ckpt = xcsf->checkpoint;
+    const char *p = buf + header + size;
+    memcpy(&ckpt->trial, p, sizeof(int));
+    p += sizeof(int);
+    memcpy(ckpt->perf, p, sizeof(double) * 3);
+    p += sizeof(double) * 3;
+    rand_state_set((const unsigned char *) p);
+    p += rand_state_size();
+    const size_t n_ea = (size_t) len - header - size - progress;
+    if (n_ea > 0) { // offspring of a pending asynchronous EA request
+        FILE *fp_ea = xcsf_mem_open_read(p, n_ea);
+        s += ea_async_load(xcsf, fp_ea);
+        if (ferror(fp_ea) || ftell(fp_ea) != (long) n_ea) {
+            printf("Error loading file: %s. Corrupt checkpoint.\n", filename);
+            exit(EXIT_FAILURE);
+        }
+        fclose(fp_ea);
+    }
+    ckpt->resume = true;
+    s += 5;
+    free(buf);
+    return s;
+}
@@ -0,0 +1,80 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file checkpoint.h
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Periodic background checkpointing of training runs.
+ */
+
+#pragma once
+
+#include "xcsf.h"
+#include <pthread.h>
+
+#define CHECKPOINT_FILENAME ("checkpoint.bin") //!< Default checkpoint file
+
+static const char CHECKPOINT_MAGIC[8] = "XCSFCKP"; //!< Checkpoint file magic
+
+/**
+ * @brief Checkpointing data structure.
+ * @details Every CHECKPOINT_TRIALS trials the parameters are serialised and a
+ * snapshot of the population is taken, which is written to disk by a
+ * background thread along with the state of the random number generator, the
+ * trial counters, and the offspring of any pending asynchronous EA request
+ * (EA_ASYNC), so that training continues while the checkpoint is
+ * written and an interrupted run can be resumed. Where possible the snapshot
+ * shares its classifiers' structures copy-on-write with the population,
+ * otherwise the population is serialised before training continues.
+ */
+struct Checkpoint {
+    char *filename; //!< Name of the checkpoint file (NULL if not writing)
+    char *params; //!< Serialised version and parameters to be written
+    size_t params_len; //!< Length of the serialised parameters
+    char *pset; //!< Serialised population if it could not be shared
+    size_t pset_len; //!< Length of the serialised population
+    char *ea; //!< Serialised offspring of a pending asynchronous EA request
+    size_t ea_len; //!< Length of the serialised offspring
+    struct XCSF snapshot; //!< Dimensions and population snapshot to write
+    unsigned char *rand_state; //!< Random number generator state
+    int trial; //!< Trial from which to resume
+    double perf[3]; //!< Accumulated performance measures of the run
+    bool resume; //!< Whether a loaded run is waiting to be resumed
+    bool pending; //!< Whether a checkpoint is being written
+    bool done; //!< Whether the writer thread has finished (guarded by lock)
+    pthread_mutex_t lock; //!< Guards the writer thread finished flag
+    pthread_t thread; //!< Background writer thread
+};
+
+int
+checkpoint_resume(struct XCSF *xcsf, double *p0, double *p1, double *p2);
+
+size_t
+checkpoint_load(struct XCSF *xcsf, const char *filename);
+
+void
+checkpoint_free(struct XCSF *xcsf);
+
+void
+checkpoint_init(struct XCSF *xcsf, const char *filename);
+
+void
+checkpoint_trial(struct XCSF *xcsf, const int cnt, const double p0,
+                 const double p1, const double p2);
+
+void
+checkpoint_wait(const struct XCSF *xcsf);
@@ -26,6 +26,7 @@
 #include "condition.h"
 #include "ea.h"
 #include "loss.h"
+#include "neural_layer.h"
 #include "prediction.h"
 #include "utils.h"
 
@@ -51,6 +52,8 @@ cl_init(const struct XCSF *xcsf, struct Cl *c, const double size,
     c->m = false;
     c->age = 0;
     c->mtotal = 0;
+    c->twin = NULL;
+    c->pinned = false;
 }
 
 /**
@@ -83,7 +86,8 @@ cl_copy(const struct XCSF *xcsf, struct Cl *dest, const struct Cl *src)
 void
 cl_init_copy(const struct XCSF *xcsf, struct Cl *dest, const struct Cl *src)
 {
-    dest->prediction = calloc(xcsf->y_dim, sizeof(double));
+    dest->prediction = malloc(sizeof(double) * xcsf->y_dim);
+    memcpy(dest->prediction, src->prediction, sizeof(double) * xcsf->y_dim);
     dest->fit = src->fit;
     dest->err = src->err;
     dest->num = src->num;
@@ -94,6 +98,8 @@ cl_init_copy(const struct XCSF *xcsf, struct Cl *dest, const struct Cl *src)
     dest->m = src->m;
     dest->age = src->age;
     dest->mtotal = src->mtotal;
+    dest->twin = NULL;
+    dest->pinned = false;
     dest->cond_vptr = src->cond_vptr;
     dest->pred_vptr = src->pred_vptr;
     dest->act_vptr = src->act_vptr;
@@ -102,6 +108,141 @@ cl_init_copy(const struct XCSF *xcsf, struct Cl *dest, const struct Cl *src)
     pred_copy(xcsf, dest, src);
 }
 
+/**
+ * @brief Initialises a copy of a classifier that shares the source's
+ * condition, action, and prediction structures.
+ * @details The two classifiers remain twins until one is updated or freed;
+ * the source must not already have a twin.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] dest The destination classifier.
+ * @param [in] src The source classifier.
+ */
+void
+cl_init_share(const struct XCSF *xcsf, struct Cl *dest, struct Cl *src)
+{
+    *dest = *src;
+    dest->prediction = malloc(sizeof(double) * xcsf->y_dim);
+    memcpy(dest->prediction, src->prediction, sizeof(double) * xcsf->y_dim);
+    dest->twin = src;
+    dest->pinned = false;
+    src->twin = dest;
+}
+
+/**
+ * @brief Gives a classifier exact copies of another's condition, action, and
+ * prediction structures.
+ * @details Unlike the copy functions used for offspring, the full learned
+ * state is reproduced and no random numbers are drawn. Intermediate values
+ * computed for the current input are not copied.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] dest The classifier to receive the structures.
+ * @param [in] src The classifier whose structures are to be cloned.
+ */
+static void
+cl_clone(const struct XCSF *xcsf, struct Cl *dest, const struct Cl *src)
+{
+    char *buf = NULL;
+    size_t len = 0;
+    FILE *fp = xcsf_mem_open_write(&buf, &len);
+    act_save(xcsf, src, fp);
+    pred_save(xcsf, src, fp);
+    cond_save(xcsf, src, fp);
+    xcsf_mem_close_write(fp, &buf, &len);
+    fp = xcsf_mem_open_read(buf, len);
+    act_load(xcsf, dest, fp);
+    pred_load(xcsf, dest, fp);
+    cond_load(xcsf, dest, fp);
+    fclose(fp);
+    free(buf);
+}
+
+/**
+ * @brief Stops a classifier sharing its condition, action, and prediction
+ * structures with its twin.
+ * @details Must be called before the structures are modified. The twin
+ * normally receives exact clones so that any intermediate values computed by
+ * the classifier for the current input remain available for updating. If the
+ * twin is pinned because its structures are being read by another thread,
+ * the classifier instead receives the clones and those values are lost.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier about to be modified.
+ * @return Whether the classifier received new copies of its structures.
+ */
+bool
+cl_unshare(const struct XCSF *xcsf, struct Cl *c)
+{
+    struct Cl *twin = c->twin;
+    if (twin == NULL) {
+        return false;
+    }
+    twin->twin = NULL;
+    c->twin = NULL;
+    if (twin->pinned) {
+        const struct Cl shared = *c;
+        cl_clone(xcsf, c, &shared);
+        return true;
+    }
+    cl_clone(xcsf, twin, c);
+    return false;
+}
+
+/**
+ * @brief Returns whether the layers of a network can be shared with a pinned
+ * twin.
+ * @param [in] largs The layer parameters of the network.
+ * @return Whether every layer only copies and saves its learned parameters
+ * and forward propagation draws no random numbers.
+ */
+static bool
+cl_layers_shareable(const struct ArgsLayer *largs)
+{
+    for (const struct ArgsLayer *iter = largs; iter != NULL;
+         iter = iter->next) {
+        if (iter->type != CONNECTED && iter->type != SOFTMAX) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns whether classifiers can share their structures with a twin
+ * that is pinned while another thread reads it.
+ * @details Training continues while the twin is read, so only structures
+ * whose copied and saved contents are not changed by matching and prediction
+ * may be shared. GP trees, DGP graphs, and recurrent and LSTM layers store
+ * state that is. A classifier updated while its twin is pinned repeats its
+ * forward propagation, which must not draw random numbers, as dropout and
+ * noise layers do, for runs to remain identical to those without sharing.
+ * @param [in] xcsf The XCSF data structure.
+ * @return Whether the classifiers can be shared.
+ */
+bool
+cl_shareable(const struct XCSF *xcsf)
+{
+    switch (xcsf->cond->type) {
+        case COND_TYPE_DUMMY:
+        case COND_TYPE_HYPERRECTANGLE:
+        case COND_TYPE_HYPERELLIPSOID:
+        case COND_TYPE_TERNARY:
+            break;
+        case COND_TYPE_NEURAL:
+            if (!cl_layers_shareable(xcsf->cond->largs)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    if (xcsf->pred->type == PRED_TYPE_NEURAL &&
+        !cl_layers_shareable(xcsf->pred->largs)) {
+        return false;
+    }
+    return xcsf->act->type == ACT_TYPE_INTEGER ||
+        (xcsf->act->type == ACT_TYPE_NEURAL &&
+         cl_layers_shareable(xcsf->act->largs));
+}
+
 /**
  * @brief Covers the condition and action for a classifier.
  * @param [in] xcsf The XCSF data structure.
@@ -183,8 +324,9 @@ void
 cl_update(const struct XCSF *xcsf, struct Cl *c, const double *x,
           const double *y, const int set_num, const bool cur)
 {
+    const bool copied = cl_unshare(xcsf, c);
     ++(c->exp);
-    if (!cur) { // propagate inputs for the previous state update
+    if (!cur || copied) { // propagate inputs for the previous state update
         cl_predict(xcsf, c, x);
     }
     const double error = (xcsf->loss_ptr)(xcsf, c->prediction, y);
@@ -223,9 +365,13 @@ void
 cl_free(const struct XCSF *xcsf, struct Cl *c)
 {
     free(c->prediction);
-    cond_free(xcsf, c);
-    act_free(xcsf, c);
-    pred_free(xcsf, c);
+    if (c->twin != NULL) { // structures now owned solely by the twin
+        c->twin->twin = NULL;
+    } else {
+        cond_free(xcsf, c);
+        act_free(xcsf, c);
+        pred_free(xcsf, c);
+    }
     free(c);
 }
 
@@ -429,6 +575,21 @@ cl_pred_size(const struct XCSF *xcsf, const struct Cl *c)
     return pred_size(xcsf, c);
 }
 
+/**
+ * @brief Returns the number of bytes of memory allocated for a classifier.
+ * @details Structures shared with a twin are included.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+cl_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    return sizeof(struct Cl) + sizeof(double) * xcsf->y_dim +
+        cond_mem_size(xcsf, c) + pred_mem_size(xcsf, c) +
+        act_mem_size(xcsf, c);
+}
+
 /**
  * @brief Writes a classifier to a file.
  * @param [in] xcsf The XCSF data structure.
@@ -477,6 +638,8 @@ cl_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     s += fread(&c->m, sizeof(bool), 1, fp);
     s += fread(&c->age, sizeof(int), 1, fp);
     s += fread(&c->mtotal, sizeof(int), 1, fp);
+    c->twin = NULL;
+    c->pinned = false;
     c->prediction = malloc(sizeof(double) * xcsf->y_dim);
     s += fread(c->prediction, sizeof(double), xcsf->y_dim, fp);
     s += fread(&c->action, sizeof(int), 1, fp);
@@ -67,6 +67,9 @@ cl_pred_size(const struct XCSF *xcsf, const struct Cl *c);
 size_t
 cl_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
 
+size_t
+cl_mem_size(const struct XCSF *xcsf, const struct Cl *c);
+
 size_t
 cl_save(const struct XCSF *xcsf, const struct Cl *c, FILE *fp);
 
@@ -84,6 +87,9 @@ void
 cl_init(const struct XCSF *xcsf, struct Cl *c, const double size,
         const int time);
 
+void
+cl_init_share(const struct XCSF *xcsf, struct Cl *dest, struct Cl *src);
+
 void
 cl_init_copy(const struct XCSF *xcsf, struct Cl *dest, const struct Cl *src);
 
@@ -94,6 +100,12 @@ cl_print(const struct XCSF *xcsf, const struct Cl *c, const bool print_cond,
 void
 cl_rand(const struct XCSF *xcsf, struct Cl *c);
 
+bool
+cl_shareable(const struct XCSF *xcsf);
+
+bool
+cl_unshare(const struct XCSF *xcsf, struct Cl *c);
+
 void
 cl_update(const struct XCSF *xcsf, struct Cl *c, const double *x,
           const double *y, const int set_num, const bool cur);
@@ -22,8 +22,17 @@
  */
 
 #include "clset.h"
+#include "action.h"
 #include "cl.h"
+#include "condition.h"
+#include "prediction.h"
+#include "prof.h"
 #include "utils.h"
+#include <limits.h>
+
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
 
 #define MAX_COVER (1000000) //!< Maximum number of covering attempts
 
@@ -56,14 +65,16 @@ clset_pset_never_match(const struct XCSF *xcsf, struct Clist **del,
  * two classifiers are selected using roulette wheel selection with the
  * deletion vote and the rule with the largest condition + prediction size is
  * chosen. For fixed-length representations, the effect is the same as one
- * roulete spin.
+ * roulete spin. When enforcing the memory limit, two spins are always
+ * performed and the rule using the most memory is chosen.
  * @param [in] xcsf The XCSF data structure.
+ * @param [in] mem Whether the memory limit is being enforced.
  * @param [out] del A pointer to the rule to be deleted.
  * @param [out] delprev A pointer to the rule previous to the one being deleted.
  */
 static void
-clset_pset_roulette(const struct XCSF *xcsf, struct Clist **del,
-                    struct Clist **delprev)
+clset_pset_roulette(const struct XCSF *xcsf, const bool mem,
+                    struct Clist **del, struct Clist **delprev)
 {
     const double avg_fit = clset_total_fit(&xcsf->pset) / xcsf->pset.num;
     double total_vote = 0;
@@ -73,7 +84,8 @@ clset_pset_roulette(const struct XCSF *xcsf, struct Clist **del,
         iter = iter->next;
     }
     double delsize = 0;
-    const int n_spins = (xcsf->COMPACTION && xcsf->error < xcsf->E0) ? 2 : 1;
+    const bool compact = xcsf->COMPACTION && xcsf->error < xcsf->E0;
+    const int n_spins = (mem || compact) ? 2 : 1;
     for (int i = 0; i < n_spins; ++i) {
         // perform a single roulette spin with the deletion vote
         iter = xcsf->pset.list;
@@ -86,8 +98,12 @@ clset_pset_roulette(const struct XCSF *xcsf, struct Clist **del,
             sum += cl_del_vote(xcsf, iter->cl, avg_fit);
         }
         // select the rule for deletion if it is the largest sized winner
-        const double s =
-            cl_cond_size(xcsf, iter->cl) + cl_pred_size(xcsf, iter->cl);
+        double s = 0;
+        if (mem) {
+            s = cl_mem_size(xcsf, iter->cl);
+        } else {
+            s = cl_cond_size(xcsf, iter->cl) + cl_pred_size(xcsf, iter->cl);
+        }
         if (*del == NULL || s > delsize) {
             *del = iter;
             *delprev = prev;
@@ -99,9 +115,11 @@ clset_pset_roulette(const struct XCSF *xcsf, struct Clist **del,
 /**
  * @brief Deletes a single classifier from the population set.
  * @param [in] xcsf The XCSF data structure.
+ * @param [in] mem Whether the memory limit is being enforced.
+ * @return The memory released in bytes (0 if only the numerosity decreased).
  */
-static void
-clset_pset_del(struct XCSF *xcsf)
+static size_t
+clset_pset_del(struct XCSF *xcsf, const bool mem)
 {
     struct Clist *del = NULL;
     struct Clist *delprev = NULL;
@@ -109,13 +127,17 @@ clset_pset_del(struct XCSF *xcsf)
     clset_pset_never_match(xcsf, &del, &delprev);
     // if none found, select a rule using roulette wheel
     if (del == NULL) {
-        clset_pset_roulette(xcsf, &del, &delprev);
+        clset_pset_roulette(xcsf, mem, &del, &delprev);
     }
     // decrement numerosity
     --(del->cl->num);
     --(xcsf->pset.num);
+    prof_count(xcsf, PROF_DELETED, 1);
     // remove macro-classifiers as necessary
+    size_t released = 0;
     if (del->cl->num == 0) {
+        released = sizeof(struct Clist) + cl_mem_size(xcsf, del->cl);
+        xcsf->pset_mem -= released;
         clset_add(&xcsf->kset, del->cl);
         --(xcsf->pset.size);
         if (delprev == NULL) {
@@ -125,6 +147,7 @@ clset_pset_del(struct XCSF *xcsf)
         }
         free(del);
     }
+    return released;
 }
 
 /**
@@ -158,6 +181,7 @@ clset_action_coverage(const struct XCSF *xcsf, bool *act_covered)
 static void
 clset_cover(struct XCSF *xcsf, const double *x)
 {
+    const double start = prof_start(xcsf, PROF_COVER);
     int attempts = 0;
     bool *act_covered = malloc(sizeof(bool) * xcsf->n_actions);
     bool covered = clset_action_coverage(xcsf, act_covered);
@@ -169,8 +193,10 @@ clset_cover(struct XCSF *xcsf, const double *x)
                 struct Cl *new = malloc(sizeof(struct Cl));
                 cl_init(xcsf, new, (xcsf->mset.num) + 1, xcsf->time);
                 cl_cover(xcsf, new, x, i);
-                clset_add(&xcsf->pset, new);
+                clset_pset_add(xcsf, new);
                 clset_add(&xcsf->mset, new);
+                prof_count(xcsf, PROF_COVERED, 1);
+                prof_items(xcsf, PROF_COVER, 1);
             }
         }
         // enforce population size
@@ -194,6 +220,7 @@ clset_cover(struct XCSF *xcsf, const double *x)
         }
     }
     free(act_covered);
+    prof_stop(xcsf, PROF_COVER, start);
 }
 
 /**
@@ -229,6 +256,8 @@ clset_update_fit(const struct XCSF *xcsf, const struct Set *set)
 static void
 clset_subsumption(struct XCSF *xcsf, struct Set *set)
 {
+    const double start = prof_start(xcsf, PROF_SUBSUME);
+    prof_items(xcsf, PROF_SUBSUME, set->size);
     // find the most general subsumer in the set
     struct Cl *s = NULL;
     const struct Clist *iter = set->list;
@@ -247,7 +276,9 @@ clset_subsumption(struct XCSF *xcsf, struct Set *set)
             struct Cl *c = iter->cl;
             if (c != NULL && s != c && cl_general(xcsf, s, c)) {
                 s->num += c->num;
+                prof_count(xcsf, PROF_SUBSUMED, c->num);
                 c->num = 0;
+                xcsf->pset_mem -= sizeof(struct Clist) + cl_mem_size(xcsf, c);
                 clset_add(&xcsf->kset, c);
                 subsumed = true;
             }
@@ -258,6 +289,7 @@ clset_subsumption(struct XCSF *xcsf, struct Set *set)
             clset_validate(&xcsf->pset);
         }
     }
+    prof_stop(xcsf, PROF_SUBSUME, start);
 }
 
 /**
@@ -289,7 +321,7 @@ clset_pset_init(struct XCSF *xcsf)
             struct Cl *new = malloc(sizeof(struct Cl));
             cl_init(xcsf, new, xcsf->POP_SIZE, 0);
             cl_rand(xcsf, new);
-            clset_add(&xcsf->pset, new);
+            clset_pset_add(xcsf, new);
         }
     }
 }
@@ -307,15 +339,58 @@ clset_init(struct Set *set)
 }
 
 /**
- * @brief Enforces the maximum population size limit.
+ * @brief Enforces the maximum population size and memory limits.
+ * @details If POP_MEM_SIZE is set, rules are deleted until the memory used by
+ * the population set is within the limit, biased towards the largest rules.
+ * At least one macro-classifier is always retained. The memory used is the
+ * running total maintained as rules are added and removed; defining
+ * CLSET_CHECK_MEM verifies it against a full recount on every call.
  * @param [in] xcsf The XCSF data structure.
  */
 void
 clset_pset_enforce_limit(struct XCSF *xcsf)
 {
+    const double start = prof_start(xcsf, PROF_DELETE);
     while (xcsf->pset.num > xcsf->POP_SIZE) {
-        clset_pset_del(xcsf);
+        prof_items(xcsf, PROF_DELETE, xcsf->pset.size);
+        clset_pset_del(xcsf, false);
+    }
+#ifdef CLSET_CHECK_MEM
+    struct SetMemSize size;
+    clset_mem_size(xcsf, &xcsf->pset, &size);
+    if (size.total != xcsf->pset_mem) {
+        printf("clset_pset_enforce_limit(): population uses %zu bytes, ",
+               size.total);
+        printf("%zu counted\n", xcsf->pset_mem);
+        exit(EXIT_FAILURE);
+    }
+#endif
+    if (xcsf->POP_MEM_SIZE > 0) {
+        const size_t max = (size_t) xcsf->POP_MEM_SIZE * 1024;
+        while (xcsf->pset_mem > max && xcsf->pset.size > 1) {
+            prof_items(xcsf, PROF_DELETE, xcsf->pset.size);
+            clset_pset_del(xcsf, true);
+        }
+    }
+    prof_stop(xcsf, PROF_DELETE, start);
+}
+
+/**
+ * @brief Performs covering and updates the match set statistics.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] x The input state.
+ */
+static void
+clset_match_cover(struct XCSF *xcsf, const double *x)
+{
+    // perform covering if all actions are not represented
+    if (xcsf->n_actions > 1 || xcsf->mset.size < 1) {
+        clset_cover(xcsf, x);
     }
+    // update statistics
+    xcsf->mset_size += (xcsf->mset.size - xcsf->mset_size) * xcsf->BETA;
+    xcsf->mfrac += (clset_mfrac(xcsf) - xcsf->mfrac) * xcsf->BETA;
+    prof_hist(xcsf, PROF_HIST_MSET, xcsf->mset.size);
 }
 
 /**
@@ -329,6 +404,8 @@ clset_pset_enforce_limit(struct XCSF *xcsf)
 void
 clset_match(struct XCSF *xcsf, const double *x)
 {
+    const double start = prof_start(xcsf, PROF_MATCH);
+    prof_items(xcsf, PROF_MATCH, xcsf->pset.size);
 #ifdef PARALLEL_MATCH
     // prepare for parallel processing of matching conditions
     struct Clist *blist[xcsf->pset.size];
@@ -337,11 +414,19 @@ clset_match(struct XCSF *xcsf, const double *x)
         blist[i] = iter;
         iter = iter->next;
     }
-    // process conditions and actions setting m flags in parallel
-    #pragma omp parallel for
-    for (int i = 0; i < xcsf->pset.size; ++i) {
-        cl_match(xcsf, blist[i]->cl, x);
-        cl_action(xcsf, blist[i]->cl, x);
+    // process conditions, and actions of matching classifiers, in parallel
+    const uint32_t seed = (uint32_t) rand_uniform_int(0, INT_MAX);
+    #pragma omp parallel
+    {
+        const double t = prof_thread_start(xcsf);
+        rand_init_worker(seed);
+        #pragma omp for schedule(static) nowait
+        for (int i = 0; i < xcsf->pset.size; ++i) {
+            if (cl_match(xcsf, blist[i]->cl, x)) {
+                cl_action(xcsf, blist[i]->cl, x);
+            }
+        }
+        prof_thread_stop(xcsf, PROF_MATCH, omp_get_thread_num(), t);
     }
     // build match set list in series
     for (int i = 0; i < xcsf->pset.size; ++i) {
@@ -360,13 +445,117 @@ clset_match(struct XCSF *xcsf, const double *x)
         iter = iter->next;
     }
 #endif
-    // perform covering if all actions are not represented
-    if (xcsf->n_actions > 1 || xcsf->mset.size < 1) {
-        clset_cover(xcsf, x);
+    clset_match_cover(xcsf, x);
+    prof_stop(xcsf, PROF_MATCH, start);
+}
+
+/**
+ * @brief Returns whether match sets can be constructed with
+ * clset_match_batch().
+ * @details Rules compute their actions or predictions from the condition
+ * outputs for the most recently matched input, and must therefore be matched
+ * one state at a time with clset_match().
+ * @param [in] xcsf The XCSF data structure.
+ * @return Whether the match sets of several states can be batched.
+ */
+bool
+clset_match_batchable(const struct XCSF *xcsf)
+{
+    switch (xcsf->cond->type) {
+        case RULE_TYPE_DGP:
+        case RULE_TYPE_NEURAL:
+        case RULE_TYPE_NETWORK:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Constructs the matching classifiers for a batch of input states.
+ * @details The conditions of each classifier in the population are processed
+ * for all of the states in a single pass over the population, which is
+ * performed in parallel with PARALLEL_MATCH. Each set must subsequently be
+ * completed with clset_match_complete() before use. Unless
+ * clset_match_batchable(), n must be 1 and the set completed before another
+ * state is matched.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] states The input states (n * x_dim).
+ * @param [in] n The number of states.
+ * @param [out] msets The (uncompleted) match sets, one for each state.
+ * @param [in] count Whether to count the states in the classifiers' match
+ * statistics.
+ */
+void
+clset_match_batch(struct XCSF *xcsf, const double *states, const int n,
+                  struct Set *msets, const bool count)
+{
+    const double start = prof_start(xcsf, PROF_MATCH);
+    const int size = xcsf->pset.size;
+    prof_items(xcsf, PROF_MATCH, size * n);
+    struct Cl **clist = malloc(sizeof(struct Cl *) * size);
+    bool *m = malloc(sizeof(bool) * size * n);
+    const struct Clist *iter = xcsf->pset.list;
+    for (int i = 0; iter != NULL && i < size; ++i) {
+        clist[i] = iter->cl;
+        iter = iter->next;
+    }
+    // process conditions for all states setting m flags
+#ifdef PARALLEL_MATCH
+    const uint32_t seed = (uint32_t) rand_uniform_int(0, INT_MAX);
+    #pragma omp parallel
+    {
+        const double t = prof_thread_start(xcsf);
+        rand_init_worker(seed);
+        #pragma omp for schedule(static) nowait
+#endif
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < n; ++j) {
+                const double *x = &states[j * xcsf->x_dim];
+                m[i * n + j] = count ? cl_match(xcsf, clist[i], x)
+                                     : cond_match(xcsf, clist[i], x);
+            }
+        }
+#ifdef PARALLEL_MATCH
+        prof_thread_stop(xcsf, PROF_MATCH, omp_get_thread_num(), t);
+    }
+#endif
+    // build match set lists in series
+    for (int j = 0; j < n; ++j) {
+        clset_init(&msets[j]);
+        for (int i = 0; i < size; ++i) {
+            if (m[i * n + j]) {
+                clset_add(&msets[j], clist[i]);
+            }
+        }
+    }
+    free(clist);
+    free(m);
+    prof_stop(xcsf, PROF_MATCH, start);
+}
+
+/**
+ * @brief Completes a match set constructed by clset_match_batch().
+ * @details Classifiers deleted since the batch was matched are removed from
+ * the match set and the actions of the remaining classifiers are computed.
+ * If cover is set, covering is performed if any actions are unrepresented
+ * and the match set statistics are updated.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] x The input state of the match set.
+ * @param [in] cover Whether to perform covering and update the statistics.
+ */
+void
+clset_match_complete(struct XCSF *xcsf, const double *x, const bool cover)
+{
+    clset_validate(&xcsf->mset);
+    const struct Clist *iter = xcsf->mset.list;
+    while (iter != NULL) {
+        cl_action(xcsf, iter->cl, x);
+        iter = iter->next;
+    }
+    if (cover) {
+        clset_match_cover(xcsf, x);
     }
-    // update statistics
-    xcsf->mset_size += (xcsf->mset.size - xcsf->mset_size) * xcsf->BETA;
-    xcsf->mfrac += (clset_mfrac(xcsf) - xcsf->mfrac) * xcsf->BETA;
 }
 
 /**
@@ -386,6 +575,7 @@ clset_action(struct XCSF *xcsf, const int action)
     }
     // update statistics
     xcsf->aset_size += (xcsf->aset.size - xcsf->aset_size) * xcsf->BETA;
+    prof_hist(xcsf, PROF_HIST_ASET, xcsf->aset.size);
 }
 
 /**
@@ -410,6 +600,95 @@ clset_add(struct Set *set, struct Cl *c)
     ++(set->num);
 }
 
+/**
+ * @brief Adds a classifier to the population set and counts its memory.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier to add.
+ */
+void
+clset_pset_add(struct XCSF *xcsf, struct Cl *c)
+{
+    clset_add(&xcsf->pset, c);
+    xcsf->pset_mem += sizeof(struct Clist) + cl_mem_size(xcsf, c);
+}
+
+/**
+ * @brief Recounts the memory used by the population set.
+ * @details Used after the population is replaced or many rules are resized;
+ * single rules are counted as they are added to and removed from the set.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+clset_pset_mem_reset(struct XCSF *xcsf)
+{
+    struct SetMemSize size;
+    clset_mem_size(xcsf, &xcsf->pset, &size);
+    xcsf->pset_mem = size.total;
+}
+
+/**
+ * @brief Appends a classifier to the end of a set.
+ * @param [in] set The set to add the classifier.
+ * @param [in] tail The next pointer of the last element in the set.
+ * @param [in] c The classifier to add.
+ * @return The next pointer of the new last element in the set.
+ */
+static struct Clist **
+clset_append(struct Set *set, struct Clist **tail, struct Cl *c)
+{
+    struct Clist *new = malloc(sizeof(struct Clist));
+    new->cl = c;
+    new->next = NULL;
+    *tail = new;
+    ++(set->size);
+    set->num += c->num;
+    return &new->next;
+}
+
+/**
+ * @brief Creates a deep copy of a set, preserving the classifier order.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [out] dest The set to contain the copies (assumed empty).
+ * @param [in] src The set to copy.
+ */
+void
+clset_copy(const struct XCSF *xcsf, struct Set *dest, const struct Set *src)
+{
+    clset_init(dest);
+    struct Clist **tail = &dest->list;
+    const struct Clist *iter = src->list;
+    while (iter != NULL) {
+        struct Cl *new = malloc(sizeof(struct Cl));
+        cl_init_copy(xcsf, new, iter->cl);
+        tail = clset_append(dest, tail, new);
+        iter = iter->next;
+    }
+}
+
+/**
+ * @brief Creates a copy-on-write snapshot of a set, preserving the order.
+ * @details Each classifier is copied, sharing its condition, action, and
+ * prediction with the original until either is updated or freed. Classifiers
+ * that already have a twin first stop sharing with it.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [out] dest The set to contain the snapshot (assumed empty).
+ * @param [in] src The set to snapshot.
+ */
+void
+clset_share(const struct XCSF *xcsf, struct Set *dest, const struct Set *src)
+{
+    clset_init(dest);
+    struct Clist **tail = &dest->list;
+    const struct Clist *iter = src->list;
+    while (iter != NULL) {
+        struct Cl *new = malloc(sizeof(struct Cl));
+        cl_unshare(xcsf, iter->cl);
+        cl_init_share(xcsf, new, iter->cl);
+        tail = clset_append(dest, tail, new);
+        iter = iter->next;
+    }
+}
+
 /**
  * @brief Provides reinforcement to the set and performs set subsumption.
  * @param [in] xcsf The XCSF data structure.
@@ -422,16 +701,28 @@ void
 clset_update(struct XCSF *xcsf, struct Set *set, const double *x,
              const double *y, const bool cur)
 {
+    const double start = prof_start(xcsf, PROF_UPDATE);
+    prof_items(xcsf, PROF_UPDATE, set->size);
 #ifdef PARALLEL_UPDATE
     struct Clist *blist[set->size];
     struct Clist *iter = set->list;
     for (int i = 0; iter != NULL && i < set->size; ++i) {
         blist[i] = iter;
+        if (cl_unshare(xcsf, iter->cl) && cur) { // restore intermediates
+            cl_predict(xcsf, iter->cl, x);
+        }
         iter = iter->next;
     }
-    #pragma omp parallel for
-    for (int i = 0; i < set->size; ++i) {
-        cl_update(xcsf, blist[i]->cl, x, y, set->num, cur);
+    const uint32_t seed = (uint32_t) rand_uniform_int(0, INT_MAX);
+    #pragma omp parallel
+    {
+        const double t = prof_thread_start(xcsf);
+        rand_init_worker(seed);
+        #pragma omp for schedule(static) nowait
+        for (int i = 0; i < set->size; ++i) {
+            cl_update(xcsf, blist[i]->cl, x, y, set->num, cur);
+        }
+        prof_thread_stop(xcsf, PROF_UPDATE, omp_get_thread_num(), t);
     }
 #else
     struct Clist *iter = set->list;
@@ -444,6 +735,7 @@ clset_update(struct XCSF *xcsf, struct Set *set, const double *x,
     if (xcsf->SET_SUBSUMPTION) {
         clset_subsumption(xcsf, set);
     }
+    prof_stop(xcsf, PROF_UPDATE, start);
 }
 
 /**
@@ -610,11 +902,13 @@ clset_pset_load(struct XCSF *xcsf, FILE *fp)
     s += fread(&size, sizeof(int), 1, fp);
     s += fread(&num, sizeof(int), 1, fp);
     clset_init(&xcsf->pset);
+    struct Clist **tail = &xcsf->pset.list;
     for (int i = 0; i < size; ++i) {
         struct Cl *c = malloc(sizeof(struct Cl));
         s += cl_load(xcsf, c, fp);
-        clset_add(&xcsf->pset, c);
+        tail = clset_append(&xcsf->pset, tail, c);
     }
+    clset_pset_mem_reset(xcsf);
     return s;
 }
 
@@ -658,6 +952,32 @@ clset_mean_pred_size(const struct XCSF *xcsf, const struct Set *set)
     return sum / cnt;
 }
 
+/**
+ * @brief Calculates the memory allocated for a set of classifiers.
+ * @details Structures that classifiers share with their twins are counted
+ * in full for each classifier in the set.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] set The set to calculate the memory size.
+ * @param [out] size The memory size of each component in bytes.
+ */
+void
+clset_mem_size(const struct XCSF *xcsf, const struct Set *set,
+               struct SetMemSize *size)
+{
+    memset(size, 0, sizeof(struct SetMemSize));
+    const struct Clist *iter = set->list;
+    while (iter != NULL) {
+        const struct Cl *c = iter->cl;
+        size->list += sizeof(struct Clist);
+        size->cl += sizeof(struct Cl) + sizeof(double) * xcsf->y_dim;
+        size->cond += cond_mem_size(xcsf, c);
+        size->pred += pred_mem_size(xcsf, c);
+        size->act += act_mem_size(xcsf, c);
+        iter = iter->next;
+    }
+    size->total = size->list + size->cl + size->cond + size->pred + size->act;
+}
+
 /**
  * @brief Returns the fraction of inputs matched by the most general rule with
  * error below E0. If no rules below E0, the lowest error rule is used.
@@ -25,6 +25,18 @@
 
 #include "xcsf.h"
 
+/**
+ * @brief Memory allocated for a set of classifiers by component, in bytes.
+ */
+struct SetMemSize {
+    size_t list; //!< Set list elements
+    size_t cl; //!< Classifier structures and current predictions
+    size_t cond; //!< Conditions
+    size_t pred; //!< Predictions
+    size_t act; //!< Actions
+    size_t total; //!< Sum of all components
+};
+
 double
 clset_mean_cond_size(const struct XCSF *xcsf, const struct Set *set);
 
@@ -52,6 +64,12 @@ clset_action(struct XCSF *xcsf, const int action);
 void
 clset_add(struct Set *set, struct Cl *c);
 
+void
+clset_copy(const struct XCSF *xcsf, struct Set *dest, const struct Set *src);
+
+void
+clset_share(const struct XCSF *xcsf, struct Set *dest, const struct Set *src);
+
 void
 clset_free(struct Set *set);
 
@@ -64,12 +82,32 @@ clset_kill(const struct XCSF *xcsf, struct Set *set);
 void
 clset_match(struct XCSF *xcsf, const double *x);
 
+void
+clset_match_batch(struct XCSF *xcsf, const double *states, const int n,
+                  struct Set *msets, const bool count);
+
+void
+clset_match_complete(struct XCSF *xcsf, const double *x, const bool cover);
+
+bool
+clset_match_batchable(const struct XCSF *xcsf);
+
+void
+clset_mem_size(const struct XCSF *xcsf, const struct Set *set,
+               struct SetMemSize *size);
+
 void
 clset_pset_enforce_limit(struct XCSF *xcsf);
 
 void
 clset_pset_init(struct XCSF *xcsf);
 
+void
+clset_pset_add(struct XCSF *xcsf, struct Cl *c);
+
+void
+clset_pset_mem_reset(struct XCSF *xcsf);
+
 void
 clset_print(const struct XCSF *xcsf, const struct Set *set,
             const bool print_cond, const bool print_act, const bool print_pred);
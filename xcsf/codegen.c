@@ -0,0 +1,584 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file codegen.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Standalone C source code generation for inference.
+ * @details Writes a self-contained C file that computes the same prediction
+ * array as a frozen model of the population. All dimensions are compile-time
+ * constants and there are no function pointers, allocations, random numbers
+ * or configuration files, so the compiler can specialise everything.
+ * Hyperrectangle, hyperellipsoid and ternary conditions and constant and
+ * linear predictions are written as constant tables. GP tree conditions are
+ * written as straight-line expressions and neural network conditions and
+ * predictions as one function per network with each layer unrolled. Only
+ * connected, dropout, noise and softmax layers are supported.
+ */
+
+#include "codegen.h"
+#include "action.h"
+#include "cond_ellipsoid.h"
+#include "cond_gp.h"
+#include "cond_neural.h"
+#include "cond_rectangle.h"
+#include "cond_ternary.h"
+#include "condition.h"
+#include "gp.h"
+#include "neural.h"
+#include "neural_activations.h"
+#include "neural_layer.h"
+#include "pred_neural.h"
+#include "pred_nlms.h"
+#include "pred_rls.h"
+#include "prediction.h"
+
+/**
+ * @brief Returns whether a prediction type is linear.
+ * @param [in] type The prediction type.
+ * @return Whether the prediction is linear.
+ */
+static bool
+codegen_linear(const int type)
+{
+    return type >= PRED_TYPE_NLMS_LINEAR && type <= PRED_TYPE_RLS_QUADRATIC;
+}
+
+/**
+ * @brief Exits if the population cannot be written as C code.
+ * @param [in] xcsf The XCSF data structure.
+ */
+static void
+codegen_check(const struct XCSF *xcsf)
+{
+    if (xcsf->n_actions > 1 && xcsf->act->type != ACT_TYPE_INTEGER) {
+        printf("codegen_export(): unsupported action type: %s\n",
+               action_type_as_string(xcsf->act->type));
+        exit(EXIT_FAILURE);
+    }
+    switch (xcsf->cond->type) {
+        case COND_TYPE_DUMMY:
+        case COND_TYPE_HYPERRECTANGLE:
+        case COND_TYPE_HYPERELLIPSOID:
+        case COND_TYPE_TERNARY:
+        case COND_TYPE_GP:
+        case COND_TYPE_NEURAL:
+            break;
+        default:
+            printf("codegen_export(): unsupported condition type: %s\n",
+                   condition_type_as_string(xcsf->cond->type));
+            exit(EXIT_FAILURE);
+    }
+    if (xcsf->pred->type != PRED_TYPE_CONSTANT &&
+        xcsf->pred->type != PRED_TYPE_NEURAL &&
+        !codegen_linear(xcsf->pred->type)) {
+        printf("codegen_export(): unsupported prediction type: %s\n",
+               prediction_type_as_string(xcsf->pred->type));
+        exit(EXIT_FAILURE);
+    }
+    if (xcsf->pset.size < 1) {
+        printf("codegen_export(): the population is empty\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Writes an array of doubles as a brace-enclosed initialiser.
+ * @param [in] fp Pointer to the output file.
+ * @param [in] v The values to write.
+ * @param [in] n The number of values.
+ * @param [in] depth The nesting depth of the initialiser.
+ */
+static void
+codegen_doubles(FILE *fp, const double *v, const int n, const int depth)
+{
+    fprintf(fp, "{");
+    for (int i = 0; i < n; ++i) {
+        if (i % CODEGEN_PER_LINE == 0) {
+            fprintf(fp, "\n%*s", 4 * (depth + 1), "");
+        } else {
+            fprintf(fp, " ");
+        }
+        fprintf(fp, "%.17g%s", v[i], (i < n - 1) ? "," : "");
+    }
+    fprintf(fp, "\n%*s}", 4 * depth, "");
+}
+
+/**
+ * @brief Writes the header, includes, and dimensions of the generated file.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the output file.
+ */
+static void
+codegen_header(const struct XCSF *xcsf, FILE *fp)
+{
+    fprintf(fp, "/*\n");
+    fprintf(fp, " * Standalone inference for %d classifiers exported by XCSF ",
+            xcsf->pset.size);
+    fprintf(fp, "%d.%d.%d\n", VERSION_MAJOR, VERSION_MINOR, VERSION_BUILD);
+    fprintf(fp, " * (condition: %s, prediction: %s).\n",
+            condition_type_as_string(xcsf->cond->type),
+            prediction_type_as_string(xcsf->pred->type));
+    fprintf(fp, " *\n");
+    fprintf(fp, " * xcsf_predict() computes the fitness weighted ");
+    fprintf(fp, "prediction of the matching\n * classifiers for each action ");
+    fprintf(fp, "from XCSF_X_DIM inputs and writes\n * XCSF_N_ACTIONS * ");
+    fprintf(fp, "XCSF_Y_DIM values. No covering is performed: the\n");
+    fprintf(fp, " * predictions for inputs that no classifier matches ");
+    fprintf(fp, "are zero.\n */\n\n");
+    fprintf(fp, "#include <math.h>\n#include <stdbool.h>\n\n");
+    fprintf(fp, "#define XCSF_X_DIM (%d)\n", xcsf->x_dim);
+    fprintf(fp, "#define XCSF_Y_DIM (%d)\n", xcsf->y_dim);
+    fprintf(fp, "#define XCSF_N_ACTIONS (%d)\n", xcsf->n_actions);
+    fprintf(fp, "#define XCSF_N_CL (%d)\n", xcsf->pset.size);
+    if (xcsf->cond->type == COND_TYPE_TERNARY) {
+        fprintf(fp, "#define XCSF_BITS (%d)\n", xcsf->cond->bits);
+    }
+    if (codegen_linear(xcsf->pred->type)) {
+        const struct PredNLMS *pred = xcsf->pset.list->cl->pred;
+        fprintf(fp, "#define XCSF_PRED_N (%d)\n", pred->n);
+        fprintf(fp, "#define XCSF_X0 (%.17g)\n", xcsf->pred->x0);
+    }
+    fprintf(fp, "\nvoid\nxcsf_predict(const double *x, double *pred);\n\n");
+}
+
+/**
+ * @brief Writes the classifier fitness and action tables.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the output file.
+ */
+static void
+codegen_tables(const struct XCSF *xcsf, FILE *fp)
+{
+    const int n = xcsf->pset.size;
+    double *fit = malloc(sizeof(double) * n);
+    const struct Clist *iter = xcsf->pset.list;
+    for (int i = 0; iter != NULL; ++i, iter = iter->next) {
+        fit[i] = iter->cl->fit;
+    }
+    fprintf(fp, "static const double xcsf_fit[XCSF_N_CL] = ");
+    codegen_doubles(fp, fit, n, 0);
+    fprintf(fp, ";\n\nstatic const int xcsf_action[XCSF_N_CL] = {");
+    iter = xcsf->pset.list;
+    for (int i = 0; iter != NULL; ++i, iter = iter->next) {
+        if (i % (4 * CODEGEN_PER_LINE) == 0) {
+            fprintf(fp, "\n    ");
+        } else {
+            fprintf(fp, " ");
+        }
+        fprintf(fp, "%d%s", iter->cl->action, (i < n - 1) ? "," : "");
+    }
+    fprintf(fp, "\n};\n\n");
+    free(fit);
+}
+
+/**
+ * @brief Writes an activation function with the neuron state clamping.
+ * @param [in] fp Pointer to the output file.
+ */
+static void
+codegen_activations(FILE *fp)
+{
+    fprintf(fp, "static double\nxcsf_activate(const int a, double x)\n{\n");
+    fprintf(fp, "    x = (x < %d) ? %d : (x > %d) ? %d : x;\n", NEURON_MIN,
+            NEURON_MIN, NEURON_MAX, NEURON_MAX);
+    fprintf(fp, "    switch (a) {\n");
+    fprintf(fp, "        case %d:\n", LOGISTIC);
+    fprintf(fp, "            return 1. / (1. + exp(-x));\n");
+    fprintf(fp, "        case %d:\n", RELU);
+    fprintf(fp, "            return x * (x > 0);\n");
+    fprintf(fp, "        case %d:\n", TANH);
+    fprintf(fp, "            return tanh(x);\n");
+    fprintf(fp, "        case %d:\n", GAUSSIAN);
+    fprintf(fp, "            return exp(-x * x);\n");
+    fprintf(fp, "        case %d:\n", SIN);
+    fprintf(fp, "            return sin(x);\n");
+    fprintf(fp, "        case %d:\n", COS);
+    fprintf(fp, "            return cos(x);\n");
+    fprintf(fp, "        case %d:\n", SOFT_PLUS);
+    fprintf(fp, "            return log1p(exp(x));\n");
+    fprintf(fp, "        case %d:\n", LEAKY);
+    fprintf(fp, "            return (x > 0) ? x : .1 * x;\n");
+    fprintf(fp, "        case %d:\n", SELU);
+    fprintf(fp, "            return (x >= 0) * 1.0507 * x +\n");
+    fprintf(fp, "                (x < 0) * 1.0507 * 1.6732 * expm1(x);\n");
+    fprintf(fp, "        case %d:\n", LOGGY);
+    fprintf(fp, "            return 2. / (1. + exp(-x)) - 1;\n");
+    fprintf(fp, "        default:\n");
+    fprintf(fp, "            return x;\n");
+    fprintf(fp, "    }\n}\n\n");
+}
+
+/**
+ * @brief Writes a neural network as a function with each layer unrolled.
+ * @details The function copies the first n_out network outputs to y.
+ * @param [in] fp Pointer to the output file.
+ * @param [in] net The neural network to write.
+ * @param [in] name The name of the function.
+ * @param [in] n_out The number of outputs to copy.
+ */
+static void
+codegen_net(FILE *fp, const struct Net *net, const char *name,
+            const int n_out)
+{
+    int i = 0;
+    for (const struct Llist *iter = net->tail; iter != NULL;
+         iter = iter->prev, ++i) {
+        const struct Layer *l = iter->layer;
+        switch (l->type) {
+            case CONNECTED:
+                fprintf(fp, "static const double %s_w%d[%d][%d] = {\n", name,
+                        i, l->n_outputs, l->n_inputs);
+                for (int j = 0; j < l->n_outputs; ++j) {
+                    fprintf(fp, "    ");
+                    codegen_doubles(fp, &l->weights[j * l->n_inputs],
+                                    l->n_inputs, 1);
+                    fprintf(fp, "%s\n", (j < l->n_outputs - 1) ? "," : "");
+                }
+                fprintf(fp, "};\n\nstatic const double %s_b%d[%d] = ", name,
+                        i, l->n_outputs);
+                codegen_doubles(fp, l->biases, l->n_outputs, 0);
+                fprintf(fp, ";\n\n");
+                break;
+            case DROPOUT:
+            case NOISE:
+            case SOFTMAX:
+                break;
+            default:
+                printf("codegen_export(): unsupported layer type: %s\n",
+                       layer_type_as_string(l->type));
+                exit(EXIT_FAILURE);
+        }
+    }
+    fprintf(fp, "static void\n%s(const double *x, double *y)\n{\n", name);
+    char in[16] = "x";
+    i = 0;
+    for (const struct Llist *iter = net->tail; iter != NULL;
+         iter = iter->prev, ++i) {
+        const struct Layer *l = iter->layer;
+        if (l->type == CONNECTED) {
+            fprintf(fp, "    double h%d[%d];\n", i, l->n_outputs);
+            fprintf(fp, "    for (int j = 0; j < %d; ++j) {\n", l->n_outputs);
+            fprintf(fp, "        double s = 0;\n");
+            fprintf(fp, "        for (int k = 0; k < %d; ++k) {\n",
+                    l->n_inputs);
+            fprintf(fp, "            s += %s[k] * %s_w%d[j][k];\n", in, name,
+                    i);
+            fprintf(fp, "        }\n");
+            fprintf(fp, "        h%d[j] = xcsf_activate(%d, %s_b%d[j] + s);\n",
+                    i, l->function, name, i);
+            fprintf(fp, "    }\n");
+        } else if (l->type == SOFTMAX) {
+            fprintf(fp, "    double h%d[%d];\n", i, l->n_outputs);
+            fprintf(fp, "    double largest%d = %s[0];\n", i, in);
+            fprintf(fp, "    for (int j = 1; j < %d; ++j) {\n", l->n_inputs);
+            fprintf(fp, "        if (%s[j] > largest%d) {\n", in, i);
+            fprintf(fp, "            largest%d = %s[j];\n", i, in);
+            fprintf(fp, "        }\n    }\n");
+            fprintf(fp, "    double sum%d = 0;\n", i);
+            fprintf(fp, "    for (int j = 0; j < %d; ++j) {\n", l->n_inputs);
+            fprintf(fp, "        h%d[j] = exp((%s[j] / %.17g) - ", i, in,
+                    l->scale);
+            fprintf(fp, "(largest%d / %.17g));\n", i, l->scale);
+            fprintf(fp, "        sum%d += h%d[j];\n    }\n", i, i);
+            fprintf(fp, "    for (int j = 0; j < %d; ++j) {\n", l->n_inputs);
+            fprintf(fp, "        h%d[j] /= sum%d;\n    }\n", i, i);
+        } else {
+            continue;
+        }
+        snprintf(in, sizeof(in), "h%d", i);
+    }
+    fprintf(fp, "    for (int j = 0; j < %d; ++j) {\n", n_out);
+    fprintf(fp, "        y[j] = %s[j];\n    }\n}\n\n", in);
+}
+
+/**
+ * @brief Writes the matching function for table-based conditions.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the output file.
+ */
+static void
+codegen_cond_table(const struct XCSF *xcsf, FILE *fp)
+{
+    const int type = xcsf->cond->type;
+    if (type == COND_TYPE_TERNARY) {
+        fprintf(fp, "static const char xcsf_cond[XCSF_N_CL]");
+        fprintf(fp, "[XCSF_X_DIM * XCSF_BITS + 1] = {\n");
+        for (const struct Clist *iter = xcsf->pset.list; iter != NULL;
+             iter = iter->next) {
+            const struct CondTernary *cond = iter->cl->cond;
+            fprintf(fp, "    \"%.*s\"%s\n", cond->length, cond->string,
+                    (iter->next != NULL) ? "," : "");
+        }
+        fprintf(fp, "};\n\n");
+        fprintf(fp, "static void\nxcsf_binarise(const double *x, ");
+        fprintf(fp, "char *binary)\n{\n");
+        fprintf(fp, "    for (int i = 0; i < XCSF_X_DIM; ++i) {\n");
+        fprintf(fp, "        char *b = &binary[i * XCSF_BITS];\n");
+        fprintf(fp, "        int a = (int) (x[i] * pow(2, XCSF_BITS));\n");
+        fprintf(fp, "        for (int j = 0; j < XCSF_BITS; ++j) {\n");
+        fprintf(fp, "            if (x[i] >= 1) {\n");
+        fprintf(fp, "                b[j] = '1';\n");
+        fprintf(fp, "            } else if (x[i] <= 0) {\n");
+        fprintf(fp, "                b[j] = '0';\n");
+        fprintf(fp, "            } else {\n");
+        fprintf(fp, "                b[XCSF_BITS - 1 - j] = (a %% 2) + '0';\n");
+        fprintf(fp, "                a /= 2;\n");
+        fprintf(fp, "            }\n        }\n    }\n}\n\n");
+        fprintf(fp, "static bool\nxcsf_match(const int i, const char *x)\n");
+        fprintf(fp, "{\n    for (int j = 0; j < XCSF_X_DIM * XCSF_BITS; ");
+        fprintf(fp, "++j) {\n");
+        fprintf(fp, "        if (xcsf_cond[i][j] != '#' && ");
+        fprintf(fp, "xcsf_cond[i][j] != x[j]) {\n");
+        fprintf(fp, "            return false;\n        }\n    }\n");
+        fprintf(fp, "    return true;\n}\n\n");
+        return;
+    }
+    if (type == COND_TYPE_DUMMY) {
+        fprintf(fp, "static bool\nxcsf_match(const int i, const double *x)\n");
+        fprintf(fp, "{\n    (void) i;\n    (void) x;\n    return true;\n}\n\n");
+        return;
+    }
+    const int x_dim = xcsf->x_dim;
+    double *v = malloc(sizeof(double) * 2 * x_dim);
+    fprintf(fp, "static const double xcsf_cond[XCSF_N_CL][2 * XCSF_X_DIM] ");
+    fprintf(fp, "= {\n");
+    for (const struct Clist *iter = xcsf->pset.list; iter != NULL;
+         iter = iter->next) {
+        const struct CondRectangle *cond = iter->cl->cond;
+        memcpy(v, cond->center, sizeof(double) * x_dim);
+        memcpy(v + x_dim, cond->spread, sizeof(double) * x_dim);
+        fprintf(fp, "    ");
+        codegen_doubles(fp, v, 2 * x_dim, 1);
+        fprintf(fp, "%s\n", (iter->next != NULL) ? "," : "");
+    }
+    fprintf(fp, "};\n\n");
+    free(v);
+    fprintf(fp, "static bool\nxcsf_match(const int i, const double *x)\n{\n");
+    if (type == COND_TYPE_HYPERRECTANGLE) {
+        fprintf(fp, "    for (int j = 0; j < XCSF_X_DIM; ++j) {\n");
+        fprintf(fp, "        const double d = (x[j] - xcsf_cond[i][j]) / ");
+        fprintf(fp, "xcsf_cond[i][XCSF_X_DIM + j];\n");
+        fprintf(fp, "        if (fabs(d) >= 1) {\n");
+        fprintf(fp, "            return false;\n        }\n    }\n");
+        fprintf(fp, "    return true;\n}\n\n");
+    } else {
+        fprintf(fp, "    double dist = 0;\n");
+        fprintf(fp, "    for (int j = 0; j < XCSF_X_DIM; ++j) {\n");
+        fprintf(fp, "        const double d = (x[j] - xcsf_cond[i][j]) / ");
+        fprintf(fp, "xcsf_cond[i][XCSF_X_DIM + j];\n");
+        fprintf(fp, "        dist += d * d;\n    }\n");
+        fprintf(fp, "    return dist < 1;\n}\n\n");
+    }
+}
+
+/**
+ * @brief Writes a function per classifier condition and the matching
+ * function for GP tree and neural network conditions.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the output file.
+ */
+static void
+codegen_cond_functions(const struct XCSF *xcsf, FILE *fp)
+{
+    char name[32];
+    int i = 0;
+    if (xcsf->cond->type == COND_TYPE_GP) {
+        fprintf(fp, "static double\nxcsf_clamp(const double a)\n{\n");
+        fprintf(fp, "    return (a < %d) ? %d : (a > %d) ? %d : a;\n}\n\n",
+                RET_MIN, RET_MIN, RET_MAX, RET_MAX);
+        fprintf(fp, "static double\nxcsf_div(const double a, ");
+        fprintf(fp, "const double b)\n{\n");
+        fprintf(fp, "    return (b != 0) ? (a / b) : a;\n}\n\n");
+    }
+    for (const struct Clist *iter = xcsf->pset.list; iter != NULL;
+         iter = iter->next, ++i) {
+        if (xcsf->cond->type == COND_TYPE_GP) {
+            const struct CondGP *cond = iter->cl->cond;
+            int n_vars = 0;
+            fprintf(fp, "static bool\nxcsf_cond_%d(const double *x)\n{\n", i);
+            fprintf(fp, "    (void) x;\n");
+            tree_codegen(&cond->gp, xcsf->cond->targs, fp, 0, &n_vars);
+            fprintf(fp, "    return t%d > 0.5;\n}\n\n", n_vars - 1);
+        } else {
+            const struct CondNeural *cond = iter->cl->cond;
+            snprintf(name, sizeof(name), "xcsf_cond_net_%d", i);
+            codegen_net(fp, &cond->net, name, 1);
+            fprintf(fp, "static bool\nxcsf_cond_%d(const double *x)\n{\n", i);
+            fprintf(fp, "    double y;\n    %s(x, &y);\n", name);
+            fprintf(fp, "    return y > 0.5;\n}\n\n");
+        }
+    }
+    fprintf(fp, "static bool\nxcsf_match(const int i, const double *x)\n{\n");
+    fprintf(fp, "    switch (i) {\n");
+    for (i = 0; i < xcsf->pset.size; ++i) {
+        fprintf(fp, "        case %d:\n            return xcsf_cond_%d(x);\n",
+                i, i);
+    }
+    fprintf(fp, "        default:\n            return false;\n    }\n}\n\n");
+}
+
+/**
+ * @brief Writes the prediction tables or functions and the function that
+ * computes a classifier's prediction.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the output file.
+ */
+static void
+codegen_pred(const struct XCSF *xcsf, FILE *fp)
+{
+    const int type = xcsf->pred->type;
+    if (type == PRED_TYPE_NEURAL) {
+        char name[32];
+        int i = 0;
+        for (const struct Clist *iter = xcsf->pset.list; iter != NULL;
+             iter = iter->next, ++i) {
+            const struct PredNeural *pred = iter->cl->pred;
+            snprintf(name, sizeof(name), "xcsf_pred_net_%d", i);
+            codegen_net(fp, &pred->net, name, xcsf->y_dim);
+        }
+        fprintf(fp, "static void\nxcsf_compute(const int i, ");
+        fprintf(fp, "const double *x, double *p)\n{\n    switch (i) {\n");
+        for (i = 0; i < xcsf->pset.size; ++i) {
+            fprintf(fp, "        case %d:\n", i);
+            fprintf(fp, "            xcsf_pred_net_%d(x, p);\n", i);
+            fprintf(fp, "            break;\n");
+        }
+        fprintf(fp, "        default:\n            break;\n    }\n}\n\n");
+        return;
+    }
+    const bool linear = codegen_linear(type);
+    fprintf(fp, "static const double xcsf_pred[XCSF_N_CL][XCSF_Y_DIM%s] = {\n",
+            linear ? " * XCSF_PRED_N" : "");
+    for (const struct Clist *iter = xcsf->pset.list; iter != NULL;
+         iter = iter->next) {
+        const struct Cl *c = iter->cl;
+        fprintf(fp, "    ");
+        if (!linear) {
+            codegen_doubles(fp, c->prediction, xcsf->y_dim, 1);
+        } else if (type == PRED_TYPE_NLMS_LINEAR ||
+                   type == PRED_TYPE_NLMS_QUADRATIC) {
+            const struct PredNLMS *pred = c->pred;
+            codegen_doubles(fp, pred->weights, pred->n_weights, 1);
+        } else {
+            const struct PredRLS *pred = c->pred;
+            codegen_doubles(fp, pred->weights, pred->n_weights, 1);
+        }
+        fprintf(fp, "%s\n", (iter->next != NULL) ? "," : "");
+    }
+    fprintf(fp, "};\n\n");
+    if (!linear) {
+        fprintf(fp, "static void\nxcsf_compute(const int i, ");
+        fprintf(fp, "const double *x, double *p)\n{\n    (void) x;\n");
+        fprintf(fp, "    for (int j = 0; j < XCSF_Y_DIM; ++j) {\n");
+        fprintf(fp, "        p[j] = xcsf_pred[i][j];\n    }\n}\n\n");
+        return;
+    }
+    fprintf(fp, "static void\nxcsf_transform(const double *x, ");
+    fprintf(fp, "double *input)\n{\n    input[0] = XCSF_X0;\n");
+    fprintf(fp, "    for (int i = 0; i < XCSF_X_DIM; ++i) {\n");
+    fprintf(fp, "        input[1 + i] = x[i];\n    }\n");
+    if (type == PRED_TYPE_NLMS_QUADRATIC || type == PRED_TYPE_RLS_QUADRATIC) {
+        fprintf(fp, "    int idx = 1 + XCSF_X_DIM;\n");
+        fprintf(fp, "    for (int i = 0; i < XCSF_X_DIM; ++i) {\n");
+        fprintf(fp, "        for (int j = i; j < XCSF_X_DIM; ++j) {\n");
+        fprintf(fp, "            input[idx] = x[i] * x[j];\n");
+        fprintf(fp, "            ++idx;\n        }\n    }\n");
+    }
+    fprintf(fp, "}\n\n");
+    fprintf(fp, "static void\nxcsf_compute(const int i, ");
+    fprintf(fp, "const double *input, double *p)\n{\n");
+    fprintf(fp, "    for (int j = 0; j < XCSF_Y_DIM; ++j) {\n");
+    fprintf(fp, "        const double *w = &xcsf_pred[i][j * XCSF_PRED_N];\n");
+    fprintf(fp, "        p[j] = 0;\n");
+    fprintf(fp, "        for (int k = 0; k < XCSF_PRED_N; ++k) {\n");
+    fprintf(fp, "            p[j] += w[k] * input[k];\n");
+    fprintf(fp, "        }\n    }\n}\n\n");
+}
+
+/**
+ * @brief Writes the prediction function of the generated file.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the output file.
+ */
+static void
+codegen_predict(const struct XCSF *xcsf, FILE *fp)
+{
+    const bool ternary = (xcsf->cond->type == COND_TYPE_TERNARY);
+    const bool linear = codegen_linear(xcsf->pred->type);
+    fprintf(fp, "void\nxcsf_predict(const double *x, double *pred)\n{\n");
+    fprintf(fp, "    double nr[XCSF_N_ACTIONS * XCSF_Y_DIM] = { 0 };\n");
+    fprintf(fp, "    double p[XCSF_Y_DIM];\n");
+    if (ternary) {
+        fprintf(fp, "    char binary[XCSF_X_DIM * XCSF_BITS];\n");
+        fprintf(fp, "    xcsf_binarise(x, binary);\n");
+    }
+    if (linear) {
+        fprintf(fp, "    double input[XCSF_PRED_N];\n");
+        fprintf(fp, "    xcsf_transform(x, input);\n");
+    }
+    fprintf(fp, "    for (int k = 0; k < XCSF_N_ACTIONS * XCSF_Y_DIM; ");
+    fprintf(fp, "++k) {\n");
+    fprintf(fp, "        pred[k] = 0;\n    }\n");
+    fprintf(fp, "    for (int i = 0; i < XCSF_N_CL; ++i) {\n");
+    fprintf(fp, "        if (!xcsf_match(i, %s)) {\n",
+            ternary ? "binary" : "x");
+    fprintf(fp, "            continue;\n        }\n");
+    fprintf(fp, "        xcsf_compute(i, %s, p);\n", linear ? "input" : "x");
+    fprintf(fp, "        const int offset = xcsf_action[i] * XCSF_Y_DIM;\n");
+    fprintf(fp, "        for (int j = 0; j < XCSF_Y_DIM; ++j) {\n");
+    fprintf(fp, "            pred[offset + j] += p[j] * xcsf_fit[i];\n");
+    fprintf(fp, "            nr[offset + j] += xcsf_fit[i];\n");
+    fprintf(fp, "        }\n    }\n");
+    fprintf(fp, "    for (int k = 0; k < XCSF_N_ACTIONS * XCSF_Y_DIM; ");
+    fprintf(fp, "++k) {\n");
+    fprintf(fp, "        pred[k] = (nr[k] != 0) ? pred[k] / nr[k] : 0;\n");
+    fprintf(fp, "    }\n}\n");
+}
+
+/**
+ * @brief Writes the current population as a standalone C inference file.
+ * @details The generated file defines xcsf_predict(), which computes the
+ * same prediction array as frozen_predict() for a single sample.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] filename The name of the output file.
+ */
+void
+codegen_export(const struct XCSF *xcsf, const char *filename)
+{
+    codegen_check(xcsf);
+    FILE *fp = fopen(filename, "w");
+    if (fp == 0) {
+        printf("Error saving file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    codegen_header(xcsf, fp);
+    codegen_tables(xcsf, fp);
+    if (xcsf->cond->type == COND_TYPE_NEURAL ||
+        xcsf->pred->type == PRED_TYPE_NEURAL) {
+        codegen_activations(fp);
+    }
+    if (xcsf->cond->type == COND_TYPE_GP ||
+        xcsf->cond->type == COND_TYPE_NEURAL) {
+        codegen_cond_functions(xcsf, fp);
+    } else {
+        codegen_cond_table(xcsf, fp);
+    }
+    codegen_pred(xcsf, fp);
+    codegen_predict(xcsf, fp);
+    fclose(fp);
+}
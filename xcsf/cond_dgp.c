@@ -221,9 +221,23 @@ cond_dgp_save(const struct XCSF *xcsf, const struct Cl *c, FILE *fp)
 size_t
 cond_dgp_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
 {
-    (void) xcsf;
     struct CondDGP *new = malloc(sizeof(struct CondDGP));
     size_t s = graph_load(&new->dgp, fp);
+    new->dgp.n_inputs = xcsf->cond->dargs->n_inputs;
     c->cond = new;
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a DGP condition.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose condition memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+cond_dgp_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct CondDGP *cond = c->cond;
+    return sizeof(struct CondDGP) + graph_mem_size(&cond->dgp);
+}
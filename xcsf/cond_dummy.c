@@ -213,3 +213,17 @@ cond_dummy_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     (void) fp;
     return 0;
 }
+
+/**
+ * @brief Dummy memory size function since there is no condition structure.
+ * @param [in] xcsf XCSF data structure.
+ * @param [in] c Classifier whose condition memory size to return.
+ * @return Zero.
+ */
+size_t
+cond_dummy_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    (void) c;
+    return 0;
+}
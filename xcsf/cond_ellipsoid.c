@@ -334,3 +334,17 @@ cond_ellipsoid_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     c->cond = new;
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a hyperellipsoid condition.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose condition memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+cond_ellipsoid_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) c;
+    return sizeof(struct CondEllipsoid) +
+        sizeof(double) * (2 * xcsf->x_dim + N_MU);
+}
@@ -233,3 +233,17 @@ cond_gp_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     c->cond = new;
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a tree-GP condition.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose condition memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+cond_gp_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct CondGP *cond = c->cond;
+    return sizeof(struct CondGP) + tree_mem_size(&cond->gp);
+}
@@ -233,6 +233,20 @@ cond_neural_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     return s;
 }
 
+/**
+ * @brief Returns the memory size of a neural network condition.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose condition memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+cond_neural_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct CondNeural *cond = c->cond;
+    return sizeof(struct CondNeural) + neural_mem_size(&cond->net);
+}
+
 /**
  * @brief Returns the number of neurons in a neural condition layer.
  * @param [in] xcsf XCSF data structure.
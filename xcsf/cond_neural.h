@@ -79,6 +79,9 @@ cond_neural_save(const struct XCSF *xcsf, const struct Cl *c, FILE *fp);
 size_t
 cond_neural_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
 
+size_t
+cond_neural_mem_size(const struct XCSF *xcsf, const struct Cl *c);
+
 int
 cond_neural_neurons(const struct XCSF *xcsf, const struct Cl *c, int layer);
 
@@ -96,5 +99,5 @@ static struct CondVtbl const cond_neural_vtbl = {
     &cond_neural_mutate,    &cond_neural_copy,    &cond_neural_cover,
     &cond_neural_free,      &cond_neural_init,    &cond_neural_print,
     &cond_neural_update,    &cond_neural_size,    &cond_neural_save,
-    &cond_neural_load
+    &cond_neural_load,      &cond_neural_mem_size
 };
@@ -326,3 +326,17 @@ cond_rectangle_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     c->cond = new;
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a hyperrectangle condition.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose condition memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+cond_rectangle_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) c;
+    return sizeof(struct CondRectangle) +
+        sizeof(double) * (2 * xcsf->x_dim + N_MU);
+}
@@ -331,3 +331,17 @@ cond_ternary_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     c->cond = new;
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a ternary condition.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose condition memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+cond_ternary_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    const struct CondTernary *cond = c->cond;
+    return sizeof(struct CondTernary) + sizeof(double) * N_MU +
+        sizeof(char) * (cond->length + xcsf->cond->bits);
+}
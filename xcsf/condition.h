@@ -112,8 +112,21 @@ struct CondVtbl {
     size_t (*cond_impl_save)(const struct XCSF *xcsf, const struct Cl *c,
                              FILE *fp);
     size_t (*cond_impl_load)(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
+    size_t (*cond_impl_mem_size)(const struct XCSF *xcsf, const struct Cl *c);
 };
 
+/**
+ * @brief Returns the number of bytes of memory allocated for the condition.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose condition memory size to return.
+ * @return The memory size in bytes.
+ */
+static inline size_t
+cond_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    return (*c->cond_vptr->cond_impl_mem_size)(xcsf, c);
+}
+
 /**
  * @brief Writes the condition to a file.
  * @param [in] xcsf The XCSF data structure.
@@ -31,6 +31,7 @@
 #include "neural_layer.h"
 #include "param.h"
 #include "prediction.h"
+#include "utils.h"
 
 #define MAXLEN (127) //!< Maximum config file line length to read
 #define BASE (10) //!< Decimal numbers
@@ -53,16 +54,36 @@ config_general(struct XCSF *xcsf, const char *n, const char *v, const int i,
         param_set_omp_num_threads(xcsf, i);
     } else if (strncmp(n, "POP_SIZE\0", 9) == 0) {
         param_set_pop_size(xcsf, i);
+    } else if (strncmp(n, "POP_MEM_SIZE\0", 13) == 0) {
+        param_set_pop_mem_size(xcsf, i);
+    } else if (strncmp(n, "ISLANDS\0", 8) == 0) {
+        param_set_islands(xcsf, i);
+    } else if (strncmp(n, "MIGRATION_TRIALS\0", 17) == 0) {
+        param_set_migration_trials(xcsf, i);
+    } else if (strncmp(n, "MIGRATION_SIZE\0", 15) == 0) {
+        param_set_migration_size(xcsf, i);
     } else if (strncmp(n, "MAX_TRIALS\0", 10) == 0) {
         param_set_max_trials(xcsf, i);
     } else if (strncmp(n, "POP_INIT\0", 9) == 0) {
         param_set_pop_init(xcsf, i);
     } else if (strncmp(n, "PERF_TRIALS\0", 12) == 0) {
         param_set_perf_trials(xcsf, i);
+    } else if (strncmp(n, "CHECKPOINT_TRIALS\0", 18) == 0) {
+        param_set_checkpoint_trials(xcsf, i);
+    } else if (strncmp(n, "PUBLISH_TRIALS\0", 15) == 0) {
+        param_set_publish_trials(xcsf, i);
+    } else if (strncmp(n, "PROFILE\0", 8) == 0) {
+        param_set_profile(xcsf, i);
+    } else if (strncmp(n, "PROFILE_HW\0", 11) == 0) {
+        param_set_profile_hw(xcsf, i);
+    } else if (strncmp(n, "TRACE_SIZE\0", 11) == 0) {
+        param_set_trace_size(xcsf, i);
     } else if (strncmp(n, "LOSS_FUNC\0", 10) == 0) {
         param_set_loss_func_string(xcsf, v);
     } else if (strncmp(n, "HUBER_DELTA\0", 12) == 0) {
         param_set_huber_delta(xcsf, f);
+    } else if (strncmp(n, "RANDOM_SEED\0", 12) == 0 && i > 0) {
+        rand_init_seed((uint32_t) i);
     }
 }
 
@@ -85,6 +106,12 @@ config_multi(struct XCSF *xcsf, const char *n, const char *v, const int i,
         param_set_gamma(xcsf, f);
     } else if (strncmp(n, "P_EXPLORE\0", 10) == 0) {
         param_set_p_explore(xcsf, f);
+    } else if (strncmp(n, "REPLAY_SIZE\0", 12) == 0) {
+        param_set_replay_size(xcsf, i);
+    } else if (strncmp(n, "REPLAY_BATCH\0", 13) == 0) {
+        param_set_replay_batch(xcsf, i);
+    } else if (strncmp(n, "N_ENVS\0", 7) == 0) {
+        param_set_n_envs(xcsf, i);
     }
 }
 
@@ -135,8 +162,12 @@ config_ea(struct XCSF *xcsf, const char *n, const char *v, const int i,
         ea_param_set_err_reduc(xcsf, f);
     } else if (strncmp(n, "FIT_REDUC\0", 10) == 0) {
         ea_param_set_fit_reduc(xcsf, f);
+    } else if (strncmp(n, "EA_SUBSUMPTION\0", 15) == 0) {
+        ea_param_set_subsumption(xcsf, i);
     } else if (strncmp(n, "EA_PRED_RESET\0", 14) == 0) {
         ea_param_set_pred_reset(xcsf, i);
+    } else if (strncmp(n, "EA_ASYNC\0", 9) == 0) {
+        ea_param_set_async(xcsf, i);
     }
 }
 
@@ -337,6 +337,18 @@ graph_free(const struct Graph *dgp)
     free(dgp->mu);
 }
 
+/**
+ * @brief Returns the number of bytes of memory allocated for a DGP graph.
+ * @param [in] dgp The DGP graph.
+ * @return The memory size in bytes, excluding the graph structure itself.
+ */
+size_t
+graph_mem_size(const struct Graph *dgp)
+{
+    return sizeof(double) * (3 * dgp->n + dgp->max_k + N_MU) +
+        sizeof(int) * (dgp->n + dgp->klen);
+}
+
 /**
  * @brief Mutates a specified DGP graph.
  * @param [in] dgp The DGP graph to be mutated.
@@ -411,6 +423,7 @@ graph_load(struct Graph *dgp, FILE *fp)
     dgp->tmp_input = malloc(sizeof(double) * dgp->max_k);
     dgp->function = malloc(sizeof(int) * dgp->n);
     dgp->connectivity = malloc(sizeof(int) * dgp->klen);
+    dgp->mu = malloc(sizeof(double) * N_MU);
     s += fread(dgp->state, sizeof(double), dgp->n, fp);
     s += fread(dgp->initial_state, sizeof(double), dgp->n, fp);
     s += fread(dgp->function, sizeof(int), dgp->n, fp);
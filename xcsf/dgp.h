@@ -68,6 +68,9 @@ graph_load(struct Graph *dgp, FILE *fp);
 size_t
 graph_save(const struct Graph *dgp, FILE *fp);
 
+size_t
+graph_mem_size(const struct Graph *dgp);
+
 void
 graph_copy(struct Graph *dest, const struct Graph *src);
 
@@ -24,8 +24,13 @@
 #include "ea.h"
 #include "cl.h"
 #include "clset.h"
+#include "prof.h"
 #include "utils.h"
 
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
+
 /**
  * @brief Initialises offspring error and fitness.
  * @param [in] xcsf The XCSF data structure.
@@ -59,8 +64,8 @@ ea_init_offspring(const struct XCSF *xcsf, const struct Cl *c1p,
  * @brief Performs evolutionary algorithm subsumption.
  * @param [in] xcsf The XCSF data structure.
  * @param [in] c The offspring classifier to attempt to subsume.
- * @param [in] c1p First parent classifier.
- * @param [in] c2p Second parent classifier.
+ * @param [in] c1p First parent classifier (NULL if no longer available).
+ * @param [in] c2p Second parent classifier (NULL if no longer available).
  * @param [in] set The set in which the EA is being run.
  */
 static void
@@ -68,13 +73,16 @@ ea_subsume(struct XCSF *xcsf, struct Cl *c, struct Cl *c1p, struct Cl *c2p,
            const struct Set *set)
 {
     // check if either parent subsumes the offspring
-    if (cl_subsumer(xcsf, c1p) && cl_general(xcsf, c1p, c)) {
+    if (c1p != NULL && cl_subsumer(xcsf, c1p) && cl_general(xcsf, c1p, c)) {
         ++(c1p->num);
         ++(xcsf->pset.num);
+        prof_count(xcsf, PROF_SUBSUMED, 1);
         cl_free(xcsf, c);
-    } else if (cl_subsumer(xcsf, c2p) && cl_general(xcsf, c2p, c)) {
+    } else if (c2p != NULL && cl_subsumer(xcsf, c2p) &&
+               cl_general(xcsf, c2p, c)) {
         ++(c2p->num);
         ++(xcsf->pset.num);
+        prof_count(xcsf, PROF_SUBSUMED, 1);
         cl_free(xcsf, c);
     }
     // attempt to find a random subsumer from the set
@@ -90,11 +98,12 @@ ea_subsume(struct XCSF *xcsf, struct Cl *c, struct Cl *c1p, struct Cl *c2p,
         if (choices > 0) { // found
             ++(candidates[rand_uniform_int(0, choices)]->cl->num);
             ++(xcsf->pset.num);
+            prof_count(xcsf, PROF_SUBSUMED, 1);
             cl_free(xcsf, c);
         }
         // if no subsumers are found the offspring is added to the population
         else {
-            clset_add(&xcsf->pset, c);
+            clset_pset_add(xcsf, c);
         }
     }
 }
@@ -116,11 +125,12 @@ ea_add(struct XCSF *xcsf, const struct Set *set, struct Cl *c1p, struct Cl *c2p,
     if (!cmod && !mmod) {
         ++(c1p->num);
         ++(xcsf->pset.num);
+        prof_count(xcsf, PROF_UNCHANGED, 1);
         cl_free(xcsf, c1);
     } else if (xcsf->ea->subsumption) {
         ea_subsume(xcsf, c1, c1p, c2p, set);
     } else {
-        clset_add(&xcsf->pset, c1);
+        clset_pset_add(xcsf, c1);
     }
 }
 
@@ -190,42 +200,494 @@ ea_select(const struct XCSF *xcsf, const struct Set *set, struct Cl **c1p,
     }
 }
 
+/**
+ * @brief Creates a pair of offspring by copying, crossover, and mutation.
+ * @details The parents are copied before the operators are applied since
+ * each operator only decides whether it alters its argument while doing so.
+ * Offspring left unchanged are discarded by ea_add().
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c1p First parent classifier.
+ * @param [in] c2p Second parent classifier.
+ * @param [out] pair The offspring created.
+ */
+static void
+ea_reproduce(const struct XCSF *xcsf, const struct Cl *c1p,
+             const struct Cl *c2p, struct EaPair *pair)
+{
+    // create copies of parents
+    pair->c1 = malloc(sizeof(struct Cl));
+    pair->c2 = malloc(sizeof(struct Cl));
+    cl_init(xcsf, pair->c1, c1p->size, c1p->time);
+    cl_init(xcsf, pair->c2, c2p->size, c2p->time);
+    cl_copy(xcsf, pair->c1, c1p);
+    cl_copy(xcsf, pair->c2, c2p);
+    // apply evolutionary operators to offspring
+    pair->cmod = cl_crossover(xcsf, pair->c1, pair->c2);
+    pair->m1mod = cl_mutate(xcsf, pair->c1);
+    pair->m2mod = cl_mutate(xcsf, pair->c2);
+}
+
+/**
+ * @brief Creates several pairs of offspring in parallel.
+ * @details Each pair is created with its own random number generator stream
+ * seeded from the stream of the calling thread, so that the offspring do not
+ * depend on the number of threads or their scheduling.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c1p First parent classifier.
+ * @param [in] c2p Second parent classifier.
+ * @param [out] pairs The offspring created.
+ * @param [in] n The number of pairs to create.
+ */
+static void
+ea_reproduce_pairs(const struct XCSF *xcsf, const struct Cl *c1p,
+                   const struct Cl *c2p, struct EaPair *pairs, const int n)
+{
+    uint32_t *seed = malloc(sizeof(uint32_t) * n);
+    for (int i = 0; i < n; ++i) {
+        seed[i] = (uint32_t) rand_uniform_int(0, INT_MAX);
+    }
+    unsigned char *state = malloc(rand_state_size());
+    rand_state_get(state);
+#ifdef PARALLEL_EA
+    #pragma omp parallel
+    {
+        const double t = prof_thread_start(xcsf);
+        #pragma omp for schedule(dynamic) nowait
+#endif
+        for (int i = 0; i < n; ++i) {
+            rand_init_seed(seed[i]);
+            ea_reproduce(xcsf, c1p, c2p, &pairs[i]);
+        }
+#ifdef PARALLEL_EA
+        prof_thread_stop(xcsf, PROF_EA_REPRODUCE, omp_get_thread_num(), t);
+    }
+#endif
+    rand_state_set(state);
+    free(state);
+    free(seed);
+}
+
+/**
+ * @brief Creates the offspring of an asynchronous EA request.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] job The asynchronous EA request.
+ */
+static void
+ea_async_reproduce(const struct XCSF *xcsf, struct EaJob *job)
+{
+    rand_init_seed(job->seed);
+    for (int i = 0; i < job->n_pairs; ++i) {
+        struct EaPair *p = &job->pairs[i];
+        ea_reproduce(xcsf, job->c1p, job->c2p, p);
+        ea_init_offspring(xcsf, job->c1p, job->c2p, p->c1, p->c2, p->cmod);
+    }
+}
+
+/**
+ * @brief Creates the offspring of queued asynchronous EA requests in order;
+ * executed on the worker thread until it is stopped and the queue is empty.
+ * @param [in] arg The asynchronous EA data structure.
+ * @return NULL.
+ */
+static void *
+ea_async_worker(void *arg)
+{
+    struct EaAsync *async = arg;
+    pthread_mutex_lock(&async->lock);
+    while (true) {
+        while (async->next == NULL && !async->stop) {
+            pthread_cond_wait(&async->cond, &async->lock);
+        }
+        struct EaJob *job = async->next;
+        if (job == NULL) {
+            break;
+        }
+        pthread_mutex_unlock(&async->lock);
+        ea_async_reproduce(async->xcsf, job);
+        pthread_mutex_lock(&async->lock);
+        job->done = true;
+        async->next = job->next;
+        pthread_cond_broadcast(&async->cond);
+    }
+    pthread_mutex_unlock(&async->lock);
+    return NULL;
+}
+
+/**
+ * @brief Returns the asynchronous EA data structure, creating it if needed.
+ * @details The worker thread is only started when a request is submitted.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The asynchronous EA data structure.
+ */
+static struct EaAsync *
+ea_async_init(struct XCSF *xcsf)
+{
+    if (xcsf->ea_async == NULL) {
+        struct EaAsync *async = malloc(sizeof(struct EaAsync));
+        async->xcsf = xcsf;
+        async->head = NULL;
+        async->tail = NULL;
+        async->next = NULL;
+        async->started = false;
+        async->stop = false;
+        pthread_mutex_init(&async->lock, NULL);
+        pthread_cond_init(&async->cond, NULL);
+        xcsf->ea_async = async;
+    }
+    return xcsf->ea_async;
+}
+
+/**
+ * @brief Appends a request to the queue of the asynchronous EA.
+ * @param [in] async The asynchronous EA data structure.
+ * @param [in] job The request to append.
+ */
+static void
+ea_async_push(struct EaAsync *async, struct EaJob *job)
+{
+    job->next = NULL;
+    pthread_mutex_lock(&async->lock);
+    if (async->tail == NULL) {
+        async->head = job;
+    } else {
+        async->tail->next = job;
+    }
+    async->tail = job;
+    if (!job->done && async->next == NULL) {
+        async->next = job;
+        pthread_cond_signal(&async->cond);
+    }
+    pthread_mutex_unlock(&async->lock);
+}
+
+/**
+ * @brief Removes the oldest request from the queue once its offspring have
+ * been created.
+ * @param [in] async The asynchronous EA data structure.
+ * @return The request removed.
+ */
+static struct EaJob *
+ea_async_pop(struct EaAsync *async)
+{
+    struct EaJob *job = async->head;
+    pthread_mutex_lock(&async->lock);
+    while (!job->done) {
+        pthread_cond_wait(&async->cond, &async->lock);
+    }
+    async->head = job->next;
+    if (async->head == NULL) {
+        async->tail = NULL;
+    }
+    pthread_mutex_unlock(&async->lock);
+    return job;
+}
+
+/**
+ * @brief Returns a parent for an asynchronous EA request.
+ * @details Where possible the parent shares the selected classifier's
+ * structures and is pinned, so that the classifier receives new copies if it
+ * is updated while the worker thread reads them.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The selected classifier.
+ * @return The parent.
+ */
+static struct Cl *
+ea_async_parent(const struct XCSF *xcsf, struct Cl *c)
+{
+    struct Cl *p = malloc(sizeof(struct Cl));
+    if (cl_shareable(xcsf)) {
+        cl_unshare(xcsf, c);
+        cl_init_share(xcsf, p, c);
+        p->pinned = true;
+    } else {
+        cl_init_copy(xcsf, p, c);
+    }
+    return p;
+}
+
+/**
+ * @brief Frees an asynchronous EA request and its parents.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] job The request to free.
+ */
+static void
+ea_async_job_free(const struct XCSF *xcsf, struct EaJob *job)
+{
+    if (job->c2p != job->c1p) {
+        cl_free(xcsf, job->c2p);
+    }
+    cl_free(xcsf, job->c1p);
+    free(job->pairs);
+    free(job);
+}
+
+/**
+ * @brief Queues the creation of offspring for the worker thread.
+ * @details The parents are referenced copy-on-write so that submitting a
+ * request does not copy them. The seed of the request is drawn from the
+ * calling thread so that the offspring do not depend on the thread
+ * scheduling.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c1p First parent classifier.
+ * @param [in] c2p Second parent classifier.
+ */
+static void
+ea_async_submit(struct XCSF *xcsf, struct Cl *c1p, struct Cl *c2p)
+{
+    struct EaAsync *async = ea_async_init(xcsf);
+    struct EaJob *job = malloc(sizeof(struct EaJob));
+    job->c1p = ea_async_parent(xcsf, c1p);
+    job->c2p = (c2p == c1p) ? job->c1p : ea_async_parent(xcsf, c2p);
+    job->n_pairs = (xcsf->ea->lambda + 1) / 2;
+    job->pairs = malloc(sizeof(struct EaPair) * job->n_pairs);
+    job->seed = (uint32_t) rand_uniform_int(0, INT_MAX);
+    job->done = false;
+    if (!async->started) {
+        async->stop = false;
+        async->started =
+            pthread_create(&async->thread, NULL, ea_async_worker, async) == 0;
+    }
+    if (!async->started) {
+        printf("ea_async_submit(): failed to create EA thread\n");
+        unsigned char *state = malloc(rand_state_size());
+        rand_state_get(state);
+        ea_async_reproduce(xcsf, job);
+        rand_state_set(state);
+        free(state);
+        job->done = true;
+    }
+    ea_async_push(async, job);
+}
+
+/**
+ * @brief Waits for the offspring of the queued asynchronous EA requests and
+ * inserts them into the population.
+ * @details The parents may have since been deleted, so offspring are only
+ * subsumed by the classifiers of the current set, and offspring left
+ * unchanged by crossover and mutation are inserted as new classifiers. The
+ * population size limit is left for the caller to enforce, since rules
+ * deleted remain in the current set until the end of the trial.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] set The current set (NULL to not perform subsumption).
+ */
+static void
+ea_async_apply(struct XCSF *xcsf, const struct Set *set)
+{
+    struct EaAsync *async = xcsf->ea_async;
+    if (async == NULL || async->head == NULL) {
+        return;
+    }
+    const bool subsume =
+        xcsf->ea->subsumption && set != NULL && set->size > 0;
+    while (async->head != NULL) {
+        struct EaJob *job = ea_async_pop(async);
+        for (int i = 0; i < job->n_pairs; ++i) {
+            struct Cl *offspring[2] = { job->pairs[i].c1, job->pairs[i].c2 };
+            for (int j = 0; j < 2; ++j) {
+                if (subsume) {
+                    ea_subsume(xcsf, offspring[j], NULL, NULL, set);
+                } else {
+                    clset_pset_add(xcsf, offspring[j]);
+                }
+            }
+            prof_count(xcsf, PROF_OFFSPRING, 2);
+            prof_items(xcsf, PROF_EA_REPRODUCE, 2);
+        }
+        ea_async_job_free(xcsf, job);
+    }
+}
+
+/**
+ * @brief Inserts the offspring of any asynchronous EA requests outside of a
+ * trial.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+ea_async_flush(struct XCSF *xcsf)
+{
+    if (xcsf->ea_async != NULL && xcsf->ea_async->head != NULL) {
+        clset_init(&xcsf->kset);
+        ea_async_apply(xcsf, NULL);
+        clset_pset_enforce_limit(xcsf);
+        clset_kill(xcsf, &xcsf->kset);
+    }
+}
+
+/**
+ * @brief Stops the worker thread and frees any asynchronous EA requests and
+ * their offspring.
+ * @details The worker thread finishes the queued requests before exiting.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+ea_async_free(struct XCSF *xcsf)
+{
+    struct EaAsync *async = xcsf->ea_async;
+    if (async == NULL) {
+        return;
+    }
+    if (async->started) {
+        pthread_mutex_lock(&async->lock);
+        async->stop = true;
+        pthread_cond_signal(&async->cond);
+        pthread_mutex_unlock(&async->lock);
+        pthread_join(async->thread, NULL);
+    }
+    while (async->head != NULL) {
+        struct EaJob *job = ea_async_pop(async);
+        for (int i = 0; i < job->n_pairs; ++i) {
+            cl_free(xcsf, job->pairs[i].c1);
+            cl_free(xcsf, job->pairs[i].c2);
+        }
+        ea_async_job_free(xcsf, job);
+    }
+    pthread_cond_destroy(&async->cond);
+    pthread_mutex_destroy(&async->lock);
+    free(async);
+    xcsf->ea_async = NULL;
+}
+
+/**
+ * @brief Writes the offspring of any asynchronous EA requests to a file.
+ * @details Waits for the offspring to be created so that a checkpoint taken
+ * between trials includes them; they remain to be inserted at the next EA
+ * invocation. Each request is written in order, followed by zero.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the file to be written.
+ * @return The number of elements written.
+ */
+size_t
+ea_async_save(const struct XCSF *xcsf, FILE *fp)
+{
+    size_t s = 0;
+    struct EaAsync *async = xcsf->ea_async;
+    const struct EaJob *job = (async != NULL) ? async->head : NULL;
+    while (job != NULL) {
+        pthread_mutex_lock(&async->lock);
+        while (!job->done) {
+            pthread_cond_wait(&async->cond, &async->lock);
+        }
+        pthread_mutex_unlock(&async->lock);
+        s += fwrite(&job->n_pairs, sizeof(int), 1, fp);
+        s += cl_save(xcsf, job->c1p, fp);
+        s += cl_save(xcsf, job->c2p, fp);
+        for (int i = 0; i < job->n_pairs; ++i) {
+            s += cl_save(xcsf, job->pairs[i].c1, fp);
+            s += cl_save(xcsf, job->pairs[i].c2, fp);
+        }
+        job = job->next;
+    }
+    const int end = 0;
+    s += fwrite(&end, sizeof(int), 1, fp);
+    return s;
+}
+
+/**
+ * @brief Reads the offspring of asynchronous EA requests from a file.
+ * @details Any current requests are discarded. The offspring read are
+ * inserted at the next EA invocation.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the file to be read.
+ * @return The number of elements read.
+ */
+size_t
+ea_async_load(struct XCSF *xcsf, FILE *fp)
+{
+    ea_async_free(xcsf);
+    size_t s = 0;
+    while (true) {
+        int n_pairs = 0;
+        s += fread(&n_pairs, sizeof(int), 1, fp);
+        if (n_pairs < 1) {
+            return s;
+        }
+        if (n_pairs != (xcsf->ea->lambda + 1) / 2) {
+            printf("ea_async_load(): invalid number of offspring\n");
+            exit(EXIT_FAILURE);
+        }
+        struct EaJob *job = malloc(sizeof(struct EaJob));
+        job->n_pairs = n_pairs;
+        job->seed = 0;
+        job->done = true;
+        job->c1p = malloc(sizeof(struct Cl));
+        job->c2p = malloc(sizeof(struct Cl));
+        s += cl_load(xcsf, job->c1p, fp);
+        s += cl_load(xcsf, job->c2p, fp);
+        job->pairs = malloc(sizeof(struct EaPair) * n_pairs);
+        for (int i = 0; i < n_pairs; ++i) {
+            struct EaPair *p = &job->pairs[i];
+            p->c1 = malloc(sizeof(struct Cl));
+            p->c2 = malloc(sizeof(struct Cl));
+            s += cl_load(xcsf, p->c1, fp);
+            s += cl_load(xcsf, p->c2, fp);
+            p->cmod = false;
+            p->m1mod = false;
+            p->m2mod = false;
+        }
+        ea_async_push(ea_async_init(xcsf), job);
+    }
+}
+
 /**
  * @brief Executes the evolutionary algorithm (EA).
+ * @details If EA_ASYNC is enabled, the offspring of the previous invocation
+ * are first inserted and the offspring of this invocation are created on a
+ * background thread. Rules are only deleted once the parents are selected so
+ * that deleted rules cannot be selected from the set.
  * @param [in] xcsf The XCSF data structure.
  * @param [in] set The set in which to run the EA.
  */
 void
 ea(struct XCSF *xcsf, const struct Set *set)
 {
+    const bool inserted =
+        xcsf->ea_async != NULL && xcsf->ea_async->head != NULL;
+    if (inserted) {
+        const double start = prof_start(xcsf, PROF_EA_REPRODUCE);
+        ea_async_apply(xcsf, set);
+        prof_stop(xcsf, PROF_EA_REPRODUCE, start);
+    }
     ++(xcsf->time);
     if (set->size == 0 || xcsf->time - clset_mean_time(set) < xcsf->ea->theta) {
+        if (inserted) {
+            clset_pset_enforce_limit(xcsf);
+        }
         return; // not yet time to run the EA
     }
     clset_set_times(xcsf, set);
+    prof_count(xcsf, PROF_EA_RUNS, 1);
     // select parents
+    double start = prof_start(xcsf, PROF_EA_SELECT);
+    prof_items(xcsf, PROF_EA_SELECT, set->size);
     struct Cl *c1p = NULL;
     struct Cl *c2p = NULL;
     ea_select(xcsf, set, &c1p, &c2p);
+    prof_stop(xcsf, PROF_EA_SELECT, start);
+    if (xcsf->ea->async) {
+        ea_async_submit(xcsf, c1p, c2p);
+        clset_pset_enforce_limit(xcsf);
+        return;
+    }
     // create offspring
-    for (int i = 0; i * 2 < xcsf->ea->lambda; ++i) {
-        // create copies of parents
-        struct Cl *c1 = malloc(sizeof(struct Cl));
-        struct Cl *c2 = malloc(sizeof(struct Cl));
-        cl_init(xcsf, c1, c1p->size, c1p->time);
-        cl_init(xcsf, c2, c2p->size, c2p->time);
-        cl_copy(xcsf, c1, c1p);
-        cl_copy(xcsf, c2, c2p);
-        // apply evolutionary operators to offspring
-        const bool cmod = cl_crossover(xcsf, c1, c2);
-        const bool m1mod = cl_mutate(xcsf, c1);
-        const bool m2mod = cl_mutate(xcsf, c2);
-        // initialise parameters
-        ea_init_offspring(xcsf, c1p, c2p, c1, c2, cmod);
-        // add to population
-        ea_add(xcsf, set, c1p, c2p, c1, cmod, m1mod);
-        ea_add(xcsf, set, c2p, c1p, c2, cmod, m2mod);
+    start = prof_start(xcsf, PROF_EA_REPRODUCE);
+    const int n_pairs = (xcsf->ea->lambda + 1) / 2;
+    struct EaPair *pairs = malloc(sizeof(struct EaPair) * n_pairs);
+    if (n_pairs > 1) {
+        ea_reproduce_pairs(xcsf, c1p, c2p, pairs, n_pairs);
+    } else {
+        ea_reproduce(xcsf, c1p, c2p, &pairs[0]);
+    }
+    // insert offspring in order
+    for (int i = 0; i < n_pairs; ++i) {
+        struct EaPair *p = &pairs[i];
+        ea_init_offspring(xcsf, c1p, c2p, p->c1, p->c2, p->cmod);
+        ea_add(xcsf, set, c1p, c2p, p->c1, p->cmod, p->m1mod);
+        ea_add(xcsf, set, c2p, c1p, p->c2, p->cmod, p->m2mod);
+        prof_count(xcsf, PROF_OFFSPRING, 2);
+        prof_items(xcsf, PROF_EA_REPRODUCE, 2);
     }
+    free(pairs);
+    prof_stop(xcsf, PROF_EA_REPRODUCE, start);
     clset_pset_enforce_limit(xcsf);
 }
 
@@ -245,6 +707,7 @@ ea_param_defaults(struct XCSF *xcsf)
     ea_param_set_err_reduc(xcsf, 1);
     ea_param_set_fit_reduc(xcsf, 0.1);
     ea_param_set_pred_reset(xcsf, false);
+    ea_param_set_async(xcsf, false);
 }
 
 /**
@@ -267,6 +730,8 @@ ea_param_print(const struct XCSF *xcsf)
     xcsf->ea->subsumption ? printf("true") : printf("false");
     printf(", EA_PRED_RESET=");
     xcsf->ea->pred_reset ? printf("true") : printf("false");
+    printf(", EA_ASYNC=");
+    xcsf->ea->async ? printf("true") : printf("false");
 }
 
 /**
@@ -288,6 +753,7 @@ ea_param_save(const struct XCSF *xcsf, FILE *fp)
     s += fwrite(&xcsf->ea->fit_reduc, sizeof(double), 1, fp);
     s += fwrite(&xcsf->ea->subsumption, sizeof(bool), 1, fp);
     s += fwrite(&xcsf->ea->pred_reset, sizeof(bool), 1, fp);
+    s += fwrite(&xcsf->ea->async, sizeof(bool), 1, fp);
     return s;
 }
 
@@ -310,6 +776,7 @@ ea_param_load(struct XCSF *xcsf, FILE *fp)
     s += fread(&xcsf->ea->fit_reduc, sizeof(double), 1, fp);
     s += fread(&xcsf->ea->subsumption, sizeof(bool), 1, fp);
     s += fread(&xcsf->ea->pred_reset, sizeof(bool), 1, fp);
+    s += fread(&xcsf->ea->async, sizeof(bool), 1, fp);
     return s;
 }
 
@@ -441,6 +908,12 @@ ea_param_set_pred_reset(struct XCSF *xcsf, const bool a)
     xcsf->ea->pred_reset = a;
 }
 
+void
+ea_param_set_async(struct XCSF *xcsf, const bool a)
+{
+    xcsf->ea->async = a;
+}
+
 void
 ea_param_set_select_type(struct XCSF *xcsf, const int a)
 {
@@ -24,6 +24,7 @@
 #pragma once
 
 #include "xcsf.h"
+#include <pthread.h>
 
 #define EA_SELECT_ROULETTE (0) //!< Roulette wheel parental selection
 #define EA_SELECT_TOURNAMENT (1) //!< Tournament parental selection
@@ -44,11 +45,67 @@ struct ArgsEA {
     int lambda; //!< Number of offspring to create each EA invocation
     int select_type; //!< Roulette or tournament for EA parental selection
     bool pred_reset; //!< Whether to reset or copy offspring predictions
+    bool async; //!< Whether to create offspring on a background thread
+};
+
+/**
+ * @brief Pair of offspring created by the EA.
+ */
+struct EaPair {
+    struct Cl *c1; //!< First offspring classifier
+    struct Cl *c2; //!< Second offspring classifier
+    bool cmod; //!< Whether crossover modified the offspring
+    bool m1mod; //!< Whether mutation modified the first offspring
+    bool m2mod; //!< Whether mutation modified the second offspring
+};
+
+/**
+ * @brief Asynchronous EA request.
+ */
+struct EaJob {
+    struct Cl *c1p; //!< First parent, sharing the selected classifier
+    struct Cl *c2p; //!< Second parent (the first if selected twice)
+    struct EaPair *pairs; //!< Offspring created by the worker thread
+    int n_pairs; //!< Number of offspring pairs
+    uint32_t seed; //!< Random number generator seed of the request
+    bool done; //!< Whether the offspring have been created (guarded by lock)
+    struct EaJob *next; //!< Next request in the queue
+};
+
+/**
+ * @brief Asynchronous EA data structure.
+ * @details Each request holds copy-on-write references to the selected
+ * parents and is queued for a single persistent worker thread, which creates
+ * the offspring in order. The offspring are inserted into the population at
+ * the next EA invocation.
+ */
+struct EaAsync {
+    const struct XCSF *xcsf; //!< The XCSF data structure
+    struct EaJob *head; //!< Oldest request still to be inserted
+    struct EaJob *tail; //!< Newest request
+    struct EaJob *next; //!< Next request for the worker (guarded by lock)
+    bool started; //!< Whether the worker thread is running
+    bool stop; //!< Whether the worker thread is to exit (guarded by lock)
+    pthread_mutex_t lock; //!< Guards the queue shared with the worker
+    pthread_cond_t cond; //!< Signals new requests and created offspring
+    pthread_t thread; //!< Worker thread creating the offspring
 };
 
 void
 ea(struct XCSF *xcsf, const struct Set *set);
 
+void
+ea_async_flush(struct XCSF *xcsf);
+
+void
+ea_async_free(struct XCSF *xcsf);
+
+size_t
+ea_async_save(const struct XCSF *xcsf, FILE *fp);
+
+size_t
+ea_async_load(struct XCSF *xcsf, FILE *fp);
+
 void
 ea_param_defaults(struct XCSF *xcsf);
 
@@ -93,6 +150,9 @@ ea_param_set_subsumption(struct XCSF *xcsf, const bool a);
 void
 ea_param_set_pred_reset(struct XCSF *xcsf, const bool a);
 
+void
+ea_param_set_async(struct XCSF *xcsf, const bool a);
+
 void
 ea_param_set_select_type(struct XCSF *xcsf, const int a);
 
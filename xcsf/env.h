@@ -40,6 +40,7 @@ struct EnvVtbl {
     const double *(*env_impl_get_state)(const struct XCSF *xcsf);
     void (*env_impl_free)(const struct XCSF *xcsf);
     void (*env_impl_reset)(const struct XCSF *xcsf);
+    void *(*env_impl_copy)(const struct XCSF *xcsf);
 };
 
 /**
@@ -117,3 +118,16 @@ env_reset(const struct XCSF *xcsf)
 {
     (*xcsf->env_vptr->env_impl_reset)(xcsf);
 }
+
+/**
+ * @brief Creates an independent instance of the environment.
+ * @details The new instance is returned rather than assigned so that several
+ * instances may be stepped by swapping the XCSF environment pointer.
+ * @param [in] xcsf The XCSF data structure.
+ * @return A copy of the current environment.
+ */
+static inline void *
+env_copy(const struct XCSF *xcsf)
+{
+    return (*xcsf->env_vptr->env_impl_copy)(xcsf);
+}
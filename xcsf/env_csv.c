@@ -163,6 +163,7 @@ env_csv_init(struct XCSF *xcsf, const char *filename)
     env->train_data = malloc(sizeof(struct Input));
     env->test_data = malloc(sizeof(struct Input));
     env_csv_input_read(filename, env->train_data, env->test_data);
+    env->shared = false;
     xcsf->env = env;
     const int x_dim = env->train_data->x_dim;
     const int y_dim = env->train_data->y_dim;
@@ -177,15 +178,35 @@ void
 env_csv_free(const struct XCSF *xcsf)
 {
     struct EnvCSV *env = xcsf->env;
-    free(env->train_data->x);
-    free(env->train_data->y);
-    free(env->test_data->x);
-    free(env->test_data->y);
-    free(env->train_data);
-    free(env->test_data);
+    if (!env->shared) {
+        free(env->train_data->x);
+        free(env->train_data->y);
+        free(env->test_data->x);
+        free(env->test_data->y);
+        free(env->train_data);
+        free(env->test_data);
+    }
     free(env);
 }
 
+/**
+ * @brief Creates a new instance of the csv environment.
+ * @details The data are read-only and so are shared with the original
+ * instance, which must be freed last.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The new csv environment.
+ */
+void *
+env_csv_copy(const struct XCSF *xcsf)
+{
+    const struct EnvCSV *src = xcsf->env;
+    struct EnvCSV *env = malloc(sizeof(struct EnvCSV));
+    env->train_data = src->train_data;
+    env->test_data = src->test_data;
+    env->shared = true;
+    return env;
+}
+
 /**
  * @brief Dummy method since no csv environment reset is necessary.
  * @param [in] xcsf The XCSF data structure.
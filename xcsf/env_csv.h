@@ -32,6 +32,7 @@
 struct EnvCSV {
     struct Input *train_data;
     struct Input *test_data;
+    bool shared; //!< Whether the data is owned by another instance
 };
 
 bool
@@ -58,11 +59,14 @@ env_csv_init(struct XCSF *xcsf, const char *filename);
 void
 env_csv_reset(const struct XCSF *xcsf);
 
+void *
+env_csv_copy(const struct XCSF *xcsf);
+
 /**
  * @brief csv input environment implemented functions.
  */
 static struct EnvVtbl const env_csv_vtbl = {
     &env_csv_is_done,   &env_csv_multistep, &env_csv_execute,
     &env_csv_maxpayoff, &env_csv_get_state, &env_csv_free,
-    &env_csv_reset
+    &env_csv_reset,     &env_csv_copy
 };
@@ -151,6 +151,23 @@ env_maze_free(const struct XCSF *xcsf)
     free(env);
 }
 
+/**
+ * @brief Creates a new instance of the maze environment.
+ * @details The maze layout and current animat position are copied.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The new maze environment.
+ */
+void *
+env_maze_copy(const struct XCSF *xcsf)
+{
+    const struct EnvMaze *src = xcsf->env;
+    struct EnvMaze *env = malloc(sizeof(struct EnvMaze));
+    memcpy(env, src, sizeof(struct EnvMaze));
+    env->state = malloc(sizeof(double) * xcsf->x_dim);
+    memcpy(env->state, src->state, sizeof(double) * xcsf->x_dim);
+    return env;
+}
+
 /**
  * @brief Resets the animat to a random empty position in the maze.
  * @param [in] xcsf The XCSF data structure.
@@ -65,11 +65,14 @@ env_maze_init(struct XCSF *xcsf, const char *filename);
 void
 env_maze_reset(const struct XCSF *xcsf);
 
+void *
+env_maze_copy(const struct XCSF *xcsf);
+
 /**
  * @brief Maze environment implemented functions.
  */
 static struct EnvVtbl const env_maze_vtbl = {
     &env_maze_is_done,   &env_maze_multistep, &env_maze_execute,
     &env_maze_maxpayoff, &env_maze_get_state, &env_maze_free,
-    &env_maze_reset
+    &env_maze_reset,     &env_maze_copy
 };
@@ -67,6 +67,22 @@ env_mux_free(const struct XCSF *xcsf)
     free(env);
 }
 
+/**
+ * @brief Creates a new instance of the multiplexer environment.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The new multiplexer environment.
+ */
+void *
+env_mux_copy(const struct XCSF *xcsf)
+{
+    const struct EnvMux *src = xcsf->env;
+    struct EnvMux *env = malloc(sizeof(struct EnvMux));
+    env->pos_bits = src->pos_bits;
+    env->state = malloc(sizeof(double) * xcsf->x_dim);
+    memcpy(env->state, src->state, sizeof(double) * xcsf->x_dim);
+    return env;
+}
+
 /**
  * @brief Returns a random multiplexer problem instance.
  * @param [in] xcsf The XCSF data structure.
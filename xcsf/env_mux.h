@@ -58,11 +58,14 @@ env_mux_init(struct XCSF *xcsf, int bits);
 void
 env_mux_reset(const struct XCSF *xcsf);
 
+void *
+env_mux_copy(const struct XCSF *xcsf);
+
 /**
  * @brief Real multiplexer environment implemented functions.
  */
 static struct EnvVtbl const env_mux_vtbl = {
     &env_mux_is_done,   &env_mux_multistep, &env_mux_execute,
     &env_mux_maxpayoff, &env_mux_get_state, &env_mux_free,
-    &env_mux_reset
+    &env_mux_reset,     &env_mux_copy
 };
@@ -0,0 +1,610 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file frozen.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Memory-mappable frozen models for inference.
+ * @details A frozen model is a flat, relocatable copy of the population's
+ * fitnesses, actions, conditions and predictions that can be used for
+ * inference directly from a read-only memory mapping. Only hyperrectangle,
+ * hyperellipsoid, ternary and dummy conditions, constant, NLMS and RLS
+ * predictions, and integer actions (if there is more than one action) are
+ * supported. No covering is performed: predictions for inputs not matched by
+ * any classifier are zero.
+ */
+
+#include "frozen.h"
+#include "action.h"
+#include "blas.h"
+#include "cond_ellipsoid.h"
+#include "cond_rectangle.h"
+#include "cond_ternary.h"
+#include "condition.h"
+#include "pred_nlms.h"
+#include "pred_rls.h"
+#include "prediction.h"
+#include "utils.h"
+#include <limits.h>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @brief Returns an offset rounded up to the frozen model alignment.
+ * @param [in] offset The offset in bytes.
+ * @return The aligned offset.
+ */
+static uint64_t
+frozen_align(const uint64_t offset)
+{
+    return (offset + FROZEN_ALIGN - 1) / FROZEN_ALIGN * FROZEN_ALIGN;
+}
+
+/**
+ * @brief Returns whether a prediction type uses quadratic input terms.
+ * @param [in] type The prediction type.
+ * @return Whether the prediction is quadratic.
+ */
+static bool
+frozen_quadratic(const int type)
+{
+    return type == PRED_TYPE_NLMS_QUADRATIC || type == PRED_TYPE_RLS_QUADRATIC;
+}
+
+/**
+ * @brief Returns the number of condition elements per classifier.
+ * @param [in] type The condition type.
+ * @param [in] x_dim The number of feature variables.
+ * @param [in] bits The number of bits per float (ternary).
+ * @return The number of condition elements, or -1 if unsupported.
+ */
+static int64_t
+frozen_cond_elements(const int type, const int64_t x_dim, const int64_t bits)
+{
+    switch (type) {
+        case COND_TYPE_DUMMY:
+            return 0;
+        case COND_TYPE_HYPERRECTANGLE:
+        case COND_TYPE_HYPERELLIPSOID:
+            return 2 * x_dim;
+        case COND_TYPE_TERNARY:
+            return (bits > 0) ? x_dim * bits : -1;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief Returns the number of prediction elements per classifier.
+ * @param [in] type The prediction type.
+ * @param [in] x_dim The number of feature variables.
+ * @param [in] y_dim The number of target variables.
+ * @return The number of prediction elements, or -1 if unsupported.
+ */
+static int64_t
+frozen_pred_elements(const int type, const int64_t x_dim, const int64_t y_dim)
+{
+    switch (type) {
+        case PRED_TYPE_CONSTANT:
+            return y_dim;
+        case PRED_TYPE_NLMS_LINEAR:
+        case PRED_TYPE_RLS_LINEAR:
+            return (x_dim + 1) * y_dim;
+        case PRED_TYPE_NLMS_QUADRATIC:
+        case PRED_TYPE_RLS_QUADRATIC: {
+            const int64_t n = x_dim + 1 + x_dim * (x_dim + 1) / 2;
+            return (n <= INT32_MAX) ? n * y_dim : INT64_MAX;
+        }
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief Returns whether the population can be frozen.
+ * @param [in] xcsf The XCSF data structure.
+ * @return Whether the condition, prediction, and action types are supported.
+ */
+bool
+frozen_supported(const struct XCSF *xcsf)
+{
+    return frozen_cond_elements(xcsf->cond->type, xcsf->x_dim,
+                                xcsf->cond->bits) >= 0 &&
+        frozen_pred_elements(xcsf->pred->type, xcsf->x_dim, xcsf->y_dim) >= 0 &&
+        (xcsf->n_actions < 2 || xcsf->act->type == ACT_TYPE_INTEGER);
+}
+
+/**
+ * @brief Returns the number of condition elements per classifier.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The number of condition elements.
+ */
+static int
+frozen_cond_len(const struct XCSF *xcsf)
+{
+    const int64_t len =
+        frozen_cond_elements(xcsf->cond->type, xcsf->x_dim, xcsf->cond->bits);
+    if (len < 0) {
+        printf("frozen_init(): unsupported condition type: %s\n",
+               condition_type_as_string(xcsf->cond->type));
+        exit(EXIT_FAILURE);
+    }
+    return (int) len;
+}
+
+/**
+ * @brief Returns the number of prediction elements per classifier.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The number of prediction elements.
+ */
+static int
+frozen_pred_len(const struct XCSF *xcsf)
+{
+    const int64_t len =
+        frozen_pred_elements(xcsf->pred->type, xcsf->x_dim, xcsf->y_dim);
+    if (len < 0) {
+        printf("frozen_init(): unsupported prediction type: %s\n",
+               prediction_type_as_string(xcsf->pred->type));
+        exit(EXIT_FAILURE);
+    }
+    return (int) len;
+}
+
+/**
+ * @brief Copies a classifier's condition into the frozen model.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier to copy.
+ * @param [out] dest The destination of the condition parameters.
+ */
+static void
+frozen_copy_cond(const struct XCSF *xcsf, const struct Cl *c, char *dest)
+{
+    const size_t bytes = sizeof(double) * xcsf->x_dim;
+    switch (xcsf->cond->type) {
+        case COND_TYPE_HYPERRECTANGLE: {
+            const struct CondRectangle *cond = c->cond;
+            memcpy(dest, cond->center, bytes);
+            memcpy(dest + bytes, cond->spread, bytes);
+        } break;
+        case COND_TYPE_HYPERELLIPSOID: {
+            const struct CondEllipsoid *cond = c->cond;
+            memcpy(dest, cond->center, bytes);
+            memcpy(dest + bytes, cond->spread, bytes);
+        } break;
+        case COND_TYPE_TERNARY: {
+            const struct CondTernary *cond = c->cond;
+            memcpy(dest, cond->string, cond->length);
+        } break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Copies a classifier's prediction into the frozen model.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier to copy.
+ * @param [out] dest The destination of the prediction parameters.
+ * @param [in] len The number of prediction elements.
+ */
+static void
+frozen_copy_pred(const struct XCSF *xcsf, const struct Cl *c, double *dest,
+                 const int len)
+{
+    switch (xcsf->pred->type) {
+        case PRED_TYPE_CONSTANT:
+            memcpy(dest, c->prediction, sizeof(double) * len);
+            break;
+        case PRED_TYPE_NLMS_LINEAR:
+        case PRED_TYPE_NLMS_QUADRATIC: {
+            const struct PredNLMS *pred = c->pred;
+            memcpy(dest, pred->weights, sizeof(double) * len);
+        } break;
+        default: {
+            const struct PredRLS *pred = c->pred;
+            memcpy(dest, pred->weights, sizeof(double) * len);
+        } break;
+    }
+}
+
+/**
+ * @brief Sets the read-only views of a frozen model into its data.
+ * @param [in] frozen The frozen model data structure.
+ */
+static void
+frozen_views(struct Frozen *frozen)
+{
+    const char *data = frozen->data;
+    frozen->header = (const struct FrozenHeader *) data;
+    const struct FrozenHeader *h = frozen->header;
+    frozen->fit = (const double *) (data + h->offset_fit);
+    frozen->action = (const int32_t *) (data + h->offset_action);
+    frozen->cond = data + h->offset_cond;
+    frozen->pred = (const double *) (data + h->offset_pred);
+}
+
+/**
+ * @brief Creates a frozen model in memory from the current population.
+ * @details The model owns a heap copy of the data and must be released with
+ * frozen_close().
+ * @param [in] frozen The frozen model data structure.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+frozen_init(struct Frozen *frozen, const struct XCSF *xcsf)
+{
+    if (xcsf->n_actions > 1 && xcsf->act->type != ACT_TYPE_INTEGER) {
+        printf("frozen_init(): unsupported action type: %s\n",
+               action_type_as_string(xcsf->act->type));
+        exit(EXIT_FAILURE);
+    }
+    struct FrozenHeader h;
+    memset(&h, 0, sizeof(struct FrozenHeader));
+    memcpy(h.magic, FROZEN_MAGIC, sizeof(h.magic));
+    h.version = FROZEN_VERSION;
+    h.x_dim = xcsf->x_dim;
+    h.y_dim = xcsf->y_dim;
+    h.n_actions = xcsf->n_actions;
+    h.n_cl = xcsf->pset.size;
+    h.cond_type = xcsf->cond->type;
+    h.pred_type = xcsf->pred->type;
+    h.cond_len = frozen_cond_len(xcsf);
+    h.pred_len = frozen_pred_len(xcsf);
+    h.bits = xcsf->cond->bits;
+    h.x0 = xcsf->pred->x0;
+    const size_t cond_size =
+        (h.cond_type == COND_TYPE_TERNARY) ? sizeof(char) : sizeof(double);
+    const uint64_t n_cl = h.n_cl;
+    h.offset_fit = frozen_align(sizeof(struct FrozenHeader));
+    h.offset_action = frozen_align(h.offset_fit + n_cl * sizeof(double));
+    h.offset_cond = frozen_align(h.offset_action + n_cl * sizeof(int32_t));
+    h.offset_pred = frozen_align(h.offset_cond + n_cl * h.cond_len * cond_size);
+    h.size = frozen_align(h.offset_pred + n_cl * h.pred_len * sizeof(double));
+    char *data = calloc(h.size, 1);
+    memcpy(data, &h, sizeof(struct FrozenHeader));
+    double *fit = (double *) (data + h.offset_fit);
+    int32_t *action = (int32_t *) (data + h.offset_action);
+    char *cond = data + h.offset_cond;
+    double *pred = (double *) (data + h.offset_pred);
+    const struct Clist *iter = xcsf->pset.list;
+    for (int i = 0; iter != NULL; ++i, iter = iter->next) {
+        const struct Cl *c = iter->cl;
+        fit[i] = c->fit;
+        action[i] = c->action;
+        frozen_copy_cond(xcsf, c, &cond[i * h.cond_len * cond_size]);
+        frozen_copy_pred(xcsf, c, &pred[i * h.pred_len], h.pred_len);
+    }
+    frozen->data = data;
+    frozen->size = h.size;
+    frozen->mapped = false;
+    frozen_views(frozen);
+}
+
+/**
+ * @brief Writes the current population to a frozen model file.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] filename The name of the output file.
+ * @return The number of bytes written.
+ */
+size_t
+frozen_export(const struct XCSF *xcsf, const char *filename)
+{
+    struct Frozen frozen;
+    frozen_init(&frozen, xcsf);
+    FILE *fp = fopen(filename, "wb");
+    if (fp == 0) {
+        printf("Error saving file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    const size_t s = fwrite(frozen.data, 1, frozen.size, fp);
+    fclose(fp);
+    frozen_close(&frozen);
+    return s;
+}
+
+/**
+ * @brief Returns whether an array lies within a frozen model file.
+ * @param [in] h The frozen model header.
+ * @param [in] offset The offset of the array in bytes.
+ * @param [in] n The number of elements per classifier.
+ * @param [in] size The size of each element in bytes.
+ * @return Whether the array is aligned and within the file.
+ */
+static bool
+frozen_extent_valid(const struct FrozenHeader *h, const uint64_t offset,
+                    const uint64_t n, const uint64_t size)
+{
+    if (offset % FROZEN_ALIGN != 0 || offset < sizeof(struct FrozenHeader) ||
+        offset > h->size) {
+        return false;
+    }
+    const uint64_t bytes = n * size;
+    return bytes == 0 || (uint64_t) h->n_cl <= (h->size - offset) / bytes;
+}
+
+/**
+ * @brief Checks a frozen model file is valid.
+ * @details All dimensions, element counts and array extents are checked
+ * against the file size before the data is used, so that a truncated or
+ * corrupt file cannot cause out-of-bounds reads.
+ * @param [in] frozen The frozen model data structure.
+ * @param [in] filename The name of the file.
+ */
+static void
+frozen_validate(const struct Frozen *frozen, const char *filename)
+{
+    const struct FrozenHeader *h = frozen->header;
+    if (frozen->size < sizeof(struct FrozenHeader) ||
+        memcmp(h->magic, FROZEN_MAGIC, sizeof(h->magic)) != 0) {
+        printf("Error loading file: %s. Not a frozen model.\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    if (h->version != FROZEN_VERSION) {
+        printf("Error loading file: %s. Version mismatch. ", filename);
+        printf("This version: %d\n", FROZEN_VERSION);
+        printf("Loaded version: %d\n", h->version);
+        exit(EXIT_FAILURE);
+    }
+    const int64_t max = INT_MAX / FROZEN_BLOCK;
+    const int64_t cond_len =
+        frozen_cond_elements(h->cond_type, h->x_dim, h->bits);
+    const int64_t pred_len =
+        frozen_pred_elements(h->pred_type, h->x_dim, h->y_dim);
+    const size_t cond_size =
+        (h->cond_type == COND_TYPE_TERNARY) ? sizeof(char) : sizeof(double);
+    if (h->size != frozen->size || h->x_dim < 1 || h->y_dim < 1 ||
+        h->n_actions < 1 || h->n_cl < 0 ||
+        (int64_t) h->n_actions * h->y_dim > max || cond_len < 0 ||
+        cond_len > max || h->cond_len != cond_len || pred_len < 0 ||
+        pred_len > max || h->pred_len != pred_len ||
+        !frozen_extent_valid(h, h->offset_fit, 1, sizeof(double)) ||
+        !frozen_extent_valid(h, h->offset_action, 1, sizeof(int32_t)) ||
+        !frozen_extent_valid(h, h->offset_cond, cond_len, cond_size) ||
+        !frozen_extent_valid(h, h->offset_pred, pred_len, sizeof(double))) {
+        printf("Error loading file: %s. Corrupt frozen model.\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    const int32_t *action =
+        (const int32_t *) ((const char *) frozen->data + h->offset_action);
+    for (int i = 0; i < h->n_cl; ++i) {
+        if (action[i] < 0 || action[i] >= h->n_actions) {
+            printf("Error loading file: %s. Corrupt frozen model.\n",
+                   filename);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * @brief Opens a frozen model file for inference.
+ * @details The file is memory-mapped read-only so that it may be shared
+ * across processes via the page cache; on Windows it is read into memory.
+ * @param [in] frozen The frozen model data structure.
+ * @param [in] filename The name of the input file.
+ */
+void
+frozen_open(struct Frozen *frozen, const char *filename)
+{
+#ifdef _WIN32
+    FILE *fp = fopen(filename, "rb");
+    if (fp == 0) {
+        printf("Error loading file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    fseek(fp, 0, SEEK_END);
+    frozen->size = (size_t) ftell(fp);
+    rewind(fp);
+    frozen->data = malloc(frozen->size);
+    if (fread(frozen->data, 1, frozen->size, fp) != frozen->size) {
+        printf("Error loading file: %s. Failed to read.\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    fclose(fp);
+    frozen->mapped = false;
+#else
+    const int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        printf("Error loading file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    frozen->size = (size_t) st.st_size;
+    frozen->data = mmap(NULL, frozen->size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (frozen->data == MAP_FAILED) {
+        printf("Error loading file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    frozen->mapped = true;
+#endif
+    frozen->header = (const struct FrozenHeader *) frozen->data;
+    frozen_validate(frozen, filename);
+    frozen_views(frozen);
+}
+
+/**
+ * @brief Closes a frozen model.
+ * @param [in] frozen The frozen model data structure.
+ */
+void
+frozen_close(struct Frozen *frozen)
+{
+#ifndef _WIN32
+    if (frozen->mapped) {
+        munmap(frozen->data, frozen->size);
+    } else {
+        free(frozen->data);
+    }
+#else
+    free(frozen->data);
+#endif
+    frozen->data = NULL;
+    frozen->size = 0;
+}
+
+/**
+ * @brief Returns whether a frozen classifier matches an input.
+ * @param [in] frozen The frozen model data structure.
+ * @param [in] i The index of the classifier.
+ * @param [in] x The input feature variables.
+ * @param [in] binary The binarised input feature variables (ternary).
+ * @return Whether the classifier matches the input.
+ */
+static bool
+frozen_match(const struct Frozen *frozen, const int i, const double *x,
+             const char *binary)
+{
+    const struct FrozenHeader *h = frozen->header;
+    const int x_dim = h->x_dim;
+    switch (h->cond_type) {
+        case COND_TYPE_HYPERRECTANGLE: {
+            const double *center =
+                (const double *) frozen->cond + i * h->cond_len;
+            const double *spread = center + x_dim;
+            for (int j = 0; j < x_dim; ++j) {
+                if (fabs((x[j] - center[j]) / spread[j]) >= 1) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case COND_TYPE_HYPERELLIPSOID: {
+            const double *center =
+                (const double *) frozen->cond + i * h->cond_len;
+            const double *spread = center + x_dim;
+            double dist = 0;
+            for (int j = 0; j < x_dim; ++j) {
+                const double d = (x[j] - center[j]) / spread[j];
+                dist += d * d;
+            }
+            return dist < 1;
+        }
+        case COND_TYPE_TERNARY: {
+            const char *string = (const char *) frozen->cond + i * h->cond_len;
+            for (int j = 0; j < h->cond_len; ++j) {
+                if (string[j] != '#' && string[j] != binary[j]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Prepares the transformed input for computing linear predictions.
+ * @param [in] h The frozen model header.
+ * @param [in] x The input feature variables.
+ * @param [out] input The bias, linear, and (if quadratic) quadratic terms.
+ */
+static void
+frozen_transform_input(const struct FrozenHeader *h, const double *x,
+                       double *input)
+{
+    input[0] = h->x0;
+    int idx = 1;
+    for (int i = 0; i < h->x_dim; ++i) {
+        input[idx] = x[i];
+        ++idx;
+    }
+    if (frozen_quadratic(h->pred_type)) {
+        for (int i = 0; i < h->x_dim; ++i) {
+            for (int j = i; j < h->x_dim; ++j) {
+                input[idx] = x[i] * x[j];
+                ++idx;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Calculates the frozen model predictions for the provided input.
+ * @details Computes the matching classifiers' fitness weighted prediction for
+ * each action; the output has n_actions * y_dim values per sample. Samples are
+ * processed in blocks of FROZEN_BLOCK so that each classifier's parameters are
+ * loaded once per block rather than once per sample.
+ * @param [in] frozen The frozen model data structure.
+ * @param [in] x The input feature variables.
+ * @param [out] pred The calculated predictions.
+ * @param [in] n_samples The number of instances.
+ */
+void
+frozen_predict(const struct Frozen *frozen, const double *x, double *pred,
+               const int n_samples)
+{
+    const struct FrozenHeader *h = frozen->header;
+    const int y_dim = h->y_dim;
+    const int pa_size = h->n_actions * y_dim;
+    const int n = h->pred_len / y_dim;
+    const int n_bits = (h->cond_type == COND_TYPE_TERNARY) ? h->cond_len : 0;
+    const bool linear = (h->pred_type != PRED_TYPE_CONSTANT);
+    double *nr = malloc(sizeof(double) * FROZEN_BLOCK * pa_size);
+    double *input = malloc(sizeof(double) * FROZEN_BLOCK * n);
+    char *binary = malloc(sizeof(char) * (FROZEN_BLOCK * n_bits + 1));
+    for (int start = 0; start < n_samples; start += FROZEN_BLOCK) {
+        const int rows = clamp_int(n_samples - start, 0, FROZEN_BLOCK);
+        const double *xb = &x[start * h->x_dim];
+        double *pb = &pred[start * pa_size];
+        memset(pb, 0, sizeof(double) * rows * pa_size);
+        memset(nr, 0, sizeof(double) * rows * pa_size);
+        for (int r = 0; r < rows; ++r) {
+            const double *xr = &xb[r * h->x_dim];
+            if (h->cond_type == COND_TYPE_TERNARY) {
+                for (int j = 0; j < h->x_dim; ++j) {
+                    float_to_binary(xr[j], &binary[r * n_bits + j * h->bits],
+                                    h->bits);
+                }
+            }
+            if (linear) {
+                frozen_transform_input(h, xr, &input[r * n]);
+            }
+        }
+        for (int i = 0; i < h->n_cl; ++i) {
+            const double *p = &frozen->pred[i * h->pred_len];
+            const double fitness = frozen->fit[i];
+            const int offset = frozen->action[i] * y_dim;
+            for (int r = 0; r < rows; ++r) {
+                if (!frozen_match(frozen, i, &xb[r * h->x_dim],
+                                  &binary[r * n_bits])) {
+                    continue;
+                }
+                const double *in = &input[r * n];
+                double *pa = &pb[r * pa_size + offset];
+                double *nra = &nr[r * pa_size + offset];
+                for (int j = 0; j < y_dim; ++j) {
+                    const double value =
+                        linear ? blas_dot(n, &p[j * n], 1, in, 1) : p[j];
+                    pa[j] += value * fitness;
+                    nra[j] += fitness;
+                }
+            }
+        }
+        for (int k = 0; k < rows * pa_size; ++k) {
+            pb[k] = (nr[k] != 0) ? pb[k] / nr[k] : 0;
+        }
+    }
+    free(nr);
+    free(input);
+    free(binary);
+}
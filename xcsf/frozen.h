@@ -0,0 +1,92 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file frozen.h
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Memory-mappable frozen models for inference.
+ */
+
+#pragma once
+
+#include "xcsf.h"
+
+#define FROZEN_VERSION (1) //!< Frozen model file format version
+#define FROZEN_ALIGN (64) //!< Byte alignment of the frozen model arrays
+#define FROZEN_BLOCK (32) //!< Number of samples predicted per block
+
+static const char FROZEN_MAGIC[8] = "XCSFFRZ"; //!< Frozen model file magic
+
+/**
+ * @brief Frozen model file header.
+ * @details All offsets are in bytes from the start of the file and aligned to
+ * FROZEN_ALIGN bytes. Per-classifier arrays are stored contiguously: fitness
+ * (double), action (int32), condition and prediction parameters.
+ */
+struct FrozenHeader {
+    char magic[8]; //!< File magic: FROZEN_MAGIC
+    int32_t version; //!< File format version
+    int32_t x_dim; //!< Number of feature variables
+    int32_t y_dim; //!< Number of target variables
+    int32_t n_actions; //!< Number of actions
+    int32_t n_cl; //!< Number of classifiers
+    int32_t cond_type; //!< Condition type
+    int32_t pred_type; //!< Prediction type
+    int32_t cond_len; //!< Number of condition elements per classifier
+    int32_t pred_len; //!< Number of prediction elements per classifier
+    int32_t bits; //!< Bits per float to binarise inputs (ternary)
+    double x0; //!< Prediction weight vector offset value
+    uint64_t offset_fit; //!< Offset of the classifier fitnesses
+    uint64_t offset_action; //!< Offset of the classifier actions
+    uint64_t offset_cond; //!< Offset of the classifier conditions
+    uint64_t offset_pred; //!< Offset of the classifier predictions
+    uint64_t size; //!< Total size of the file
+};
+
+/**
+ * @brief Frozen model data structure; read-only views into the file or an
+ * in-memory copy.
+ */
+struct Frozen {
+    const struct FrozenHeader *header; //!< File header
+    const double *fit; //!< Classifier fitnesses
+    const int32_t *action; //!< Classifier actions
+    const void *cond; //!< Classifier condition parameters
+    const double *pred; //!< Classifier prediction parameters
+    void *data; //!< Start of the mapped or read file
+    size_t size; //!< Size of the mapped or read file
+    bool mapped; //!< Whether the file is memory-mapped
+};
+
+size_t
+frozen_export(const struct XCSF *xcsf, const char *filename);
+
+void
+frozen_close(struct Frozen *frozen);
+
+void
+frozen_init(struct Frozen *frozen, const struct XCSF *xcsf);
+
+void
+frozen_open(struct Frozen *frozen, const char *filename);
+
+bool
+frozen_supported(const struct XCSF *xcsf);
+
+void
+frozen_predict(const struct Frozen *frozen, const double *x, double *pred,
+               const int n_samples);
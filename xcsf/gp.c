@@ -33,8 +33,6 @@
 #define DIV (3) //!< Division function
 
 #define N_MU (1) //!< Number of tree-GP mutation rates
-#define RET_MIN (-1000) //!< Minimum tree return value
-#define RET_MAX (1000) //!< Maximum tree return value
 
 /**
  * @brief Self-adaptation method for mutating GP trees.
@@ -117,6 +115,17 @@ tree_free(const struct GPTree *gp)
     free(gp->mu);
 }
 
+/**
+ * @brief Returns the number of bytes of memory allocated for a GP tree.
+ * @param [in] gp The GP tree.
+ * @return The memory size in bytes, excluding the tree structure itself.
+ */
+size_t
+tree_mem_size(const struct GPTree *gp)
+{
+    return sizeof(int) * gp->len + sizeof(double) * N_MU;
+}
+
 /**
  * @brief Evaluates a GP tree.
  * @param [in] gp The GP tree to evaluate.
@@ -197,6 +206,64 @@ tree_print(const struct GPTree *gp, const struct ArgsGPTree *args, int pos)
     return a2;
 }
 
+/**
+ * @brief Writes a GP tree as straight-line C code.
+ * @details Each node is assigned to a local variable t<n>, with the root last.
+ * As in tree_eval(), function operands are clamped by xcsf_clamp() to the
+ * range [RET_MIN, RET_MAX] and xcsf_div() returns the numerator when dividing
+ * by zero; both must be defined by the caller.
+ * @param [in] gp The GP tree to write.
+ * @param [in] args Tree GP parameters.
+ * @param [in] fp Pointer to the output file.
+ * @param [in] pos The position from which to traverse (start at 0).
+ * @param [in,out] n_vars The number of variables written.
+ * @return The position after traversal.
+ */
+int
+tree_codegen(const struct GPTree *gp, const struct ArgsGPTree *args, FILE *fp,
+             int pos, int *n_vars)
+{
+    const int node = gp->tree[pos];
+    ++pos;
+    if (node >= GP_NUM_FUNC + args->n_constants) {
+        fprintf(fp, "    const double t%d = x[%d];\n", *n_vars,
+                node - GP_NUM_FUNC - args->n_constants);
+        ++(*n_vars);
+        return pos;
+    }
+    if (node >= GP_NUM_FUNC) {
+        fprintf(fp, "    const double t%d = %.17g;\n", *n_vars,
+                args->constants[node - GP_NUM_FUNC]);
+        ++(*n_vars);
+        return pos;
+    }
+    pos = tree_codegen(gp, args, fp, pos, n_vars);
+    const int a = *n_vars - 1;
+    pos = tree_codegen(gp, args, fp, pos, n_vars);
+    const int b = *n_vars - 1;
+    fprintf(fp, "    const double t%d = ", *n_vars);
+    switch (node) {
+        case ADD:
+            fprintf(fp, "xcsf_clamp(t%d) + xcsf_clamp(t%d);\n", a, b);
+            break;
+        case SUB:
+            fprintf(fp, "xcsf_clamp(t%d) - xcsf_clamp(t%d);\n", a, b);
+            break;
+        case MUL:
+            fprintf(fp, "xcsf_clamp(t%d) * xcsf_clamp(t%d);\n", a, b);
+            break;
+        case DIV:
+            fprintf(fp, "xcsf_div(xcsf_clamp(t%d), xcsf_clamp(t%d));\n", a,
+                    b);
+            break;
+        default:
+            printf("tree_codegen() invalid function: %d\n", node);
+            exit(EXIT_FAILURE);
+    }
+    ++(*n_vars);
+    return pos;
+}
+
 /**
  * @brief Copies a GP tree.
  * @param [in] dest The destination GP tree.
@@ -313,6 +380,7 @@ tree_load(struct GPTree *gp, FILE *fp)
     }
     gp->tree = malloc(sizeof(int) * gp->len);
     s += fread(gp->tree, sizeof(int), gp->len, fp);
+    gp->mu = malloc(sizeof(double) * N_MU);
     s += fread(gp->mu, sizeof(double), N_MU, fp);
     return s;
 }
@@ -25,6 +25,9 @@
 
 #include "xcsf.h"
 
+#define RET_MIN (-1000) //!< Minimum tree return value
+#define RET_MAX (1000) //!< Maximum tree return value
+
 /**
  * @brief Parameters for initialising GP trees.
  */
@@ -60,6 +63,10 @@ tree_copy(struct GPTree *dest, const struct GPTree *src);
 int
 tree_print(const struct GPTree *gp, const struct ArgsGPTree *args, int pos);
 
+int
+tree_codegen(const struct GPTree *gp, const struct ArgsGPTree *args, FILE *fp,
+             int pos, int *n_vars);
+
 double
 tree_eval(struct GPTree *gp, const struct ArgsGPTree *args, const double *x);
 
@@ -75,6 +82,9 @@ tree_save(const struct GPTree *gp, FILE *fp);
 size_t
 tree_load(struct GPTree *gp, FILE *fp);
 
+size_t
+tree_mem_size(const struct GPTree *gp);
+
 void
 tree_args_init(struct ArgsGPTree *args);
 
@@ -0,0 +1,253 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file island.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Island model of multiple populations trained in parallel.
+ * @details Each island is created from a serialised copy of the parent XCSF
+ * and is seeded with its own random number generator stream drawn from the
+ * parent's, so that the results do not depend on the thread scheduling.
+ */
+
+#include "island.h"
+#include "cl.h"
+#include "clset.h"
+#include "ea.h"
+#include "pa.h"
+#include "param.h"
+#include "prof.h"
+#include "utils.h"
+#include <limits.h>
+
+/**
+ * @brief Compares the fitness of two classifiers for sorting.
+ * @param [in] a Pointer to the first classifier pointer.
+ * @param [in] b Pointer to the second classifier pointer.
+ * @return Negative if the first classifier is fitter, positive if less fit.
+ */
+static int
+island_cmp_fit(const void *a, const void *b)
+{
+    const double fa = (*(const struct Cl *const *) a)->fit;
+    const double fb = (*(const struct Cl *const *) b)->fit;
+    return (fa < fb) - (fa > fb);
+}
+
+/**
+ * @brief Copies the fittest classifiers of an island.
+ * @details Each emigrant is a single micro-classifier with its fitness scaled
+ * accordingly.
+ * @param [in] xcsf The XCSF data structure of the island.
+ * @param [out] set The set to contain the emigrants.
+ */
+static void
+island_emigrants(const struct XCSF *xcsf, struct Set *set)
+{
+    clset_init(set);
+    const int size = xcsf->pset.size;
+    const int n = (xcsf->MIGRATION_SIZE < size) ? xcsf->MIGRATION_SIZE : size;
+    if (n < 1) {
+        return;
+    }
+    const struct Cl **cls = malloc(sizeof(struct Cl *) * size);
+    const struct Clist *iter = xcsf->pset.list;
+    for (int i = 0; i < size; ++i) {
+        cls[i] = iter->cl;
+        iter = iter->next;
+    }
+    qsort(cls, size, sizeof(struct Cl *), island_cmp_fit);
+    for (int i = 0; i < n; ++i) {
+        struct Cl *new = malloc(sizeof(struct Cl));
+        cl_init_copy(xcsf, new, cls[i]);
+        new->fit /= new->num;
+        new->num = 1;
+        clset_add(set, new);
+    }
+    free(cls);
+}
+
+/**
+ * @brief Creates the islands from a copy of XCSF.
+ * @details Every island starts with a copy of the parameters and population;
+ * tracing and hardware counters are disabled within the islands.
+ * @param [in] xcsf The XCSF data structure to copy.
+ * @param [out] isl The islands to create.
+ */
+void
+island_init(const struct XCSF *xcsf, struct Islands *isl)
+{
+    char *buf = NULL;
+    size_t len = 0;
+    xcsf_serialise(xcsf, &buf, &len);
+    const size_t state_size = rand_state_size();
+    isl->n = xcsf->ISLANDS;
+    isl->xcsf = malloc(sizeof(struct XCSF) * isl->n);
+    isl->rand_state = malloc(state_size * isl->n);
+    unsigned char *state = malloc(state_size);
+    uint32_t *seed = malloc(sizeof(uint32_t) * isl->n);
+    for (int i = 0; i < isl->n; ++i) {
+        seed[i] = (uint32_t) rand_uniform_int(0, INT_MAX);
+    }
+    rand_state_get(state);
+    for (int i = 0; i < isl->n; ++i) {
+        struct XCSF *x = &isl->xcsf[i];
+        param_init(x, 1, 1, 1);
+        xcsf_init(x);
+        xcsf_deserialise(x, buf, len);
+        pa_init(x);
+        param_set_islands(x, 1);
+        param_set_profile_hw(x, false);
+        param_set_trace_size(x, 0);
+        x->time = xcsf->time;
+        x->error = xcsf->error;
+        x->mset_size = xcsf->mset_size;
+        x->aset_size = xcsf->aset_size;
+        x->mfrac = xcsf->mfrac;
+        rand_init_seed(seed[i]);
+        rand_state_get(&isl->rand_state[i * state_size]);
+    }
+    rand_state_set(state);
+    free(seed);
+    free(state);
+    free(buf);
+}
+
+/**
+ * @brief Sends copies of the fittest classifiers of each island to the next.
+ * @details The emigrants of all islands are selected before any immigrants
+ * are inserted, after which the population limits are enforced using the
+ * random number stream of the receiving island.
+ * @param [in] isl The islands.
+ */
+void
+island_migrate(struct Islands *isl)
+{
+    if (isl->n < 2) {
+        return;
+    }
+    unsigned char *state = malloc(rand_state_size());
+    rand_state_get(state);
+    struct Set *migrants = malloc(sizeof(struct Set) * isl->n);
+    for (int i = 0; i < isl->n; ++i) {
+        island_emigrants(&isl->xcsf[i], &migrants[i]);
+    }
+    for (int i = 0; i < isl->n; ++i) {
+        const int j = (i + 1) % isl->n;
+        struct XCSF *dest = &isl->xcsf[j];
+        const struct Clist *iter = migrants[i].list;
+        while (iter != NULL) {
+            clset_pset_add(dest, iter->cl);
+            iter = iter->next;
+        }
+        clset_free(&migrants[i]);
+        island_rand_enter(isl, j);
+        clset_init(&dest->kset);
+        clset_pset_enforce_limit(dest);
+        clset_kill(dest, &dest->kset);
+        island_rand_leave(isl, j);
+    }
+    rand_state_set(state);
+    free(migrants);
+    free(state);
+}
+
+/**
+ * @brief Returns the total number of macro-classifiers on all islands.
+ * @param [in] isl The islands.
+ * @return The number of macro-classifiers.
+ */
+int
+island_pset_size(const struct Islands *isl)
+{
+    int size = 0;
+    for (int i = 0; i < isl->n; ++i) {
+        size += isl->xcsf[i].pset.size;
+    }
+    return size;
+}
+
+/**
+ * @brief Moves the populations of all islands into XCSF and frees the islands.
+ * @details The previous population of XCSF is replaced with the union of the
+ * island populations with fitnesses divided by the number of islands. Copies
+ * of the same rule held by several islands, such as migrants, are combined
+ * and the population size limit is enforced with xcsf_merge_reduce(). The
+ * averaged island statistics and the summed timers and counters are also
+ * copied.
+ * @param [in] xcsf The XCSF data structure to receive the populations.
+ * @param [in] isl The islands to merge.
+ */
+void
+island_merge(struct XCSF *xcsf, struct Islands *isl)
+{
+    clset_kill(xcsf, &xcsf->pset);
+    clset_init(&xcsf->pset);
+    xcsf->time = isl->xcsf[0].time;
+    xcsf->error = 0;
+    xcsf->mset_size = 0;
+    xcsf->aset_size = 0;
+    xcsf->mfrac = 0;
+    for (int i = 0; i < isl->n; ++i) {
+        struct XCSF *x = &isl->xcsf[i];
+        ea_async_flush(x);
+        const struct Clist *iter = x->pset.list;
+        while (iter != NULL) {
+            iter->cl->fit /= isl->n;
+            clset_add(&xcsf->pset, iter->cl);
+            iter = iter->next;
+        }
+        clset_free(&x->pset);
+        xcsf->error += x->error / isl->n;
+        xcsf->mset_size += x->mset_size / isl->n;
+        xcsf->aset_size += x->aset_size / isl->n;
+        xcsf->mfrac += x->mfrac / isl->n;
+        prof_add(xcsf, x);
+        pa_free(x);
+        xcsf_free(x);
+        param_free(x);
+    }
+    free(isl->xcsf);
+    free(isl->rand_state);
+    xcsf_merge_reduce(xcsf);
+    isl->xcsf = NULL;
+    isl->rand_state = NULL;
+    isl->n = 0;
+}
+
+/**
+ * @brief Switches the calling thread to the random number stream of an island.
+ * @param [in] isl The islands.
+ * @param [in] i The island about to be run by the calling thread.
+ */
+void
+island_rand_enter(const struct Islands *isl, const int i)
+{
+    rand_state_set(&isl->rand_state[i * rand_state_size()]);
+}
+
+/**
+ * @brief Saves the random number stream of an island run by the calling
+ * thread.
+ * @param [in] isl The islands.
+ * @param [in] i The island that has been run by the calling thread.
+ */
+void
+island_rand_leave(const struct Islands *isl, const int i)
+{
+    rand_state_get(&isl->rand_state[i * rand_state_size()]);
+}
@@ -0,0 +1,56 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file island.h
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Island model of multiple populations trained in parallel.
+ */
+
+#pragma once
+
+#include "xcsf.h"
+
+/**
+ * @brief Island model data structure.
+ * @details Each island is an independent copy of XCSF with its own parameters,
+ * population, and random number generator stream. Islands periodically send
+ * copies of their fittest classifiers to the next island in a ring.
+ */
+struct Islands {
+    struct XCSF *xcsf; //!< The XCSF data structure of each island
+    unsigned char *rand_state; //!< Generator state of each island
+    int n; //!< Number of islands
+};
+
+int
+island_pset_size(const struct Islands *isl);
+
+void
+island_init(const struct XCSF *xcsf, struct Islands *isl);
+
+void
+island_merge(struct XCSF *xcsf, struct Islands *isl);
+
+void
+island_migrate(struct Islands *isl);
+
+void
+island_rand_enter(const struct Islands *isl, const int i);
+
+void
+island_rand_leave(const struct Islands *isl, const int i);
@@ -21,22 +21,57 @@
  * @brief Main function for stand-alone binary execution.
  */
 
+#include "checkpoint.h"
 #include "clset.h"
 #include "config.h"
 #include "env_csv.h"
 #include "pa.h"
 #include "param.h"
+#include "prof.h"
+#include "serve.h"
 #include "utils.h"
 #include "xcs_rl.h"
 #include "xcs_supervised.h"
 #include "xcsf.h"
 
+/**
+ * @brief Serves predictions from a saved or frozen model until terminated.
+ * @details Requests are answered on stdin/stdout if no socket path, or "-",
+ * is given.
+ * @param [in] argc The number of arguments.
+ * @param [in] argv serve model.bin [socket|-] [threads]
+ * @return The exit status.
+ */
+static int
+main_serve(int argc, char **argv)
+{
+    const int n_threads = (argc > 4) ? atoi(argv[4]) : SERVE_THREADS;
+    if (argc > 5 || n_threads < 1) {
+        printf("Usage: xcsf serve model.bin [socket|-] [threads]\n");
+        exit(EXIT_FAILURE);
+    }
+    rand_init();
+    struct Frozen frozen;
+    serve_load(&frozen, argv[2]);
+    if (argc > 3 && strcmp(argv[3], "-") != 0) {
+        serve_socket(&frozen, argv[3], n_threads);
+    } else {
+        serve_stdio(&frozen, n_threads);
+    }
+    frozen_close(&frozen);
+    return EXIT_SUCCESS;
+}
+
 int
 main(int argc, char **argv)
 {
+    if (argc > 2 && strcmp(argv[1], "serve") == 0) {
+        return main_serve(argc, argv);
+    }
     if (argc < 3 || argc > 5) {
         printf("Usage: xcsf problemType{csv|mp|maze} ");
         printf("problem{.csv|size|maze} [config.ini] [xcs.bin]\n");
+        printf("       xcsf serve model.bin [socket|-] [threads]\n");
         exit(EXIT_FAILURE);
     }
     struct XCSF *xcsf = malloc(sizeof(struct XCSF));
@@ -48,12 +83,17 @@ main(int argc, char **argv)
         config_read(xcsf, "default.ini");
     }
     xcsf_init(xcsf); // initialise empty sets
-    if (argc == 5) { // reload state of a previous experiment
-        const size_t s = xcsf_load(xcsf, argv[4]);
+    if (argc == 5) { // reload state or resume checkpoint of an experiment
+        const int max_trials = xcsf->MAX_TRIALS; // as configured
+        const size_t s = checkpoint_load(xcsf, argv[4]);
+        param_set_max_trials(xcsf, max_trials);
         printf("XCSF loaded: %d elements\n", (int) s);
     } else { // new experiment
         clset_pset_init(xcsf);
     }
+    if (xcsf->CHECKPOINT_TRIALS > 0) { // periodically checkpoint
+        checkpoint_init(xcsf, CHECKPOINT_FILENAME);
+    }
     pa_init(xcsf); // initialise prediction array
     param_print(xcsf); // print parameters used
     if (strcmp(argv[1], "csv") == 0) { // supervised regression - csv file
@@ -62,6 +102,12 @@ main(int argc, char **argv)
     } else { // reinforcement learning - maze or mux
         xcs_rl_exp(xcsf);
     }
+    if (xcsf->PROFILE) { // print per-phase timers and event counters
+        prof_print(xcsf);
+    }
+    if (xcsf->TRACE_SIZE > 0) { // save the most recent trace spans
+        prof_trace_save(xcsf, TRACE_FILENAME);
+    }
     pa_free(xcsf); // clean up
     env_free(xcsf);
     xcsf_free(xcsf);
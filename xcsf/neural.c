@@ -233,6 +233,23 @@ neural_free(struct Net *net)
     }
 }
 
+/**
+ * @brief Returns the number of bytes of memory allocated for a network.
+ * @param [in] net The neural network.
+ * @return The memory size in bytes, excluding the network structure itself.
+ */
+size_t
+neural_mem_size(const struct Net *net)
+{
+    size_t size = 0;
+    const struct Llist *iter = net->tail;
+    while (iter != NULL) {
+        size += sizeof(struct Llist) + layer_mem_size(iter->layer);
+        iter = iter->prev;
+    }
+    return size;
+}
+
 /**
  * @brief Randomises the layers within a neural network.
  * @param [in] net The neural network to randomise.
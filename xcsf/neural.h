@@ -72,6 +72,9 @@ neural_load(struct Net *net, FILE *fp);
 size_t
 neural_save(const struct Net *net, FILE *fp);
 
+size_t
+neural_mem_size(const struct Net *net);
+
 void
 neural_copy(struct Net *dest, const struct Net *src);
 
@@ -156,8 +156,20 @@ struct LayerVtbl {
     double *(*layer_impl_output)(const struct Layer *l);
     size_t (*layer_impl_save)(const struct Layer *l, FILE *fp);
     size_t (*layer_impl_load)(struct Layer *l, FILE *fp);
+    size_t (*layer_impl_mem_size)(const struct Layer *l);
 };
 
+/**
+ * @brief Returns the number of bytes of memory allocated for a layer.
+ * @param [in] l The layer.
+ * @return The memory size in bytes, including any sublayers.
+ */
+static inline size_t
+layer_mem_size(const struct Layer *l)
+{
+    return (*l->layer_vptr->layer_impl_mem_size)(l);
+}
+
 /**
  * @brief Writes the layer to a file.
  * @param [in] l The layer to be written.
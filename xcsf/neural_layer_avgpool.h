@@ -63,6 +63,9 @@ neural_layer_avgpool_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_avgpool_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_avgpool_mem_size(const struct Layer *l);
+
 void
 neural_layer_avgpool_resize(struct Layer *l, const struct Layer *prev);
 
@@ -76,5 +79,5 @@ static struct LayerVtbl const layer_avgpool_vtbl = {
     &neural_layer_avgpool_print,    &neural_layer_avgpool_update,
     &neural_layer_avgpool_backward, &neural_layer_avgpool_forward,
     &neural_layer_avgpool_output,   &neural_layer_avgpool_save,
-    &neural_layer_avgpool_load
+    &neural_layer_avgpool_load,     &neural_layer_avgpool_mem_size
 };
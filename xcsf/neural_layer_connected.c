@@ -413,3 +413,16 @@ neural_layer_connected_load(struct Layer *l, FILE *fp)
     s += fread(l->mu, sizeof(double), N_MU, fp);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a connected layer.
+ * @param [in] l The layer.
+ * @return The memory size in bytes.
+ */
+size_t
+neural_layer_connected_mem_size(const struct Layer *l)
+{
+    return sizeof(struct Layer) + sizeof(double) * N_MU +
+        sizeof(double) * (3 * l->n_outputs + 2 * l->n_biases) +
+        (2 * sizeof(double) + sizeof(bool)) * l->n_weights;
+}
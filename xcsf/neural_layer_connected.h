@@ -63,6 +63,9 @@ neural_layer_connected_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_connected_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_connected_mem_size(const struct Layer *l);
+
 void
 neural_layer_connected_resize(struct Layer *l, const struct Layer *prev);
 
@@ -76,5 +79,5 @@ static struct LayerVtbl const layer_connected_vtbl = {
     &neural_layer_connected_print,    &neural_layer_connected_update,
     &neural_layer_connected_backward, &neural_layer_connected_forward,
     &neural_layer_connected_output,   &neural_layer_connected_save,
-    &neural_layer_connected_load,
+    &neural_layer_connected_load,     &neural_layer_connected_mem_size,
 };
@@ -590,3 +590,17 @@ neural_layer_convolutional_load(struct Layer *l, FILE *fp)
     s += fread(l->mu, sizeof(double), N_MU, fp);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a convolutional layer.
+ * @param [in] l The layer.
+ * @return The memory size in bytes.
+ */
+size_t
+neural_layer_convolutional_mem_size(const struct Layer *l)
+{
+    return sizeof(struct Layer) + sizeof(double) * N_MU +
+        sizeof(double) * (3 * l->n_outputs + 2 * l->n_biases) +
+        (2 * sizeof(double) + sizeof(bool)) * l->n_weights +
+        get_workspace_size(l);
+}
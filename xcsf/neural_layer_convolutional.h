@@ -65,6 +65,9 @@ neural_layer_convolutional_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_convolutional_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_convolutional_mem_size(const struct Layer *l);
+
 void
 neural_layer_convolutional_resize(struct Layer *l, const struct Layer *prev);
 
@@ -78,5 +81,5 @@ static struct LayerVtbl const layer_convolutional_vtbl = {
     &neural_layer_convolutional_print,    &neural_layer_convolutional_update,
     &neural_layer_convolutional_backward, &neural_layer_convolutional_forward,
     &neural_layer_convolutional_output,   &neural_layer_convolutional_save,
-    &neural_layer_convolutional_load,
+    &neural_layer_convolutional_load,     &neural_layer_convolutional_mem_size,
 };
@@ -63,6 +63,9 @@ neural_layer_dropout_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_dropout_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_dropout_mem_size(const struct Layer *l);
+
 void
 neural_layer_dropout_resize(struct Layer *l, const struct Layer *prev);
 
@@ -76,5 +79,5 @@ static struct LayerVtbl const layer_dropout_vtbl = {
     &neural_layer_dropout_print,    &neural_layer_dropout_update,
     &neural_layer_dropout_backward, &neural_layer_dropout_forward,
     &neural_layer_dropout_output,   &neural_layer_dropout_save,
-    &neural_layer_dropout_load
+    &neural_layer_dropout_load,     &neural_layer_dropout_mem_size
 };
@@ -694,3 +694,18 @@ neural_layer_lstm_load(struct Layer *l, FILE *fp)
     s += layer_load(l->wo, fp);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of an LSTM layer.
+ * @param [in] l The layer.
+ * @return The memory size in bytes.
+ */
+size_t
+neural_layer_lstm_mem_size(const struct Layer *l)
+{
+    return sizeof(struct Layer) + sizeof(double) * N_MU +
+        sizeof(double) * 16 * l->n_outputs + layer_mem_size(l->uf) +
+        layer_mem_size(l->ui) + layer_mem_size(l->ug) + layer_mem_size(l->uo) +
+        layer_mem_size(l->wf) + layer_mem_size(l->wi) + layer_mem_size(l->wg) +
+        layer_mem_size(l->wo);
+}
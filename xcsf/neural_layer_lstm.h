@@ -63,6 +63,9 @@ neural_layer_lstm_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_lstm_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_lstm_mem_size(const struct Layer *l);
+
 void
 neural_layer_lstm_resize(struct Layer *l, const struct Layer *prev);
 
@@ -76,5 +79,5 @@ static struct LayerVtbl const layer_lstm_vtbl = {
     &neural_layer_lstm_print,    &neural_layer_lstm_update,
     &neural_layer_lstm_backward, &neural_layer_lstm_forward,
     &neural_layer_lstm_output,   &neural_layer_lstm_save,
-    &neural_layer_lstm_load,
+    &neural_layer_lstm_load,     &neural_layer_lstm_mem_size,
 };
@@ -333,3 +333,15 @@ neural_layer_maxpool_load(struct Layer *l, FILE *fp)
     malloc_layer_arrays(l);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a maxpooling layer.
+ * @param [in] l The layer.
+ * @return The memory size in bytes.
+ */
+size_t
+neural_layer_maxpool_mem_size(const struct Layer *l)
+{
+    return sizeof(struct Layer) +
+        (sizeof(int) + 2 * sizeof(double)) * l->n_outputs;
+}
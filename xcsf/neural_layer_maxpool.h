@@ -63,6 +63,9 @@ neural_layer_maxpool_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_maxpool_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_maxpool_mem_size(const struct Layer *l);
+
 void
 neural_layer_maxpool_resize(struct Layer *l, const struct Layer *prev);
 
@@ -76,5 +79,5 @@ static struct LayerVtbl const layer_maxpool_vtbl = {
     &neural_layer_maxpool_print,    &neural_layer_maxpool_update,
     &neural_layer_maxpool_backward, &neural_layer_maxpool_forward,
     &neural_layer_maxpool_output,   &neural_layer_maxpool_save,
-    &neural_layer_maxpool_load
+    &neural_layer_maxpool_load,     &neural_layer_maxpool_mem_size
 };
@@ -269,3 +269,14 @@ neural_layer_noise_load(struct Layer *l, FILE *fp)
     malloc_layer_arrays(l);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a noise layer.
+ * @param [in] l The layer.
+ * @return The memory size in bytes.
+ */
+size_t
+neural_layer_noise_mem_size(const struct Layer *l)
+{
+    return sizeof(struct Layer) + sizeof(double) * 3 * l->n_outputs;
+}
@@ -63,6 +63,9 @@ neural_layer_noise_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_noise_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_noise_mem_size(const struct Layer *l);
+
 void
 neural_layer_noise_resize(struct Layer *l, const struct Layer *prev);
 
@@ -76,5 +79,5 @@ static struct LayerVtbl const layer_noise_vtbl = {
     &neural_layer_noise_print,    &neural_layer_noise_update,
     &neural_layer_noise_backward, &neural_layer_noise_forward,
     &neural_layer_noise_output,   &neural_layer_noise_save,
-    &neural_layer_noise_load
+    &neural_layer_noise_load,     &neural_layer_noise_mem_size
 };
@@ -497,3 +497,16 @@ neural_layer_recurrent_load(struct Layer *l, FILE *fp)
     s += layer_load(l->output_layer, fp);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of a recurrent layer.
+ * @param [in] l The layer.
+ * @return The memory size in bytes.
+ */
+size_t
+neural_layer_recurrent_mem_size(const struct Layer *l)
+{
+    return sizeof(struct Layer) + sizeof(double) * N_MU +
+        sizeof(double) * 2 * l->n_outputs + layer_mem_size(l->input_layer) +
+        layer_mem_size(l->self_layer) + layer_mem_size(l->output_layer);
+}
@@ -63,6 +63,9 @@ neural_layer_recurrent_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_recurrent_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_recurrent_mem_size(const struct Layer *l);
+
 void
 neural_layer_recurrent_resize(struct Layer *l, const struct Layer *prev);
 
@@ -76,5 +79,5 @@ static struct LayerVtbl const layer_recurrent_vtbl = {
     &neural_layer_recurrent_print,    &neural_layer_recurrent_update,
     &neural_layer_recurrent_backward, &neural_layer_recurrent_forward,
     &neural_layer_recurrent_output,   &neural_layer_recurrent_save,
-    &neural_layer_recurrent_load,
+    &neural_layer_recurrent_load,     &neural_layer_recurrent_mem_size,
 };
@@ -62,6 +62,9 @@ neural_layer_softmax_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_softmax_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_softmax_mem_size(const struct Layer *l);
+
 void
 neural_layer_softmax_resize(struct Layer *l, const struct Layer *prev);
 
@@ -75,5 +78,5 @@ static struct LayerVtbl const layer_softmax_vtbl = {
     &neural_layer_softmax_print,    &neural_layer_softmax_update,
     &neural_layer_softmax_backward, &neural_layer_softmax_forward,
     &neural_layer_softmax_output,   &neural_layer_softmax_save,
-    &neural_layer_softmax_load
+    &neural_layer_softmax_load,     &neural_layer_softmax_mem_size
 };
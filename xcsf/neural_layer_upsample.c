@@ -289,3 +289,14 @@ neural_layer_upsample_load(struct Layer *l, FILE *fp)
     malloc_layer_arrays(l);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of an upsampling layer.
+ * @param [in] l The layer.
+ * @return The memory size in bytes.
+ */
+size_t
+neural_layer_upsample_mem_size(const struct Layer *l)
+{
+    return sizeof(struct Layer) + sizeof(double) * 2 * l->n_outputs;
+}
@@ -63,6 +63,9 @@ neural_layer_upsample_save(const struct Layer *l, FILE *fp);
 size_t
 neural_layer_upsample_load(struct Layer *l, FILE *fp);
 
+size_t
+neural_layer_upsample_mem_size(const struct Layer *l);
+
 void
 neural_layer_upsample_resize(struct Layer *l, const struct Layer *prev);
 
@@ -76,5 +79,5 @@ static struct LayerVtbl const layer_upsample_vtbl = {
     &neural_layer_upsample_print,    &neural_layer_upsample_update,
     &neural_layer_upsample_backward, &neural_layer_upsample_forward,
     &neural_layer_upsample_output,   &neural_layer_upsample_save,
-    &neural_layer_upsample_load
+    &neural_layer_upsample_load,     &neural_layer_upsample_mem_size
 };
@@ -23,7 +23,13 @@
 
 #include "pa.h"
 #include "cl.h"
+#include "prof.h"
 #include "utils.h"
+#include <limits.h>
+
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
 
 /**
  * @brief Resets the prediction array to zero.
@@ -60,7 +66,9 @@ pa_init(struct XCSF *xcsf)
 void
 pa_build(const struct XCSF *xcsf, const double *x)
 {
+    const double start = prof_start(xcsf, PROF_PA);
     const struct Set *set = &xcsf->mset;
+    prof_items(xcsf, PROF_PA, set->size);
     double *pa = xcsf->pa;
     double *nr = xcsf->nr;
     pa_reset(xcsf);
@@ -74,16 +82,25 @@ pa_build(const struct XCSF *xcsf, const double *x)
             iter = iter->next;
         }
     }
-    #pragma omp parallel for reduction(+ : pa[:xcsf->pa_size], nr[:xcsf->pa_size])
-    for (int i = 0; i < set->size; ++i) {
-        if (clist[i] != NULL) {
-            const double *pred = cl_predict(xcsf, clist[i], x);
-            const double fitness = clist[i]->fit;
-            for (int j = 0; j < xcsf->y_dim; ++j) {
-                pa[clist[i]->action * xcsf->y_dim + j] += pred[j] * fitness;
-                nr[clist[i]->action * xcsf->y_dim + j] += fitness;
+    const uint32_t seed = (uint32_t) rand_uniform_int(0, INT_MAX);
+    #pragma omp parallel
+    {
+        const double t = prof_thread_start(xcsf);
+        rand_init_worker(seed);
+        #pragma omp for schedule(static) nowait \
+            reduction(+ : pa[:xcsf->pa_size], nr[:xcsf->pa_size])
+        for (int i = 0; i < set->size; ++i) {
+            if (clist[i] != NULL) {
+                const double *pred = cl_predict(xcsf, clist[i], x);
+                const double fitness = clist[i]->fit;
+                const int k = clist[i]->action * xcsf->y_dim;
+                for (int j = 0; j < xcsf->y_dim; ++j) {
+                    pa[k + j] += pred[j] * fitness;
+                    nr[k + j] += fitness;
+                }
             }
         }
+        prof_thread_stop(xcsf, PROF_PA, omp_get_thread_num(), t);
     }
 #else
     const struct Clist *iter = set->list;
@@ -107,6 +124,7 @@ pa_build(const struct XCSF *xcsf, const double *x)
             }
         }
     }
+    prof_stop(xcsf, PROF_PA, start);
 }
 
 /**
@@ -42,7 +42,16 @@ param_defaults_general(struct XCSF *xcsf)
     param_set_pop_init(xcsf, true);
     param_set_max_trials(xcsf, 100000);
     param_set_perf_trials(xcsf, 1000);
+    param_set_checkpoint_trials(xcsf, 0);
+    param_set_publish_trials(xcsf, 0);
+    param_set_profile(xcsf, false);
+    param_set_profile_hw(xcsf, false);
+    param_set_trace_size(xcsf, 0);
     param_set_pop_size(xcsf, 2000);
+    param_set_pop_mem_size(xcsf, 0);
+    param_set_islands(xcsf, 1);
+    param_set_migration_trials(xcsf, 1000);
+    param_set_migration_size(xcsf, 10);
     param_set_loss_func(xcsf, LOSS_MAE);
     param_set_huber_delta(xcsf, 1);
 }
@@ -59,7 +68,20 @@ param_print_general(const struct XCSF *xcsf)
     xcsf->POP_INIT ? printf("true") : printf("false");
     printf(", MAX_TRIALS=%d", xcsf->MAX_TRIALS);
     printf(", PERF_TRIALS=%d", xcsf->PERF_TRIALS);
+    printf(", CHECKPOINT_TRIALS=%d", xcsf->CHECKPOINT_TRIALS);
+    printf(", PUBLISH_TRIALS=%d", xcsf->PUBLISH_TRIALS);
+    printf(", PROFILE=");
+    xcsf->PROFILE ? printf("true") : printf("false");
+    printf(", PROFILE_HW=");
+    xcsf->PROFILE_HW ? printf("true") : printf("false");
+    printf(", TRACE_SIZE=%d", xcsf->TRACE_SIZE);
     printf(", POP_SIZE=%d", xcsf->POP_SIZE);
+    printf(", POP_MEM_SIZE=%d", xcsf->POP_MEM_SIZE);
+    printf(", ISLANDS=%d", xcsf->ISLANDS);
+    if (xcsf->ISLANDS > 1) {
+        printf(", MIGRATION_TRIALS=%d", xcsf->MIGRATION_TRIALS);
+        printf(", MIGRATION_SIZE=%d", xcsf->MIGRATION_SIZE);
+    }
     printf(", LOSS_FUNC=%s", loss_type_as_string(xcsf->LOSS_FUNC));
     if (xcsf->LOSS_FUNC == LOSS_HUBER) {
         printf(", HUBER_DELTA=%f", xcsf->HUBER_DELTA);
@@ -80,7 +102,16 @@ param_save_general(const struct XCSF *xcsf, FILE *fp)
     s += fwrite(&xcsf->POP_INIT, sizeof(bool), 1, fp);
     s += fwrite(&xcsf->MAX_TRIALS, sizeof(int), 1, fp);
     s += fwrite(&xcsf->PERF_TRIALS, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->CHECKPOINT_TRIALS, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->PUBLISH_TRIALS, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->PROFILE, sizeof(bool), 1, fp);
+    s += fwrite(&xcsf->PROFILE_HW, sizeof(bool), 1, fp);
+    s += fwrite(&xcsf->TRACE_SIZE, sizeof(int), 1, fp);
     s += fwrite(&xcsf->POP_SIZE, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->POP_MEM_SIZE, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->ISLANDS, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->MIGRATION_TRIALS, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->MIGRATION_SIZE, sizeof(int), 1, fp);
     s += fwrite(&xcsf->LOSS_FUNC, sizeof(int), 1, fp);
     s += fwrite(&xcsf->HUBER_DELTA, sizeof(double), 1, fp);
     return s;
@@ -100,7 +131,16 @@ param_load_general(struct XCSF *xcsf, FILE *fp)
     s += fread(&xcsf->POP_INIT, sizeof(bool), 1, fp);
     s += fread(&xcsf->MAX_TRIALS, sizeof(int), 1, fp);
     s += fread(&xcsf->PERF_TRIALS, sizeof(int), 1, fp);
+    s += fread(&xcsf->CHECKPOINT_TRIALS, sizeof(int), 1, fp);
+    s += fread(&xcsf->PUBLISH_TRIALS, sizeof(int), 1, fp);
+    s += fread(&xcsf->PROFILE, sizeof(bool), 1, fp);
+    s += fread(&xcsf->PROFILE_HW, sizeof(bool), 1, fp);
+    s += fread(&xcsf->TRACE_SIZE, sizeof(int), 1, fp);
     s += fread(&xcsf->POP_SIZE, sizeof(int), 1, fp);
+    s += fread(&xcsf->POP_MEM_SIZE, sizeof(int), 1, fp);
+    s += fread(&xcsf->ISLANDS, sizeof(int), 1, fp);
+    s += fread(&xcsf->MIGRATION_TRIALS, sizeof(int), 1, fp);
+    s += fread(&xcsf->MIGRATION_SIZE, sizeof(int), 1, fp);
     s += fread(&xcsf->LOSS_FUNC, sizeof(int), 1, fp);
     s += fread(&xcsf->HUBER_DELTA, sizeof(double), 1, fp);
     loss_set_func(xcsf);
@@ -207,6 +247,9 @@ param_defaults_multistep(struct XCSF *xcsf)
     param_set_gamma(xcsf, 0.95);
     param_set_teletransportation(xcsf, 50);
     param_set_p_explore(xcsf, 0.9);
+    param_set_replay_size(xcsf, 0);
+    param_set_replay_batch(xcsf, 4);
+    param_set_n_envs(xcsf, 1);
 }
 
 /**
@@ -219,6 +262,9 @@ param_print_multistep(const struct XCSF *xcsf)
     printf(", GAMMA=%f", xcsf->GAMMA);
     printf(", TELETRANSPORTATION=%d", xcsf->TELETRANSPORTATION);
     printf(", P_EXPLORE=%f", xcsf->P_EXPLORE);
+    printf(", REPLAY_SIZE=%d", xcsf->REPLAY_SIZE);
+    printf(", REPLAY_BATCH=%d", xcsf->REPLAY_BATCH);
+    printf(", N_ENVS=%d", xcsf->N_ENVS);
 }
 
 /**
@@ -234,6 +280,9 @@ param_save_multistep(const struct XCSF *xcsf, FILE *fp)
     s += fwrite(&xcsf->GAMMA, sizeof(double), 1, fp);
     s += fwrite(&xcsf->TELETRANSPORTATION, sizeof(int), 1, fp);
     s += fwrite(&xcsf->P_EXPLORE, sizeof(double), 1, fp);
+    s += fwrite(&xcsf->REPLAY_SIZE, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->REPLAY_BATCH, sizeof(int), 1, fp);
+    s += fwrite(&xcsf->N_ENVS, sizeof(int), 1, fp);
     return s;
 }
 
@@ -250,6 +299,9 @@ param_load_multistep(struct XCSF *xcsf, FILE *fp)
     s += fread(&xcsf->GAMMA, sizeof(double), 1, fp);
     s += fread(&xcsf->TELETRANSPORTATION, sizeof(int), 1, fp);
     s += fread(&xcsf->P_EXPLORE, sizeof(double), 1, fp);
+    s += fread(&xcsf->REPLAY_SIZE, sizeof(int), 1, fp);
+    s += fread(&xcsf->REPLAY_BATCH, sizeof(int), 1, fp);
+    s += fread(&xcsf->N_ENVS, sizeof(int), 1, fp);
     return s;
 }
 
@@ -498,6 +550,51 @@ param_set_perf_trials(struct XCSF *xcsf, const int a)
     }
 }
 
+void
+param_set_checkpoint_trials(struct XCSF *xcsf, const int a)
+{
+    if (a < 0) {
+        printf("Warning: tried to set CHECKPOINT_TRIALS too small\n");
+        xcsf->CHECKPOINT_TRIALS = 0;
+    } else {
+        xcsf->CHECKPOINT_TRIALS = a;
+    }
+}
+
+void
+param_set_publish_trials(struct XCSF *xcsf, const int a)
+{
+    if (a < 0) {
+        printf("Warning: tried to set PUBLISH_TRIALS too small\n");
+        xcsf->PUBLISH_TRIALS = 0;
+    } else {
+        xcsf->PUBLISH_TRIALS = a;
+    }
+}
+
+void
+param_set_profile(struct XCSF *xcsf, const bool a)
+{
+    xcsf->PROFILE = a;
+}
+
+void
+param_set_profile_hw(struct XCSF *xcsf, const bool a)
+{
+    xcsf->PROFILE_HW = a;
+}
+
+void
+param_set_trace_size(struct XCSF *xcsf, const int a)
+{
+    if (a < 0) {
+        printf("Warning: tried to set TRACE_SIZE too small\n");
+        xcsf->TRACE_SIZE = 0;
+    } else {
+        xcsf->TRACE_SIZE = a;
+    }
+}
+
 void
 param_set_pop_size(struct XCSF *xcsf, const int a)
 {
@@ -509,6 +606,50 @@ param_set_pop_size(struct XCSF *xcsf, const int a)
     }
 }
 
+void
+param_set_pop_mem_size(struct XCSF *xcsf, const int a)
+{
+    if (a < 0) {
+        printf("Warning: tried to set POP_MEM_SIZE too small\n");
+        xcsf->POP_MEM_SIZE = 0;
+    } else {
+        xcsf->POP_MEM_SIZE = a;
+    }
+}
+
+void
+param_set_islands(struct XCSF *xcsf, const int a)
+{
+    if (a < 1) {
+        printf("Warning: tried to set ISLANDS too small\n");
+        xcsf->ISLANDS = 1;
+    } else {
+        xcsf->ISLANDS = a;
+    }
+}
+
+void
+param_set_migration_trials(struct XCSF *xcsf, const int a)
+{
+    if (a < 1) {
+        printf("Warning: tried to set MIGRATION_TRIALS too small\n");
+        xcsf->MIGRATION_TRIALS = 1;
+    } else {
+        xcsf->MIGRATION_TRIALS = a;
+    }
+}
+
+void
+param_set_migration_size(struct XCSF *xcsf, const int a)
+{
+    if (a < 0) {
+        printf("Warning: tried to set MIGRATION_SIZE too small\n");
+        xcsf->MIGRATION_SIZE = 0;
+    } else {
+        xcsf->MIGRATION_SIZE = a;
+    }
+}
+
 void
 param_set_loss_func_string(struct XCSF *xcsf, const char *a)
 {
@@ -579,6 +720,39 @@ param_set_teletransportation(struct XCSF *xcsf, const int a)
     }
 }
 
+void
+param_set_replay_size(struct XCSF *xcsf, const int a)
+{
+    if (a < 0) {
+        printf("Warning: tried to set REPLAY_SIZE too small\n");
+        xcsf->REPLAY_SIZE = 0;
+    } else {
+        xcsf->REPLAY_SIZE = a;
+    }
+}
+
+void
+param_set_replay_batch(struct XCSF *xcsf, const int a)
+{
+    if (a < 0) {
+        printf("Warning: tried to set REPLAY_BATCH too small\n");
+        xcsf->REPLAY_BATCH = 0;
+    } else {
+        xcsf->REPLAY_BATCH = a;
+    }
+}
+
+void
+param_set_n_envs(struct XCSF *xcsf, const int a)
+{
+    if (a < 1) {
+        printf("Warning: tried to set N_ENVS too small\n");
+        xcsf->N_ENVS = 1;
+    } else {
+        xcsf->N_ENVS = a;
+    }
+}
+
 void
 param_set_p_explore(struct XCSF *xcsf, const double a)
 {
@@ -56,9 +56,36 @@ param_set_max_trials(struct XCSF *xcsf, const int a);
 void
 param_set_perf_trials(struct XCSF *xcsf, const int a);
 
+void
+param_set_checkpoint_trials(struct XCSF *xcsf, const int a);
+
+void
+param_set_publish_trials(struct XCSF *xcsf, const int a);
+
+void
+param_set_profile(struct XCSF *xcsf, const bool a);
+
+void
+param_set_profile_hw(struct XCSF *xcsf, const bool a);
+
+void
+param_set_trace_size(struct XCSF *xcsf, const int a);
+
 void
 param_set_pop_size(struct XCSF *xcsf, const int a);
 
+void
+param_set_pop_mem_size(struct XCSF *xcsf, const int a);
+
+void
+param_set_islands(struct XCSF *xcsf, const int a);
+
+void
+param_set_migration_trials(struct XCSF *xcsf, const int a);
+
+void
+param_set_migration_size(struct XCSF *xcsf, const int a);
+
 void
 param_set_loss_func_string(struct XCSF *xcsf, const char *a);
 
@@ -83,6 +110,15 @@ param_set_teletransportation(struct XCSF *xcsf, const int a);
 void
 param_set_p_explore(struct XCSF *xcsf, const double a);
 
+void
+param_set_replay_size(struct XCSF *xcsf, const int a);
+
+void
+param_set_replay_batch(struct XCSF *xcsf, const int a);
+
+void
+param_set_n_envs(struct XCSF *xcsf, const int a);
+
 void
 param_set_alpha(struct XCSF *xcsf, const double a);
 
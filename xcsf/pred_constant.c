@@ -191,3 +191,17 @@ pred_constant_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     (void) fp;
     return 0;
 }
+
+/**
+ * @brief Dummy function since constant predictions have no data structure.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose prediction memory size to return.
+ * @return Zero.
+ */
+size_t
+pred_constant_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    (void) c;
+    return 0;
+}
@@ -204,6 +204,20 @@ pred_neural_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     return s;
 }
 
+/**
+ * @brief Returns the memory size of a neural network prediction.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose prediction memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+pred_neural_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct PredNeural *pred = c->pred;
+    return sizeof(struct PredNeural) + neural_mem_size(&pred->net);
+}
+
 /**
  * @brief Returns the gradient descent rate of a neural prediction layer.
  * @param [in] xcsf The XCSF data structure.
@@ -63,6 +63,9 @@ pred_neural_size(const struct XCSF *xcsf, const struct Cl *c);
 size_t
 pred_neural_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
 
+size_t
+pred_neural_mem_size(const struct XCSF *xcsf, const struct Cl *c);
+
 size_t
 pred_neural_save(const struct XCSF *xcsf, const struct Cl *c, FILE *fp);
 
@@ -102,5 +105,5 @@ static struct PredVtbl const pred_neural_vtbl = {
     &pred_neural_crossover, &pred_neural_mutate, &pred_neural_compute,
     &pred_neural_copy,      &pred_neural_free,   &pred_neural_init,
     &pred_neural_print,     &pred_neural_update, &pred_neural_size,
-    &pred_neural_save,      &pred_neural_load
+    &pred_neural_save,      &pred_neural_load,   &pred_neural_mem_size
 };
@@ -36,12 +36,12 @@ static const int MU_TYPE[N_MU] = {
 };
 
 /**
- * @brief Initialises an NLMS prediction.
+ * @brief Allocates an NLMS prediction without initialising its values.
  * @param [in] xcsf The XCSF data structure.
- * @param [in] c The classifier whose prediction is to be initialised.
+ * @param [in] c The classifier whose prediction is to be allocated.
  */
-void
-pred_nlms_init(const struct XCSF *xcsf, struct Cl *c)
+static void
+pred_nlms_alloc(const struct XCSF *xcsf, struct Cl *c)
 {
     struct PredNLMS *pred = malloc(sizeof(struct PredNLMS));
     c->pred = pred;
@@ -52,12 +52,26 @@ pred_nlms_init(const struct XCSF *xcsf, struct Cl *c)
     } else {
         pred->n = xcsf->x_dim + 1;
     }
-    // initialise weights
     pred->n_weights = pred->n * xcsf->y_dim;
     pred->weights = calloc(pred->n_weights, sizeof(double));
+    pred->mu = malloc(sizeof(double) * N_MU);
+    // temporary storage for weight updating
+    pred->tmp_input = malloc(sizeof(double) * pred->n);
+}
+
+/**
+ * @brief Initialises an NLMS prediction.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose prediction is to be initialised.
+ */
+void
+pred_nlms_init(const struct XCSF *xcsf, struct Cl *c)
+{
+    pred_nlms_alloc(xcsf, c);
+    struct PredNLMS *pred = c->pred;
+    // initialise weights
     blas_fill(xcsf->y_dim, xcsf->pred->x0, pred->weights, pred->n);
     // initialise learning rate
-    pred->mu = malloc(sizeof(double) * N_MU);
     if (xcsf->pred->evolve_eta) {
         sam_init(pred->mu, N_MU, MU_TYPE);
         pred->eta = rand_uniform(xcsf->pred->eta_min, xcsf->pred->eta);
@@ -65,8 +79,6 @@ pred_nlms_init(const struct XCSF *xcsf, struct Cl *c)
         memset(pred->mu, 0, sizeof(double) * N_MU);
         pred->eta = xcsf->pred->eta;
     }
-    // initialise temporary storage for weight updating
-    pred->tmp_input = malloc(sizeof(double) * pred->n);
 }
 
 /**
@@ -249,7 +261,7 @@ pred_nlms_save(const struct XCSF *xcsf, const struct Cl *c, FILE *fp)
 size_t
 pred_nlms_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
 {
-    pred_nlms_init(xcsf, c);
+    pred_nlms_alloc(xcsf, c);
     struct PredNLMS *pred = c->pred;
     size_t s = 0;
     s += fread(&pred->n, sizeof(int), 1, fp);
@@ -259,3 +271,18 @@ pred_nlms_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     s += fread(&pred->eta, sizeof(double), 1, fp);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of an NLMS prediction.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose prediction memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+pred_nlms_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct PredNLMS *pred = c->pred;
+    return sizeof(struct PredNLMS) +
+        sizeof(double) * (pred->n_weights + pred->n + N_MU);
+}
@@ -51,6 +51,9 @@ pred_nlms_size(const struct XCSF *xcsf, const struct Cl *c);
 size_t
 pred_nlms_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
 
+size_t
+pred_nlms_mem_size(const struct XCSF *xcsf, const struct Cl *c);
+
 size_t
 pred_nlms_save(const struct XCSF *xcsf, const struct Cl *c, FILE *fp);
 
@@ -80,5 +83,5 @@ static struct PredVtbl const pred_nlms_vtbl = {
     &pred_nlms_crossover, &pred_nlms_mutate, &pred_nlms_compute,
     &pred_nlms_copy,      &pred_nlms_free,   &pred_nlms_init,
     &pred_nlms_print,     &pred_nlms_update, &pred_nlms_size,
-    &pred_nlms_save,      &pred_nlms_load
+    &pred_nlms_save,      &pred_nlms_load,   &pred_nlms_mem_size
 };
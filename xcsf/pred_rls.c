@@ -271,3 +271,19 @@ pred_rls_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     s += fread(pred->matrix, sizeof(double), n_sqrd, fp);
     return s;
 }
+
+/**
+ * @brief Returns the memory size of an RLS prediction.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose prediction memory size to return.
+ * @return The memory size in bytes.
+ */
+size_t
+pred_rls_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct PredRLS *pred = c->pred;
+    const int n_sqrd = pred->n * pred->n;
+    return sizeof(struct PredRLS) +
+        sizeof(double) * (pred->n_weights + 2 * pred->n + 3 * n_sqrd);
+}
@@ -102,8 +102,21 @@ struct PredVtbl {
     size_t (*pred_impl_save)(const struct XCSF *xcsf, const struct Cl *c,
                              FILE *fp);
     size_t (*pred_impl_load)(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
+    size_t (*pred_impl_mem_size)(const struct XCSF *xcsf, const struct Cl *c);
 };
 
+/**
+ * @brief Returns the number of bytes of memory allocated for the prediction.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] c The classifier whose prediction memory size to return.
+ * @return The memory size in bytes.
+ */
+static inline size_t
+pred_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    return (*c->pred_vptr->pred_impl_mem_size)(xcsf, c);
+}
+
 /**
  * @brief Writes the prediction to a file.
  * @param [in] xcsf The XCSF data structure.
@@ -0,0 +1,423 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file prof.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Per-phase timers, event counters, and trace spans.
+ * @details Timers and counters are only updated when PROFILE is enabled.
+ * Spans are only recorded when TRACE_SIZE is greater than zero, in which case
+ * the most recent TRACE_SIZE spans are kept in a ring buffer and may be saved
+ * in the Chrome trace event format for viewing with chrome://tracing or
+ * Perfetto. When PROFILE_HW is also enabled on Linux, the cycles,
+ * instructions, cache misses and branch misses of the calling thread are
+ * sampled with perf_event_open() at the start and end of each phase.
+ */
+
+#include "prof.h"
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+static const char *prof_phases[PROF_PHASES] = {
+    "match",      "cover",        "pa",     "update",
+    "ea_select",  "ea_reproduce", "delete", "subsume"
+}; //!< Phase names
+
+static const char *prof_events[PROF_EVENTS] = {
+    "covered", "ea_runs", "offspring", "deleted", "subsumed", "unchanged"
+}; //!< Event names
+
+static const char *prof_counters[PROF_COUNTERS] = {
+    "cycles", "instructions", "cache_misses", "branch_misses"
+}; //!< Hardware counter names
+
+/**
+ * @brief Closes the hardware performance counters.
+ * @param [in] prof The profiling data structure.
+ */
+static void
+prof_hw_close(struct Prof *prof)
+{
+    for (int i = 0; i < PROF_COUNTERS; ++i) {
+#ifdef __linux__
+        if (prof->hw_fd[i] >= 0) {
+            close(prof->hw_fd[i]);
+        }
+#endif
+        prof->hw_fd[i] = -1;
+    }
+}
+
+/**
+ * @brief Opens the hardware performance counters as a single group.
+ * @details The counters are marked unavailable, and a warning printed, if
+ * they cannot be opened, e.g., due to perf_event_paranoid restrictions.
+ * @param [in] prof The profiling data structure.
+ */
+static void
+prof_hw_open(struct Prof *prof)
+{
+#ifdef __linux__
+    const uint64_t config[PROF_COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES,
+                                             PERF_COUNT_HW_INSTRUCTIONS,
+                                             PERF_COUNT_HW_CACHE_MISSES,
+                                             PERF_COUNT_HW_BRANCH_MISSES };
+    for (int i = 0; i < PROF_COUNTERS; ++i) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(struct perf_event_attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(struct perf_event_attr);
+        attr.config = config[i];
+        attr.disabled = (i == 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        const int group = (i == 0) ? -1 : prof->hw_fd[0];
+        prof->hw_fd[i] =
+            (int) syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+        if (prof->hw_fd[i] < 0) {
+            printf("Warning: hardware counter %s unavailable. %s.\n",
+                   prof_counters[i], strerror(errno));
+            prof_hw_close(prof);
+            prof->hw_state = -1;
+            return;
+        }
+    }
+    ioctl(prof->hw_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(prof->hw_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    prof->hw_state = 1;
+#else
+    printf("Warning: hardware counters are only available on Linux\n");
+    prof->hw_state = -1;
+#endif
+}
+
+/**
+ * @brief Reads the current values of the hardware performance counters.
+ * @details The counters are opened on first use.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [out] counts The counter values (zero if unavailable).
+ */
+void
+prof_hw_read(const struct XCSF *xcsf, uint64_t *counts)
+{
+    struct Prof *prof = xcsf->prof;
+    if (prof->hw_state == 0) {
+        prof_hw_open(prof);
+    }
+#ifdef __linux__
+    if (prof->hw_state == 1) {
+        uint64_t buf[PROF_COUNTERS + 1]; // number of counters then values
+        if (read(prof->hw_fd[0], buf, sizeof(buf)) == sizeof(buf)) {
+            memcpy(counts, &buf[1], sizeof(uint64_t) * PROF_COUNTERS);
+            return;
+        }
+    }
+#endif
+    memset(counts, 0, sizeof(uint64_t) * PROF_COUNTERS);
+}
+
+/**
+ * @brief Adds the hardware counts since the start of a phase to its totals.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] phase The phase being timed.
+ */
+void
+prof_hw_stop(const struct XCSF *xcsf, const int phase)
+{
+    struct Prof *prof = xcsf->prof;
+    uint64_t counts[PROF_COUNTERS];
+    prof_hw_read(xcsf, counts);
+    for (int i = 0; i < PROF_COUNTERS; ++i) {
+        if (counts[i] > prof->hw_start[phase][i]) {
+            prof->hw[phase][i] += counts[i] - prof->hw_start[phase][i];
+        }
+    }
+}
+
+/**
+ * @brief Initialises the timers and counters.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+prof_init(struct XCSF *xcsf)
+{
+    xcsf->prof = malloc(sizeof(struct Prof));
+    xcsf->prof->trace = NULL;
+    xcsf->prof->trace_size = 0;
+    xcsf->prof->trace_n = 0;
+    xcsf->prof->trace_t0 = 0;
+    xcsf->prof->hw_state = 0;
+    xcsf->prof->depth = 0;
+    for (int i = 0; i < PROF_COUNTERS; ++i) {
+        xcsf->prof->hw_fd[i] = -1;
+    }
+    memset(xcsf->prof->hw_start, 0, sizeof(xcsf->prof->hw_start));
+    prof_reset(xcsf);
+}
+
+/**
+ * @brief Frees the timers and counters.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+prof_free(struct XCSF *xcsf)
+{
+    prof_hw_close(xcsf->prof);
+    free(xcsf->prof->trace);
+    free(xcsf->prof);
+    xcsf->prof = NULL;
+}
+
+/**
+ * @brief Adds the timers and counters of another XCSF to those of this one.
+ * @details Hardware counters and trace spans are not added.
+ * @param [in] xcsf The XCSF data structure to add to.
+ * @param [in] src The XCSF data structure whose timers and counters are added.
+ */
+void
+prof_add(const struct XCSF *xcsf, const struct XCSF *src)
+{
+    struct Prof *prof = xcsf->prof;
+    const struct Prof *p = src->prof;
+    for (int i = 0; i < PROF_PHASES; ++i) {
+        prof->time[i] += p->time[i];
+        prof->self[i] += p->self[i];
+        prof->calls[i] += p->calls[i];
+        prof->items[i] += p->items[i];
+    }
+    for (int i = 0; i < PROF_EVENTS; ++i) {
+        prof->events[i] += p->events[i];
+    }
+    for (int i = 0; i < PROF_HISTS; ++i) {
+        for (int j = 0; j < PROF_HIST_BINS; ++j) {
+            prof->hist[i][j] += p->hist[i][j];
+        }
+    }
+}
+
+/**
+ * @brief Resets all timers and counters to zero.
+ * @details The trace ring buffer is unaffected.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+prof_reset(const struct XCSF *xcsf)
+{
+    struct Prof *prof = xcsf->prof;
+    memset(prof->time, 0, sizeof(prof->time));
+    memset(prof->self, 0, sizeof(prof->self));
+    memset(prof->calls, 0, sizeof(prof->calls));
+    memset(prof->events, 0, sizeof(prof->events));
+    memset(prof->hist, 0, sizeof(prof->hist));
+    memset(prof->items, 0, sizeof(prof->items));
+    memset(prof->hw, 0, sizeof(prof->hw));
+}
+
+/**
+ * @brief Creates an empty trace ring buffer with TRACE_SIZE spans.
+ * @details Any previously recorded spans are discarded.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+prof_trace_init(const struct XCSF *xcsf)
+{
+    struct Prof *prof = xcsf->prof;
+    free(prof->trace);
+    prof->trace = NULL;
+    prof->trace_size = xcsf->TRACE_SIZE;
+    if (prof->trace_size > 0) {
+        prof->trace = malloc(sizeof(struct ProfSpan) * prof->trace_size);
+    }
+    prof->trace_n = 0;
+    prof->trace_t0 = prof_time();
+}
+
+/**
+ * @brief Records a span in the trace ring buffer.
+ * @details May be called concurrently by multiple threads; the oldest span is
+ * overwritten when the buffer is full.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] phase The phase.
+ * @param [in] tid The thread number (-1 for a whole phase).
+ * @param [in] start The start time in seconds.
+ * @param [in] end The end time in seconds.
+ */
+void
+prof_trace_add(const struct XCSF *xcsf, const int phase, const int tid,
+               const double start, const double end)
+{
+    struct Prof *prof = xcsf->prof;
+    uint64_t n;
+#ifdef PARALLEL
+    #pragma omp atomic capture
+#endif
+    n = prof->trace_n++;
+    struct ProfSpan *span = &prof->trace[n % (uint64_t) prof->trace_size];
+    span->start = start;
+    span->end = end;
+    span->phase = phase;
+    span->tid = tid;
+}
+
+/**
+ * @brief Writes the trace ring buffer to a file in the Chrome trace format.
+ * @details Whole phases are shown on the calling thread (tid 0) and the work
+ * of each thread within a parallel phase is shown on its own row.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] filename The name of the file to write.
+ */
+void
+prof_trace_save(const struct XCSF *xcsf, const char *filename)
+{
+    const struct Prof *prof = xcsf->prof;
+    FILE *fp = fopen(filename, "w");
+    if (fp == 0) {
+        printf("Error opening trace file: %s. %s.\n", filename,
+               strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    const uint64_t size = (uint64_t) prof->trace_size;
+    const uint64_t n = (prof->trace_n < size) ? prof->trace_n : size;
+    const uint64_t first = prof->trace_n - n;
+    fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    for (uint64_t i = 0; i < n; ++i) {
+        const struct ProfSpan *span = &prof->trace[(first + i) % size];
+        const bool whole = (span->tid < 0);
+        fprintf(fp, "%s\n{\"name\": \"%s\", \"cat\": \"%s\", ",
+                (i > 0) ? "," : "", prof_phases[span->phase],
+                whole ? "phase" : "thread");
+        fprintf(fp, "\"ph\": \"X\", \"pid\": 0, \"tid\": %d, ",
+                whole ? 0 : span->tid + 1);
+        fprintf(fp, "\"ts\": %.3f, \"dur\": %.3f}",
+                (span->start - prof->trace_t0) * 1e6,
+                (span->end - span->start) * 1e6);
+    }
+    fprintf(fp, "\n]}\n");
+    fclose(fp);
+}
+
+/**
+ * @brief Returns the name of a timed phase.
+ * @param [in] phase The phase.
+ * @return The name of the phase.
+ */
+const char *
+prof_phase_as_string(const int phase)
+{
+    if (phase < 0 || phase >= PROF_PHASES) {
+        printf("prof_phase_as_string(): invalid phase: %d\n", phase);
+        exit(EXIT_FAILURE);
+    }
+    return prof_phases[phase];
+}
+
+/**
+ * @brief Returns the name of a hardware performance counter.
+ * @param [in] counter The counter.
+ * @return The name of the counter.
+ */
+const char *
+prof_counter_as_string(const int counter)
+{
+    if (counter < 0 || counter >= PROF_COUNTERS) {
+        printf("prof_counter_as_string(): invalid counter: %d\n", counter);
+        exit(EXIT_FAILURE);
+    }
+    return prof_counters[counter];
+}
+
+/**
+ * @brief Returns the name of a counted event.
+ * @param [in] event The event.
+ * @return The name of the event.
+ */
+const char *
+prof_event_as_string(const int event)
+{
+    if (event < 0 || event >= PROF_EVENTS) {
+        printf("prof_event_as_string(): invalid event: %d\n", event);
+        exit(EXIT_FAILURE);
+    }
+    return prof_events[event];
+}
+
+/**
+ * @brief Prints a summary of the hardware performance counters.
+ * @details Misses are reported per classifier evaluated in the phase.
+ * @param [in] prof The profiling data structure.
+ */
+static void
+prof_print_hw(const struct Prof *prof)
+{
+    printf("%-14s %14s %14s %8s %14s %14s\n", "phase", "cycles",
+           "instructions", "IPC", "cache_miss/cl", "branch_miss/cl");
+    for (int i = 0; i < PROF_PHASES; ++i) {
+        const uint64_t *hw = prof->hw[i];
+        const double ipc = (hw[PROF_CYCLES] > 0)
+            ? (double) hw[PROF_INSTRUCTIONS] / (double) hw[PROF_CYCLES]
+            : 0;
+        const double n = (prof->items[i] > 0) ? (double) prof->items[i] : 1;
+        printf("%-14s %14" PRIu64 " %14" PRIu64 " %8.3f %14.3f %14.3f\n",
+               prof_phases[i], hw[PROF_CYCLES], hw[PROF_INSTRUCTIONS], ipc,
+               hw[PROF_CACHE_MISSES] / n, hw[PROF_BRANCH_MISSES] / n);
+    }
+}
+
+/**
+ * @brief Prints a summary of the timers and counters.
+ * @details The inclusive time of a phase includes the phases nested within
+ * it, e.g., match includes cover, which includes delete; the exclusive time
+ * does not.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+prof_print(const struct XCSF *xcsf)
+{
+    const struct Prof *prof = xcsf->prof;
+    printf("%-14s %12s %12s %12s %12s %12s\n", "phase", "calls",
+           "incl(s)", "excl(s)", "mean(us)", "classifiers");
+    for (int i = 0; i < PROF_PHASES; ++i) {
+        const double mean = (prof->calls[i] > 0)
+            ? prof->time[i] * 1e6 / (double) prof->calls[i]
+            : 0;
+        printf("%-14s %12" PRIu64 " %12.4f %12.4f %12.3f %12" PRIu64 "\n",
+               prof_phases[i], prof->calls[i], prof->time[i], prof->self[i],
+               mean, prof->items[i]);
+    }
+    if (xcsf->PROFILE_HW && prof->hw_state == 1) {
+        prof_print_hw(prof);
+    }
+    for (int i = 0; i < PROF_EVENTS; ++i) {
+        printf("%s=%" PRIu64 "%s", prof_events[i], prof->events[i],
+               (i < PROF_EVENTS - 1) ? ", " : "\n");
+    }
+    const char *names[PROF_HISTS] = { "mset", "aset" };
+    for (int i = 0; i < PROF_HISTS; ++i) {
+        printf("%s sizes:", names[i]);
+        for (int j = 0; j < PROF_HIST_BINS; ++j) {
+            printf(" %" PRIu64, prof->hist[i][j]);
+        }
+        printf("\n");
+    }
+    fflush(stdout);
+}
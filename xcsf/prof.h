@@ -0,0 +1,287 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file prof.h
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Per-phase timers, event counters, and trace spans.
+ */
+
+#pragma once
+
+#include "xcsf.h"
+#include <time.h>
+
+#define PROF_MATCH (0) //!< Matching conditions and actions (incl. covering)
+#define PROF_COVER (1) //!< Covering (incl. deletion)
+#define PROF_PA (2) //!< Building the prediction array
+#define PROF_UPDATE (3) //!< Updating a set (incl. set subsumption)
+#define PROF_EA_SELECT (4) //!< EA parent selection
+#define PROF_EA_REPRODUCE (5) //!< EA offspring creation and insertion
+#define PROF_DELETE (6) //!< Deletion to enforce the population size limit
+#define PROF_SUBSUME (7) //!< Set subsumption
+#define PROF_PHASES (8) //!< Number of timed phases
+#define PROF_DEPTH (8) //!< Maximum depth of nested phases timed exclusively
+
+#define PROF_COVERED (0) //!< Classifiers created by covering
+#define PROF_EA_RUNS (1) //!< EA executions
+#define PROF_OFFSPRING (2) //!< Offspring created by the EA
+#define PROF_DELETED (3) //!< Micro-classifiers deleted
+#define PROF_SUBSUMED (4) //!< Micro-classifiers subsumed
+#define PROF_UNCHANGED (5) //!< Offspring discarded as unchanged copies
+#define PROF_EVENTS (6) //!< Number of counted events
+
+#define PROF_HIST_MSET (0) //!< Match set size histogram
+#define PROF_HIST_ASET (1) //!< Action set size histogram
+#define PROF_HISTS (2) //!< Number of set size histograms
+#define PROF_HIST_BINS (16) //!< Number of bins in a set size histogram
+
+#define PROF_CYCLES (0) //!< CPU cycles
+#define PROF_INSTRUCTIONS (1) //!< Instructions retired
+#define PROF_CACHE_MISSES (2) //!< Last level cache misses
+#define PROF_BRANCH_MISSES (3) //!< Mispredicted branches
+#define PROF_COUNTERS (4) //!< Number of hardware performance counters
+
+#define TRACE_FILENAME ("trace.json") //!< Default trace event file
+
+/**
+ * @brief Trace span data structure.
+ */
+struct ProfSpan {
+    double start; //!< Start time in seconds
+    double end; //!< End time in seconds
+    int phase; //!< The phase
+    int tid; //!< Thread number (-1 for a whole phase on the calling thread)
+};
+
+/**
+ * @brief Per-phase timers and event counters data structure.
+ * @details Phase timers are inclusive of any nested phases; the exclusive
+ * timers subtract the time spent in the phases nested within. Bin 0 of a set
+ * size histogram counts empty sets and bin i>0 counts sets with between
+ * 2^(i-1) and 2^i-1 macro-classifiers; the last bin also counts all larger
+ * sets. Hardware counters only measure the calling thread and are inclusive
+ * of nested phases.
+ */
+struct Prof {
+    double time[PROF_PHASES]; //!< Cumulative seconds spent in each phase
+    double self[PROF_PHASES]; //!< Seconds excluding nested phases
+    double nested[PROF_DEPTH]; //!< Seconds in phases nested at each depth
+    int depth; //!< Number of phases currently being timed
+    uint64_t calls[PROF_PHASES]; //!< Number of times each phase was timed
+    uint64_t events[PROF_EVENTS]; //!< Number of times each event occurred
+    uint64_t hist[PROF_HISTS][PROF_HIST_BINS]; //!< Set size histograms
+    uint64_t items[PROF_PHASES]; //!< Classifiers evaluated in each phase
+    uint64_t hw[PROF_PHASES][PROF_COUNTERS]; //!< Hardware counts per phase
+    uint64_t hw_start[PROF_PHASES][PROF_COUNTERS]; //!< Counts at phase start
+    int hw_fd[PROF_COUNTERS]; //!< Counter file descriptors (-1 if closed)
+    int hw_state; //!< Counters: 0 not yet opened, 1 open, -1 unavailable
+    struct ProfSpan *trace; //!< Ring buffer of the most recent trace spans
+    int trace_size; //!< Number of spans the ring buffer can hold
+    uint64_t trace_n; //!< Total number of spans recorded
+    double trace_t0; //!< Time at which the ring buffer was created
+};
+
+void
+prof_add(const struct XCSF *xcsf, const struct XCSF *src);
+
+const char *
+prof_counter_as_string(const int counter);
+
+const char *
+prof_event_as_string(const int event);
+
+const char *
+prof_phase_as_string(const int phase);
+
+void
+prof_free(struct XCSF *xcsf);
+
+void
+prof_hw_read(const struct XCSF *xcsf, uint64_t *counts);
+
+void
+prof_hw_stop(const struct XCSF *xcsf, const int phase);
+
+void
+prof_init(struct XCSF *xcsf);
+
+void
+prof_print(const struct XCSF *xcsf);
+
+void
+prof_reset(const struct XCSF *xcsf);
+
+void
+prof_trace_add(const struct XCSF *xcsf, const int phase, const int tid,
+               const double start, const double end);
+
+void
+prof_trace_init(const struct XCSF *xcsf);
+
+void
+prof_trace_save(const struct XCSF *xcsf, const char *filename);
+
+/**
+ * @brief Returns the current time of a monotonic clock.
+ * @return The time in seconds.
+ */
+static inline double
+prof_time(void)
+{
+    struct timespec ts;
+#ifdef _WIN32
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Starts timing a phase.
+ * @details Must be called from outside of any parallel region since the
+ * trace ring buffer is (re)created here whenever TRACE_SIZE has changed.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] phase The phase being timed.
+ * @return The start time (0 if profiling and tracing are disabled).
+ */
+static inline double
+prof_start(const struct XCSF *xcsf, const int phase)
+{
+    if (xcsf->TRACE_SIZE != xcsf->prof->trace_size) {
+        prof_trace_init(xcsf);
+    }
+    if (xcsf->PROFILE) {
+        struct Prof *prof = xcsf->prof;
+        if (prof->depth < PROF_DEPTH) {
+            prof->nested[prof->depth] = 0;
+        }
+        ++(prof->depth);
+        if (xcsf->PROFILE_HW) {
+            prof_hw_read(xcsf, prof->hw_start[phase]);
+        }
+    }
+    return (xcsf->PROFILE || xcsf->TRACE_SIZE > 0) ? prof_time() : 0;
+}
+
+/**
+ * @brief Stops timing a phase and adds the elapsed time to its timer.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] phase The phase being timed.
+ * @param [in] start The start time returned by prof_start().
+ */
+static inline void
+prof_stop(const struct XCSF *xcsf, const int phase, const double start)
+{
+    if (xcsf->PROFILE || xcsf->TRACE_SIZE > 0) {
+        const double end = prof_time();
+        if (xcsf->PROFILE) {
+            struct Prof *prof = xcsf->prof;
+            const double elapsed = end - start;
+            --(prof->depth);
+            prof->time[phase] += elapsed;
+            prof->self[phase] += elapsed;
+            if (prof->depth < PROF_DEPTH) {
+                prof->self[phase] -= prof->nested[prof->depth];
+            }
+            if (prof->depth > 0 && prof->depth <= PROF_DEPTH) {
+                prof->nested[prof->depth - 1] += elapsed;
+            }
+            ++(prof->calls[phase]);
+            if (xcsf->PROFILE_HW) {
+                prof_hw_stop(xcsf, phase);
+            }
+        }
+        if (xcsf->prof->trace_size > 0) {
+            prof_trace_add(xcsf, phase, -1, start, end);
+        }
+    }
+}
+
+/**
+ * @brief Starts tracing the work of one thread within a parallel phase.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The start time (0 if tracing is disabled).
+ */
+static inline double
+prof_thread_start(const struct XCSF *xcsf)
+{
+    return (xcsf->prof->trace_size > 0) ? prof_time() : 0;
+}
+
+/**
+ * @brief Stops tracing the work of one thread within a parallel phase.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] phase The phase being traced.
+ * @param [in] tid The thread number.
+ * @param [in] start The start time returned by prof_thread_start().
+ */
+static inline void
+prof_thread_stop(const struct XCSF *xcsf, const int phase, const int tid,
+                 const double start)
+{
+    if (xcsf->prof->trace_size > 0) {
+        prof_trace_add(xcsf, phase, tid, start, prof_time());
+    }
+}
+
+/**
+ * @brief Adds to the count of an event.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] event The event that occurred.
+ * @param [in] n The number of occurrences.
+ */
+static inline void
+prof_count(const struct XCSF *xcsf, const int event, const int n)
+{
+    if (xcsf->PROFILE) {
+        xcsf->prof->events[event] += n;
+    }
+}
+
+/**
+ * @brief Adds to the number of classifiers evaluated in a phase.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] phase The phase.
+ * @param [in] n The number of classifiers evaluated.
+ */
+static inline void
+prof_items(const struct XCSF *xcsf, const int phase, const int n)
+{
+    if (xcsf->PROFILE) {
+        xcsf->prof->items[phase] += n;
+    }
+}
+
+/**
+ * @brief Records the size of a set in a histogram.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] hist The histogram to update.
+ * @param [in] size The number of macro-classifiers in the set.
+ */
+static inline void
+prof_hist(const struct XCSF *xcsf, const int hist, const int size)
+{
+    if (xcsf->PROFILE) {
+        int bin = 0;
+        while (bin < PROF_HIST_BINS - 1 && (size >> bin) > 0) {
+            ++bin;
+        }
+        ++(xcsf->prof->hist[hist][bin]);
+    }
+}
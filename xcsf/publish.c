@@ -0,0 +1,239 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file publish.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Published population snapshots for concurrent inference.
+ * @details The training thread periodically publishes an immutable frozen
+ * model of the population. Inference threads acquire the latest snapshot
+ * without locking and make predictions with the read-only frozen model path
+ * while training continues. A snapshot that has been replaced is retired and
+ * freed by the training thread once no reader holds a reference to it and no
+ * reader is part-way through acquiring a snapshot, at which point no reader
+ * can still obtain it.
+ */
+
+#include "publish.h"
+#include "action.h"
+#include "condition.h"
+#include "prediction.h"
+#include <stdatomic.h>
+
+/**
+ * @brief Reference-counted snapshot data structure.
+ */
+struct Snapshot {
+    struct Frozen frozen; //!< Frozen model of the population (first member)
+    atomic_int refs; //!< Number of readers holding the snapshot
+    struct Snapshot *next; //!< Next retired snapshot
+};
+
+/**
+ * @brief Published snapshots data structure.
+ */
+struct Publish {
+    _Atomic(struct Snapshot *) current; //!< Latest snapshot (NULL if none)
+    atomic_int acquiring; //!< Number of readers acquiring a snapshot
+    struct Snapshot *retired; //!< Replaced snapshots awaiting reclamation
+};
+
+/**
+ * @brief Frees a snapshot.
+ * @param [in] snap The snapshot to free.
+ */
+static void
+publish_snapshot_free(struct Snapshot *snap)
+{
+    frozen_close(&snap->frozen);
+    free(snap);
+}
+
+/**
+ * @brief Frees the retired snapshots that can no longer be read.
+ * @details A reader that has loaded a retired snapshot pointer has either
+ * incremented its reference count or is still counted as acquiring.
+ * @param [in] pub The published snapshots.
+ */
+static void
+publish_reclaim(struct Publish *pub)
+{
+    if (atomic_load(&pub->acquiring) != 0) {
+        return;
+    }
+    struct Snapshot **iter = &pub->retired;
+    while (*iter != NULL) {
+        struct Snapshot *snap = *iter;
+        if (atomic_load(&snap->refs) == 0) {
+            *iter = snap->next;
+            publish_snapshot_free(snap);
+        } else {
+            iter = &snap->next;
+        }
+    }
+}
+
+/**
+ * @brief Initialises the published snapshots with none published.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+publish_init(struct XCSF *xcsf)
+{
+    struct Publish *pub = malloc(sizeof(struct Publish));
+    atomic_init(&pub->current, NULL);
+    atomic_init(&pub->acquiring, 0);
+    pub->retired = NULL;
+    xcsf->publish = pub;
+}
+
+/**
+ * @brief Frees all published snapshots.
+ * @details No reader may hold or be acquiring a snapshot.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+publish_free(struct XCSF *xcsf)
+{
+    struct Publish *pub = xcsf->publish;
+    if (pub == NULL) {
+        return;
+    }
+    struct Snapshot *snap = atomic_load(&pub->current);
+    if (snap != NULL) {
+        publish_snapshot_free(snap);
+    }
+    while (pub->retired != NULL) {
+        snap = pub->retired;
+        pub->retired = snap->next;
+        publish_snapshot_free(snap);
+    }
+    free(pub);
+    xcsf->publish = NULL;
+}
+
+/**
+ * @brief Publishes a snapshot of the current population.
+ * @details Must only be called by the thread training XCSF. The previous
+ * snapshot is retired and any unused retired snapshots are freed.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+publish_snapshot(const struct XCSF *xcsf)
+{
+    struct Publish *pub = xcsf->publish;
+    struct Snapshot *snap = malloc(sizeof(struct Snapshot));
+    frozen_init(&snap->frozen, xcsf);
+    atomic_init(&snap->refs, 0);
+    snap->next = NULL;
+    struct Snapshot *old = atomic_exchange(&pub->current, snap);
+    if (old != NULL) {
+        old->next = pub->retired;
+        pub->retired = old;
+    }
+    publish_reclaim(pub);
+}
+
+/**
+ * @brief Publishes a snapshot every PUBLISH_TRIALS trials.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] cnt The current trial number.
+ */
+void
+publish_trial(const struct XCSF *xcsf, const int cnt)
+{
+    if (xcsf->PUBLISH_TRIALS > 0 && (cnt + 1) % xcsf->PUBLISH_TRIALS == 0) {
+        publish_snapshot(xcsf);
+    }
+}
+
+/**
+ * @brief Checks that snapshots can be published before training starts.
+ * @details Published snapshots are frozen models, so if PUBLISH_TRIALS is
+ * enabled the condition, prediction, and action types must be supported by
+ * frozen_init(); the configuration is rejected here rather than when the
+ * first snapshot is published during training.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+publish_check(const struct XCSF *xcsf)
+{
+    if (xcsf->PUBLISH_TRIALS > 0 && !frozen_supported(xcsf)) {
+        printf("publish_check(): PUBLISH_TRIALS is unsupported with ");
+        printf("condition %s, prediction %s, action %s\n",
+               condition_type_as_string(xcsf->cond->type),
+               prediction_type_as_string(xcsf->pred->type),
+               action_type_as_string(xcsf->act->type));
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Acquires the latest published snapshot without locking.
+ * @details May be called from any thread. The snapshot remains valid until
+ * it is released with publish_release() and must not be modified.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The frozen model of the snapshot (NULL if none is published).
+ */
+struct Frozen *
+publish_acquire(const struct XCSF *xcsf)
+{
+    struct Publish *pub = xcsf->publish;
+    atomic_fetch_add(&pub->acquiring, 1);
+    struct Snapshot *snap = atomic_load(&pub->current);
+    if (snap != NULL) {
+        atomic_fetch_add(&snap->refs, 1);
+    }
+    atomic_fetch_sub(&pub->acquiring, 1);
+    return (snap != NULL) ? &snap->frozen : NULL;
+}
+
+/**
+ * @brief Releases a snapshot acquired with publish_acquire().
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] frozen The frozen model of the snapshot to release.
+ */
+void
+publish_release(const struct XCSF *xcsf, struct Frozen *frozen)
+{
+    (void) xcsf;
+    struct Snapshot *snap = (struct Snapshot *) frozen;
+    atomic_fetch_sub(&snap->refs, 1);
+}
+
+/**
+ * @brief Calculates predictions for the provided input using the latest
+ * published snapshot.
+ * @details May be called from any thread, including while XCSF is training.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] x The input feature variables.
+ * @param [out] pred The calculated predictions.
+ * @param [in] n_samples The number of instances.
+ * @return Whether a snapshot was published.
+ */
+bool
+publish_predict(const struct XCSF *xcsf, const double *x, double *pred,
+                const int n_samples)
+{
+    struct Frozen *frozen = publish_acquire(xcsf);
+    if (frozen == NULL) {
+        return false;
+    }
+    frozen_predict(frozen, x, pred, n_samples);
+    publish_release(xcsf, frozen);
+    return true;
+}
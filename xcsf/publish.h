@@ -0,0 +1,58 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file publish.h
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Published population snapshots for concurrent inference.
+ */
+
+#pragma once
+
+#include "frozen.h"
+#include "xcsf.h"
+
+/**
+ * @brief Published snapshots data structure.
+ * @details Opaque since its members are C11 atomics; see publish.c.
+ */
+struct Publish;
+
+bool
+publish_predict(const struct XCSF *xcsf, const double *x, double *pred,
+                const int n_samples);
+
+struct Frozen *
+publish_acquire(const struct XCSF *xcsf);
+
+void
+publish_check(const struct XCSF *xcsf);
+
+void
+publish_free(struct XCSF *xcsf);
+
+void
+publish_init(struct XCSF *xcsf);
+
+void
+publish_release(const struct XCSF *xcsf, struct Frozen *frozen);
+
+void
+publish_snapshot(const struct XCSF *xcsf);
+
+void
+publish_trial(const struct XCSF *xcsf, const int cnt);
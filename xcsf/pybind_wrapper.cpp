@@ -27,25 +27,104 @@
 
 #include "../lib/pybind11/include/pybind11/numpy.h"
 #include "../lib/pybind11/include/pybind11/pybind11.h"
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace py = pybind11;
 
+/**
+ * @brief NumPy array of doubles accepted without copying if already
+ * C-contiguous float64; other arrays are converted once on entry.
+ */
+typedef py::array_t<double, py::array::c_style | py::array::forcecast>
+    py_array;
+
+/**
+ * @brief NumPy array of ints converted to C-contiguous int if necessary.
+ */
+typedef py::array_t<int, py::array::c_style | py::array::forcecast>
+    py_array_int;
+
+/**
+ * @brief NumPy array of bools converted to C-contiguous bool if necessary.
+ */
+typedef py::array_t<bool, py::array::c_style | py::array::forcecast>
+    py_array_bool;
+
+/**
+ * @brief Returns the array to write predictions into.
+ * @details Returns a new array if out is None; otherwise out must be a
+ * writeable C-contiguous float64 array with the specified shape.
+ * @param [in] out The preallocated output array or None.
+ * @param [in] n_samples The number of rows.
+ * @param [in] n_cols The number of columns.
+ * @return The output array.
+ */
+static py::array_t<double, py::array::c_style>
+output_array(const py::object &out, const ptrdiff_t n_samples,
+             const ptrdiff_t n_cols)
+{
+    if (out.is_none()) {
+        return py::array_t<double, py::array::c_style>(
+            std::vector<ptrdiff_t>{ n_samples, n_cols });
+    }
+    if (!py::isinstance<py::array_t<double, py::array::c_style>>(out)) {
+        printf("error: out must be a C-contiguous float64 array\n");
+        exit(EXIT_FAILURE);
+    }
+    py::array_t<double, py::array::c_style> arr =
+        out.cast<py::array_t<double, py::array::c_style>>();
+    if (arr.ndim() != 2 || arr.shape(0) != n_samples ||
+        arr.shape(1) != n_cols) {
+        printf("error: out must have shape (%d, %d)\n", (int) n_samples,
+               (int) n_cols);
+        exit(EXIT_FAILURE);
+    }
+    return arr;
+}
+
+/**
+ * @brief Releases the GIL and then locks an XCS object for one call.
+ * @details The GIL is released before waiting for the lock and reacquired
+ * only after the lock is released, so a thread waiting for the object never
+ * holds the GIL needed by the thread using it.
+ */
+class XCSLock
+{
+  private:
+    py::gil_scoped_release release; //!< Released first, reacquired last
+    std::lock_guard<std::mutex> lock; //!< Held while the call runs
+
+  public:
+    /**
+     * @brief Releases the GIL and locks the specified mutex.
+     * @param [in] mtx The mutex of the XCS object.
+     */
+    explicit XCSLock(std::mutex &mtx) : lock(mtx)
+    {
+    }
+};
+
 extern "C" {
 #include "action.h"
+#include "checkpoint.h"
 #include "clset.h"
 #include "clset_neural.h"
+#include "codegen.h"
 #include "condition.h"
 #include "config.h"
 #include "dgp.h"
 #include "ea.h"
+#include "frozen.h"
 #include "gp.h"
 #include "neural_activations.h"
 #include "neural_layer.h"
 #include "pa.h"
 #include "param.h"
 #include "prediction.h"
+#include "prof.h"
+#include "publish.h"
 #include "utils.h"
 #include "xcs_rl.h"
 #include "xcs_supervised.h"
@@ -58,11 +137,34 @@ class XCS
 {
   private:
     struct XCSF xcs; //!< XCSF data structure
-    double *state; //!< Current input state for RL
+    std::vector<double> state; //!< Current input state for RL
     int action; //!< Current action for RL
     double payoff; //!< Current reward for RL
     struct Input *train_data; //!< Training data for supervised learning
     struct Input *test_data; //!< Test data for supervised learning
+    mutable std::mutex mtx; //!< Serialises calls using the above
+
+    /**
+     * @brief Initialises the reinforcement and supervised learning inputs.
+     */
+    void
+    init_inputs(void)
+    {
+        action = 0;
+        payoff = 0;
+        train_data = (struct Input *) malloc(sizeof(struct Input));
+        train_data->n_samples = 0;
+        train_data->x_dim = 0;
+        train_data->y_dim = 0;
+        train_data->x = NULL;
+        train_data->y = NULL;
+        test_data = (struct Input *) malloc(sizeof(struct Input));
+        test_data->n_samples = 0;
+        test_data->x_dim = 0;
+        test_data->y_dim = 0;
+        test_data->x = NULL;
+        test_data->y = NULL;
+    }
 
   public:
     /**
@@ -90,21 +192,23 @@ class XCS
         config_read(&xcs, filename);
         xcsf_init(&xcs);
         pa_init(&xcs);
-        state = NULL;
-        action = 0;
-        payoff = 0;
-        train_data = (struct Input *) malloc(sizeof(struct Input));
-        train_data->n_samples = 0;
-        train_data->x_dim = 0;
-        train_data->y_dim = 0;
-        train_data->x = NULL;
-        train_data->y = NULL;
-        test_data = (struct Input *) malloc(sizeof(struct Input));
-        test_data->n_samples = 0;
-        test_data->x_dim = 0;
-        test_data->y_dim = 0;
-        test_data->x = NULL;
-        test_data->y = NULL;
+        init_inputs();
+    }
+
+    /**
+     * @brief Constructor restoring a state serialised with to_bytes().
+     * @param [in] data The serialised state of XCSF.
+     */
+    explicit XCS(const py::bytes &data)
+    {
+        char *buf = NULL;
+        Py_ssize_t len = 0;
+        PyBytes_AsStringAndSize(data.ptr(), &buf, &len);
+        param_init(&xcs, 1, 1, 1);
+        xcsf_init(&xcs);
+        xcsf_deserialise(&xcs, buf, len);
+        pa_init(&xcs);
+        init_inputs();
     }
 
     /**
@@ -145,18 +249,185 @@ class XCS
     size_t
     save(const char *filename)
     {
+        XCSLock lock(mtx);
         return xcsf_save(&xcs, filename);
     }
 
     /**
      * @brief Reads the entire current state of XCSF from a file.
+     * @details If the file is a checkpoint, the next call to fit() resumes
+     * the interrupted run from the checkpointed trial.
      * @param [in] filename String containing the name of the input file.
      * @return The total number of elements read.
      */
     size_t
     load(const char *filename)
     {
-        return xcsf_load(&xcs, filename);
+        XCSLock lock(mtx);
+        return checkpoint_load(&xcs, filename);
+    }
+
+    /**
+     * @brief Merges the populations saved in several files into the current.
+     * @details Duplicate rules are combined by summing their numerosity and
+     * the population size limit is enforced with the usual deletion.
+     * @param [in] filenames List of the names of the files to merge.
+     */
+    void
+    merge(const py::list &filenames)
+    {
+        std::vector<std::string> names;
+        for (const auto &item : filenames) {
+            names.push_back(item.cast<std::string>());
+        }
+        std::vector<const char *> ptrs;
+        for (const auto &name : names) {
+            ptrs.push_back(name.c_str());
+        }
+        XCSLock lock(mtx);
+        xcsf_merge(&xcs, ptrs.data(), (int) ptrs.size());
+    }
+
+    /**
+     * @brief Enables periodic checkpointing of training runs to a file.
+     * @param [in] filename String containing the name of the output file.
+     */
+    void
+    checkpoint(const char *filename)
+    {
+        XCSLock lock(mtx);
+        checkpoint_init(&xcs, filename);
+    }
+
+    /**
+     * @brief Publishes a snapshot of the current population for
+     * predict_published().
+     * @details Waits for any call running on the object to return since the
+     * snapshot is copied from the population.
+     */
+    void
+    publish(void)
+    {
+        XCSLock lock(mtx);
+        publish_snapshot(&xcs);
+    }
+
+    /**
+     * @brief Returns the per-phase timers and event counters.
+     * @details Only recorded while PROFILE is enabled.
+     * @return Dictionary of phase timers, event counts and set size
+     * histograms.
+     */
+    py::dict
+    profile(void) const
+    {
+        XCSLock lock(mtx);
+        py::gil_scoped_acquire acquire; // building the dictionary
+        const struct Prof *prof = xcs.prof;
+        py::dict phases;
+        for (int i = 0; i < PROF_PHASES; ++i) {
+            py::dict phase;
+            phase["calls"] = prof->calls[i];
+            phase["time"] = prof->time[i];
+            phase["self_time"] = prof->self[i];
+            phase["classifiers"] = prof->items[i];
+            if (xcs.PROFILE_HW && prof->hw_state == 1) {
+                for (int j = 0; j < PROF_COUNTERS; ++j) {
+                    phase[prof_counter_as_string(j)] = prof->hw[i][j];
+                }
+            }
+            phases[prof_phase_as_string(i)] = phase;
+        }
+        py::dict events;
+        for (int i = 0; i < PROF_EVENTS; ++i) {
+            events[prof_event_as_string(i)] = prof->events[i];
+        }
+        py::list mset_hist;
+        py::list aset_hist;
+        for (int i = 0; i < PROF_HIST_BINS; ++i) {
+            mset_hist.append(prof->hist[PROF_HIST_MSET][i]);
+            aset_hist.append(prof->hist[PROF_HIST_ASET][i]);
+        }
+        py::dict d;
+        d["phases"] = phases;
+        d["events"] = events;
+        d["mset_hist"] = mset_hist;
+        d["aset_hist"] = aset_hist;
+        return d;
+    }
+
+    /**
+     * @brief Resets the per-phase timers and event counters to zero.
+     */
+    void
+    profile_reset(void)
+    {
+        XCSLock lock(mtx);
+        prof_reset(&xcs);
+    }
+
+    /**
+     * @brief Writes the most recent trace spans in the Chrome trace format.
+     * @details Only recorded while TRACE_SIZE is greater than zero.
+     * @param [in] filename Name of the file to write.
+     */
+    void
+    trace_save(const char *filename) const
+    {
+        XCSLock lock(mtx);
+        prof_trace_save(&xcs, filename);
+    }
+
+    /**
+     * @brief Returns the entire current state of XCSF serialised in memory.
+     * @return The serialised state.
+     */
+    py::bytes
+    to_bytes(void) const
+    {
+        char *buf = NULL;
+        size_t len = 0;
+        {
+            XCSLock lock(mtx);
+            xcsf_serialise(&xcs, &buf, &len);
+        }
+        py::bytes data(buf, len);
+        free(buf);
+        return data;
+    }
+
+    /**
+     * @brief Creates a new XCSF from a state serialised with to_bytes().
+     * @param [in] data The serialised state of XCSF.
+     * @return The restored XCSF.
+     */
+    static XCS *
+    from_bytes(const py::bytes &data)
+    {
+        return new XCS(data);
+    }
+
+    /**
+     * @brief Writes the current population to a memory-mappable frozen model.
+     * @param [in] filename String containing the name of the output file.
+     * @return The number of bytes written.
+     */
+    size_t
+    export_frozen(const char *filename)
+    {
+        XCSLock lock(mtx);
+        return frozen_export(&xcs, filename);
+    }
+
+    /**
+     * @brief Writes the current population as a standalone C source file.
+     * @param [in] filename String containing the name of the output file.
+     */
+    void
+    export_c(const char *filename)
+    {
+        XCSLock lock(mtx);
+        codegen_export(&xcs, filename);
     }
 
     /**
@@ -165,6 +436,7 @@ class XCS
     void
     store(void)
     {
+        XCSLock lock(mtx);
         xcsf_store_pset(&xcs);
     }
 
@@ -174,6 +446,7 @@ class XCS
     void
     retrieve(void)
     {
+        XCSLock lock(mtx);
         xcsf_retrieve_pset(&xcs);
     }
 
@@ -183,6 +456,7 @@ class XCS
     void
     print_params(void)
     {
+        XCSLock lock(mtx);
         param_print(&xcs);
     }
 
@@ -193,6 +467,7 @@ class XCS
     void
     pred_expand(void)
     {
+        XCSLock lock(mtx);
         xcsf_pred_expand(&xcs);
     }
 
@@ -204,6 +479,7 @@ class XCS
     void
     ae_to_classifier(const int y_dim, const int n_del)
     {
+        XCSLock lock(mtx);
         xcsf_ae_to_classifier(&xcs, y_dim, n_del);
     }
 
@@ -217,6 +493,7 @@ class XCS
     print_pset(const bool print_cond, const bool print_act,
                const bool print_pred)
     {
+        XCSLock lock(mtx);
         xcsf_print_pset(&xcs, print_cond, print_act, print_pred);
     }
 
@@ -230,11 +507,70 @@ class XCS
      * @return The prediction error.
      */
     double
-    fit(const py::array_t<double> input, const int action, const double reward)
+    fit(const py_array input, const int action, const double reward)
     {
-        py::buffer_info buf = input.request();
-        state = (double *) buf.ptr;
-        return xcs_rl_fit(&xcs, state, action, reward);
+        XCSLock lock(mtx);
+        state.assign(input.data(), input.data() + input.size());
+        return xcs_rl_fit(&xcs, state.data(), action, reward);
+    }
+
+    /**
+     * @brief Updates the action sets for a batch of transitions.
+     * @param [in] states The input states.
+     * @param [in] actions The actions performed.
+     * @param [in] rewards The rewards received.
+     * @param [in] next_states The resulting states.
+     * @param [in] dones Whether each resulting state is terminal.
+     * @return The mean prediction error.
+     */
+    double
+    fit_batch(const py_array states, const py_array_int actions,
+              const py_array rewards, const py_array next_states,
+              const py_array_bool dones)
+    {
+        XCSLock lock(mtx);
+        const int n = states.shape(0);
+        if (states.ndim() != 2 || next_states.ndim() != 2 ||
+            states.shape(1) != xcs.x_dim || next_states.shape(1) != xcs.x_dim) {
+            printf("error: states do not match x_dim\n");
+            exit(EXIT_FAILURE);
+        }
+        if (next_states.shape(0) != n || actions.size() != n ||
+            rewards.size() != n || dones.size() != n) {
+            printf("error: transition arrays are not of equal length\n");
+            exit(EXIT_FAILURE);
+        }
+        if (xcs.time == 0) {
+            clset_pset_init(&xcs);
+        }
+        return xcs_rl_fit_batch(&xcs, states.data(), actions.data(),
+                                rewards.data(), next_states.data(),
+                                dones.data(), n);
+    }
+
+    /**
+     * @brief Selects actions to perform for a batch of states.
+     * @param [in] states The input states.
+     * @param [in] explore Whether these are exploration steps.
+     * @return The selected actions.
+     */
+    py::array_t<int>
+    decision_batch(const py_array states, const bool explore)
+    {
+        const int n = states.shape(0);
+        py::array_t<int> actions(n);
+        int *a = actions.mutable_data();
+        const double *x = states.data();
+        {
+            XCSLock lock(mtx);
+            if (states.ndim() != 2 || states.shape(1) != xcs.x_dim) {
+                printf("error: states do not match x_dim\n");
+                exit(EXIT_FAILURE);
+            }
+            param_set_explore(&xcs, explore);
+            xcs_rl_decision_batch(&xcs, x, a, n);
+        }
+        return actions;
     }
 
     /**
@@ -243,6 +579,7 @@ class XCS
     void
     init_trial(void)
     {
+        XCSLock lock(mtx);
         if (xcs.time == 0) {
             clset_pset_init(&xcs);
         }
@@ -255,6 +592,7 @@ class XCS
     void
     end_trial(void)
     {
+        XCSLock lock(mtx);
         xcs_rl_end_trial(&xcs);
     }
 
@@ -264,6 +602,7 @@ class XCS
     void
     init_step(void)
     {
+        XCSLock lock(mtx);
         xcs_rl_init_step(&xcs);
     }
 
@@ -273,7 +612,8 @@ class XCS
     void
     end_step(void)
     {
-        xcs_rl_end_step(&xcs, state, action, payoff);
+        XCSLock lock(mtx);
+        xcs_rl_end_step(&xcs, state.data(), action, payoff);
     }
 
     /**
@@ -284,12 +624,12 @@ class XCS
      * @return The selected action.
      */
     int
-    decision(const py::array_t<double> input, const bool explore)
+    decision(const py_array input, const bool explore)
     {
-        py::buffer_info buf = input.request();
-        state = (double *) buf.ptr;
+        XCSLock lock(mtx);
+        state.assign(input.data(), input.data() + input.size());
         param_set_explore(&xcs, explore);
-        action = xcs_rl_decision(&xcs, state);
+        action = xcs_rl_decision(&xcs, state.data());
         return action;
     }
 
@@ -302,8 +642,9 @@ class XCS
     void
     update(const double reward, const bool done)
     {
+        XCSLock lock(mtx);
         payoff = reward;
-        xcs_rl_update(&xcs, state, action, payoff, done);
+        xcs_rl_update(&xcs, state.data(), action, payoff, done);
     }
 
     /**
@@ -316,6 +657,7 @@ class XCS
     double
     error(const double reward, const bool done, const double max_p)
     {
+        XCSLock lock(mtx);
         payoff = reward;
         return xcs_rl_error(&xcs, action, payoff, done, max_p);
     }
@@ -331,8 +673,7 @@ class XCS
      * @return The average XCSF training error using the loss function.
      */
     double
-    fit(const py::array_t<double> train_X, const py::array_t<double> train_Y,
-        const bool shuffle)
+    fit(const py_array train_X, const py_array train_Y, const bool shuffle)
     {
         const py::buffer_info buf_x = train_X.request();
         const py::buffer_info buf_y = train_Y.request();
@@ -340,6 +681,8 @@ class XCS
             printf("error: training X and Y n_samples are not equal\n");
             exit(EXIT_FAILURE);
         }
+        // execute without holding the GIL
+        XCSLock lock(mtx);
         // load training data
         train_data->n_samples = buf_x.shape[0];
         train_data->x_dim = buf_x.shape[1];
@@ -350,7 +693,6 @@ class XCS
         if (xcs.time == 0) {
             clset_pset_init(&xcs);
         }
-        // execute
         return xcs_supervised_fit(&xcs, train_data, NULL, shuffle);
     }
 
@@ -365,9 +707,8 @@ class XCS
      * @return The average XCSF training error using the loss function.
      */
     double
-    fit(const py::array_t<double> train_X, const py::array_t<double> train_Y,
-        const py::array_t<double> test_X, const py::array_t<double> test_Y,
-        const bool shuffle)
+    fit(const py_array train_X, const py_array train_Y, const py_array test_X,
+        const py_array test_Y, const bool shuffle)
     {
         const py::buffer_info buf_train_x = train_X.request();
         const py::buffer_info buf_train_y = train_Y.request();
@@ -389,6 +730,8 @@ class XCS
             printf("error: number of train and test Y cols are not equal\n");
             exit(EXIT_FAILURE);
         }
+        // execute without holding the GIL
+        XCSLock lock(mtx);
         // load training data
         train_data->n_samples = buf_train_x.shape[0];
         train_data->x_dim = buf_train_x.shape[1];
@@ -405,29 +748,94 @@ class XCS
         if (xcs.time == 0) {
             clset_pset_init(&xcs);
         }
-        // execute
         return xcs_supervised_fit(&xcs, train_data, test_data, shuffle);
     }
 
+    /**
+     * @brief Executes up to MAX_TRIALS number of XCSF learning iterations
+     * using training data streamed from disk.
+     * @details Files ending in ".csv" are read as comma separated values,
+     * otherwise as raw row-major float64 values with x_dim and y_dim columns.
+     * @param [in] fname_x The name of the file containing the input values.
+     * @param [in] fname_y The name of the file containing the output values.
+     * @param [in] shuffle Whether to randomise the instances during training.
+     * @param [in] buffer_size The number of instances in the shuffle buffer.
+     * @return The average XCSF training error using the loss function.
+     */
+    double
+    fit_stream(const std::string &fname_x, const std::string &fname_y,
+               const bool shuffle, const int buffer_size)
+    {
+        const std::string ext = ".csv";
+        const bool csv = fname_x.size() > ext.size() &&
+            fname_x.compare(fname_x.size() - ext.size(), ext.size(), ext) == 0;
+        // execute without holding the GIL
+        XCSLock lock(mtx);
+        struct Stream stream;
+        stream_init(&stream, fname_x.c_str(), fname_y.c_str(),
+                    csv ? STREAM_CSV : STREAM_BINARY, xcs.x_dim, xcs.y_dim,
+                    buffer_size, buffer_size, shuffle, true);
+        // first execution
+        if (xcs.time == 0) {
+            clset_pset_init(&xcs);
+        }
+        const double err = xcs_supervised_fit_stream(&xcs, &stream, NULL);
+        stream_free(&stream);
+        return err;
+    }
+
     /**
      * @brief Returns the XCSF prediction array for the provided input.
      * @param [in] x The input variables.
+     * @param [in] out Optional preallocated array to write the predictions.
      * @return The prediction array values.
      */
-    py::array_t<double>
-    predict(const py::array_t<double> x)
+    py::array_t<double, py::array::c_style>
+    predict(const py_array x, const py::object &out)
     {
         // inputs to predict
-        const py::buffer_info buf_x = x.request();
-        const int n_samples = buf_x.shape[0];
-        const double *input = (double *) buf_x.ptr;
+        const int n_samples = x.shape(0);
+        const double *input = x.data();
         // predicted outputs
-        double *output =
-            (double *) malloc(sizeof(double) * n_samples * xcs.pa_size);
-        xcs_supervised_predict(&xcs, input, output, n_samples);
-        // return numpy array
-        return py::array_t<double>(
-            std::vector<ptrdiff_t>{ n_samples, xcs.pa_size }, output);
+        py::array_t<double, py::array::c_style> output;
+        {
+            XCSLock lock(mtx);
+            double *pred = NULL;
+            {
+                py::gil_scoped_acquire acquire; // creating the output
+                output = output_array(out, n_samples, xcs.pa_size);
+                pred = output.mutable_data();
+            }
+            xcs_supervised_predict(&xcs, input, pred, n_samples);
+        }
+        return output;
+    }
+
+    /**
+     * @brief Returns the prediction array of the latest published snapshot.
+     * @details May be called from other threads while fit() is running.
+     * @param [in] x The input variables.
+     * @param [in] out Optional preallocated array to write the predictions.
+     * @return The prediction array values.
+     */
+    py::array_t<double, py::array::c_style>
+    predict_published(const py_array x, const py::object &out)
+    {
+        const int n_samples = x.shape(0);
+        const double *input = x.data();
+        py::array_t<double, py::array::c_style> output =
+            output_array(out, n_samples, xcs.pa_size);
+        double *pred = output.mutable_data();
+        bool published = false;
+        {
+            py::gil_scoped_release release;
+            published = publish_predict(&xcs, input, pred, n_samples);
+        }
+        if (!published) {
+            printf("error: no snapshot has been published\n");
+            exit(EXIT_FAILURE);
+        }
+        return output;
     }
 
     /**
@@ -437,7 +845,7 @@ class XCS
      * @return The average XCSF error using the loss function.
      */
     double
-    score(const py::array_t<double> test_X, const py::array_t<double> test_Y)
+    score(const py_array test_X, const py_array test_Y)
     {
         return score(test_X, test_Y, 0);
     }
@@ -450,8 +858,7 @@ class XCS
      * @return The average XCSF error using the loss function.
      */
     double
-    score(const py::array_t<double> test_X, const py::array_t<double> test_Y,
-          const int N)
+    score(const py_array test_X, const py_array test_Y, const int N)
     {
         const py::buffer_info buf_x = test_X.request();
         const py::buffer_info buf_y = test_Y.request();
@@ -459,6 +866,7 @@ class XCS
             printf("error: training X and Y n_samples are not equal\n");
             exit(EXIT_FAILURE);
         }
+        XCSLock lock(mtx);
         test_data->n_samples = buf_x.shape[0];
         test_data->x_dim = buf_x.shape[1];
         test_data->y_dim = buf_y.shape[1];
@@ -479,309 +887,474 @@ class XCS
     double
     error(void)
     {
+        XCSLock lock(mtx);
         return xcs.error;
     }
 
     int
     get_omp_num_threads(void)
     {
+        XCSLock lock(mtx);
         return xcs.OMP_NUM_THREADS;
     }
 
     bool
     get_pop_init(void)
     {
+        XCSLock lock(mtx);
         return xcs.POP_INIT;
     }
 
     int
     get_max_trials(void)
     {
+        XCSLock lock(mtx);
         return xcs.MAX_TRIALS;
     }
 
     int
     get_perf_trials(void)
     {
+        XCSLock lock(mtx);
         return xcs.PERF_TRIALS;
     }
 
+    int
+    get_checkpoint_trials(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.CHECKPOINT_TRIALS;
+    }
+
+    int
+    get_publish_trials(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.PUBLISH_TRIALS;
+    }
+
+    bool
+    get_profile(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.PROFILE;
+    }
+
+    bool
+    get_profile_hw(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.PROFILE_HW;
+    }
+
+    int
+    get_trace_size(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.TRACE_SIZE;
+    }
+
     int
     get_pop_max_size(void)
     {
+        XCSLock lock(mtx);
         return xcs.POP_SIZE;
     }
 
+    int
+    get_pop_mem_size(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.POP_MEM_SIZE;
+    }
+
+    int
+    get_islands(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.ISLANDS;
+    }
+
+    int
+    get_migration_trials(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.MIGRATION_TRIALS;
+    }
+
+    int
+    get_migration_size(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.MIGRATION_SIZE;
+    }
+
     const char *
     get_loss_func(void)
     {
+        XCSLock lock(mtx);
         return loss_type_as_string(xcs.LOSS_FUNC);
     }
 
     double
     get_huber_delta(void)
     {
+        XCSLock lock(mtx);
         return xcs.HUBER_DELTA;
     }
 
     double
     get_alpha(void)
     {
+        XCSLock lock(mtx);
         return xcs.ALPHA;
     }
 
     double
     get_beta(void)
     {
+        XCSLock lock(mtx);
         return xcs.BETA;
     }
 
     double
     get_delta(void)
     {
+        XCSLock lock(mtx);
         return xcs.DELTA;
     }
 
     double
     get_e0(void)
     {
+        XCSLock lock(mtx);
         return xcs.E0;
     }
 
     double
     get_init_error(void)
     {
+        XCSLock lock(mtx);
         return xcs.INIT_ERROR;
     }
 
     double
     get_init_fitness(void)
     {
+        XCSLock lock(mtx);
         return xcs.INIT_FITNESS;
     }
 
     double
     get_nu(void)
     {
+        XCSLock lock(mtx);
         return xcs.NU;
     }
 
     int
     get_m_probation(void)
     {
+        XCSLock lock(mtx);
         return xcs.M_PROBATION;
     }
 
     bool
     get_stateful(void)
     {
+        XCSLock lock(mtx);
         return xcs.STATEFUL;
     }
 
     bool
     get_compaction(void)
     {
+        XCSLock lock(mtx);
         return xcs.COMPACTION;
     }
 
     int
     get_theta_del(void)
     {
+        XCSLock lock(mtx);
         return xcs.THETA_DEL;
     }
 
     int
     get_theta_sub(void)
     {
+        XCSLock lock(mtx);
         return xcs.THETA_SUB;
     }
 
     bool
     get_set_subsumption(void)
     {
+        XCSLock lock(mtx);
         return xcs.SET_SUBSUMPTION;
     }
 
     int
     get_pset_size(void)
     {
+        XCSLock lock(mtx);
         return xcs.pset.size;
     }
 
     int
     get_pset_num(void)
     {
+        XCSLock lock(mtx);
         return xcs.pset.num;
     }
 
     int
     get_time(void)
     {
+        XCSLock lock(mtx);
         return xcs.time;
     }
 
     double
     get_x_dim(void)
     {
+        XCSLock lock(mtx);
         return xcs.x_dim;
     }
 
     double
     get_y_dim(void)
     {
+        XCSLock lock(mtx);
         return xcs.y_dim;
     }
 
     double
     get_n_actions(void)
     {
+        XCSLock lock(mtx);
         return xcs.n_actions;
     }
 
     double
     get_pset_mean_cond_size(void)
     {
+        XCSLock lock(mtx);
         return clset_mean_cond_size(&xcs, &xcs.pset);
     }
 
     double
     get_pset_mean_pred_size(void)
     {
+        XCSLock lock(mtx);
         return clset_mean_pred_size(&xcs, &xcs.pset);
     }
 
     double
     get_pset_mean_pred_eta(const int layer)
     {
+        XCSLock lock(mtx);
         return clset_mean_pred_eta(&xcs, &xcs.pset, layer);
     }
 
     double
     get_pset_mean_pred_neurons(const int layer)
     {
+        XCSLock lock(mtx);
         return clset_mean_pred_neurons(&xcs, &xcs.pset, layer);
     }
 
     double
     get_pset_mean_pred_connections(const int layer)
     {
+        XCSLock lock(mtx);
         return clset_mean_pred_connections(&xcs, &xcs.pset, layer);
     }
 
     double
     get_pset_mean_pred_layers(void)
     {
+        XCSLock lock(mtx);
         return clset_mean_pred_layers(&xcs, &xcs.pset);
     }
 
     double
     get_pset_mean_cond_connections(const int layer)
     {
+        XCSLock lock(mtx);
         return clset_mean_cond_connections(&xcs, &xcs.pset, layer);
     }
 
     double
     get_pset_mean_cond_neurons(const int layer)
     {
+        XCSLock lock(mtx);
         return clset_mean_cond_neurons(&xcs, &xcs.pset, layer);
     }
 
     double
     get_pset_mean_cond_layers(void)
     {
+        XCSLock lock(mtx);
         return clset_mean_cond_layers(&xcs, &xcs.pset);
     }
 
+    /**
+     * @brief Returns the memory used by the population set.
+     * @return Dictionary of bytes used by the list nodes, classifier
+     * structures, conditions, predictions, actions, and in total.
+     */
+    py::dict
+    get_pset_mem_size(void) const
+    {
+        struct SetMemSize size;
+        {
+            XCSLock lock(mtx);
+            clset_mem_size(&xcs, &xcs.pset, &size);
+        }
+        py::dict d;
+        d["list"] = size.list;
+        d["cl"] = size.cl;
+        d["cond"] = size.cond;
+        d["pred"] = size.pred;
+        d["act"] = size.act;
+        d["total"] = size.total;
+        return d;
+    }
+
     double
     get_mset_size(void)
     {
+        XCSLock lock(mtx);
         return xcs.mset_size;
     }
 
     double
     get_aset_size(void)
     {
+        XCSLock lock(mtx);
         return xcs.aset_size;
     }
 
     double
     get_mfrac(void)
     {
+        XCSLock lock(mtx);
         return xcs.mfrac;
     }
 
     int
     get_teletransportation(void)
     {
+        XCSLock lock(mtx);
         return xcs.TELETRANSPORTATION;
     }
 
+    int
+    get_replay_size(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.REPLAY_SIZE;
+    }
+
+    int
+    get_replay_batch(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.REPLAY_BATCH;
+    }
+
+    int
+    get_n_envs(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.N_ENVS;
+    }
+
     double
     get_gamma(void)
     {
+        XCSLock lock(mtx);
         return xcs.GAMMA;
     }
 
     double
     get_p_explore(void)
     {
+        XCSLock lock(mtx);
         return xcs.P_EXPLORE;
     }
 
     int
     get_ea_select_type(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->select_type;
     }
 
     double
     get_ea_select_size(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->select_size;
     }
 
     double
     get_theta_ea(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->theta;
     }
 
     int
     get_lambda(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->lambda;
     }
 
     double
     get_p_crossover(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->p_crossover;
     }
 
     double
     get_err_reduc(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->err_reduc;
     }
 
     double
     get_fit_reduc(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->fit_reduc;
     }
 
     bool
     get_ea_subsumption(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->subsumption;
     }
 
     bool
     get_ea_pred_reset(void)
     {
+        XCSLock lock(mtx);
         return xcs.ea->pred_reset;
     }
 
+    bool
+    get_ea_async(void)
+    {
+        XCSLock lock(mtx);
+        return xcs.ea->async;
+    }
+
     /* SETTERS */
 
     /**
@@ -791,6 +1364,7 @@ class XCS
     void
     set_condition(const std::string &type)
     {
+        XCSLock lock(mtx);
         cond_param_set_type_string(&xcs, type.c_str());
     }
 
@@ -801,6 +1375,7 @@ class XCS
     void
     set_action(const std::string &type)
     {
+        XCSLock lock(mtx);
         action_param_set_type_string(&xcs, type.c_str());
     }
 
@@ -811,6 +1386,7 @@ class XCS
     void
     set_prediction(const std::string &type)
     {
+        XCSLock lock(mtx);
         pred_param_set_type_string(&xcs, type.c_str());
     }
 
@@ -822,6 +1398,8 @@ class XCS
     void
     set_condition(const std::string &type, const py::dict &args)
     {
+        XCSLock lock(mtx);
+        py::gil_scoped_acquire acquire; // unpacking the arguments
         cond_param_set_type_string(&xcs, type.c_str());
         switch (xcs.cond->type) {
             case COND_TYPE_HYPERRECTANGLE:
@@ -1051,6 +1629,8 @@ class XCS
     void
     set_action(const std::string &type, const py::dict &args)
     {
+        XCSLock lock(mtx);
+        py::gil_scoped_acquire acquire; // unpacking the arguments
         action_param_set_type_string(&xcs, type.c_str());
         if (xcs.act->type == ACT_TYPE_NEURAL) {
             unpack_act_neural(args);
@@ -1091,6 +1671,8 @@ class XCS
     void
     set_prediction(const std::string &type, const py::dict &args)
     {
+        XCSLock lock(mtx);
+        py::gil_scoped_acquire acquire; // unpacking the arguments
         pred_param_set_type_string(&xcs, type.c_str());
         switch (xcs.pred->type) {
             case PRED_TYPE_NLMS_LINEAR:
@@ -1184,213 +1766,390 @@ class XCS
     void
     set_omp_num_threads(const int a)
     {
+        XCSLock lock(mtx);
         param_set_omp_num_threads(&xcs, a);
     }
 
     void
     set_pop_init(const bool a)
     {
+        XCSLock lock(mtx);
         param_set_pop_init(&xcs, a);
     }
 
     void
     set_max_trials(const int a)
     {
+        XCSLock lock(mtx);
         param_set_max_trials(&xcs, a);
     }
 
     void
     set_perf_trials(const int a)
     {
+        XCSLock lock(mtx);
         param_set_perf_trials(&xcs, a);
     }
 
+    void
+    set_checkpoint_trials(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_checkpoint_trials(&xcs, a);
+    }
+
+    void
+    set_publish_trials(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_publish_trials(&xcs, a);
+    }
+
+    void
+    set_profile(const bool a)
+    {
+        XCSLock lock(mtx);
+        param_set_profile(&xcs, a);
+    }
+
+    void
+    set_profile_hw(const bool a)
+    {
+        XCSLock lock(mtx);
+        param_set_profile_hw(&xcs, a);
+    }
+
+    void
+    set_trace_size(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_trace_size(&xcs, a);
+    }
+
     void
     set_pop_max_size(const int a)
     {
+        XCSLock lock(mtx);
         param_set_pop_size(&xcs, a);
     }
 
+    void
+    set_pop_mem_size(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_pop_mem_size(&xcs, a);
+    }
+
+    void
+    set_islands(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_islands(&xcs, a);
+    }
+
+    void
+    set_migration_trials(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_migration_trials(&xcs, a);
+    }
+
+    void
+    set_migration_size(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_migration_size(&xcs, a);
+    }
+
     void
     set_loss_func(const char *a)
     {
+        XCSLock lock(mtx);
         param_set_loss_func_string(&xcs, a);
     }
 
     void
     set_huber_delta(const double a)
     {
+        XCSLock lock(mtx);
         param_set_huber_delta(&xcs, a);
     }
 
     void
     set_alpha(const double a)
     {
+        XCSLock lock(mtx);
         param_set_alpha(&xcs, a);
     }
 
     void
     set_beta(const double a)
     {
+        XCSLock lock(mtx);
         param_set_beta(&xcs, a);
     }
 
     void
     set_delta(const double a)
     {
+        XCSLock lock(mtx);
         param_set_delta(&xcs, a);
     }
 
     void
     set_e0(const double a)
     {
+        XCSLock lock(mtx);
         param_set_e0(&xcs, a);
     }
 
     void
     set_init_error(const double a)
     {
+        XCSLock lock(mtx);
         param_set_init_error(&xcs, a);
     }
 
     void
     set_init_fitness(const double a)
     {
+        XCSLock lock(mtx);
         param_set_init_fitness(&xcs, a);
     }
 
     void
     set_nu(const double a)
     {
+        XCSLock lock(mtx);
         param_set_nu(&xcs, a);
     }
 
     void
     set_m_probation(const int a)
     {
+        XCSLock lock(mtx);
         param_set_m_probation(&xcs, a);
     }
 
     void
     set_theta_del(const int a)
     {
+        XCSLock lock(mtx);
         param_set_theta_del(&xcs, a);
     }
 
     void
     set_theta_sub(const int a)
     {
+        XCSLock lock(mtx);
         param_set_theta_sub(&xcs, a);
     }
 
     void
     set_set_subsumption(const bool a)
     {
+        XCSLock lock(mtx);
         param_set_set_subsumption(&xcs, a);
     }
 
     void
     set_teletransportation(const int a)
     {
+        XCSLock lock(mtx);
         param_set_teletransportation(&xcs, a);
     }
 
+    void
+    set_replay_size(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_replay_size(&xcs, a);
+    }
+
+    void
+    set_replay_batch(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_replay_batch(&xcs, a);
+    }
+
+    void
+    set_n_envs(const int a)
+    {
+        XCSLock lock(mtx);
+        param_set_n_envs(&xcs, a);
+    }
+
     void
     set_stateful(const bool a)
     {
+        XCSLock lock(mtx);
         param_set_stateful(&xcs, a);
     }
 
     void
     set_compaction(const bool a)
     {
+        XCSLock lock(mtx);
         param_set_compaction(&xcs, a);
     }
 
     void
     set_gamma(const double a)
     {
+        XCSLock lock(mtx);
         param_set_gamma(&xcs, a);
     }
 
     void
     set_p_explore(const double a)
     {
+        XCSLock lock(mtx);
         param_set_p_explore(&xcs, a);
     }
 
     void
     set_ea_select_type(const char *a)
     {
+        XCSLock lock(mtx);
         ea_param_set_type_string(&xcs, a);
     }
 
     void
     set_ea_select_size(const double a)
     {
+        XCSLock lock(mtx);
         ea_param_set_select_size(&xcs, a);
     }
 
     void
     set_theta_ea(const double a)
     {
+        XCSLock lock(mtx);
         ea_param_set_theta(&xcs, a);
     }
 
     void
     set_lambda(const int a)
     {
+        XCSLock lock(mtx);
         ea_param_set_lambda(&xcs, a);
     }
 
     void
     set_p_crossover(const double a)
     {
+        XCSLock lock(mtx);
         ea_param_set_p_crossover(&xcs, a);
     }
 
     void
     set_err_reduc(const double a)
     {
+        XCSLock lock(mtx);
         ea_param_set_err_reduc(&xcs, a);
     }
 
     void
     set_fit_reduc(const double a)
     {
+        XCSLock lock(mtx);
         ea_param_set_fit_reduc(&xcs, a);
     }
 
     void
     set_ea_subsumption(const bool a)
     {
+        XCSLock lock(mtx);
         ea_param_set_subsumption(&xcs, a);
     }
 
     void
     set_ea_pred_reset(const bool a)
     {
+        XCSLock lock(mtx);
         ea_param_set_pred_reset(&xcs, a);
     }
+
+    void
+    set_ea_async(const bool a)
+    {
+        XCSLock lock(mtx);
+        ea_param_set_async(&xcs, a);
+    }
+};
+
+/**
+ * @brief Python inference-only frozen model class data structure.
+ */
+class FrozenModel
+{
+  private:
+    struct Frozen frozen; //!< Frozen model data structure
+
+  public:
+    /**
+     * @brief Constructor memory-mapping a frozen model file.
+     * @param [in] filename String containing the name of the input file.
+     */
+    explicit FrozenModel(const char *filename)
+    {
+        frozen_open(&frozen, filename);
+    }
+
+    /**
+     * @brief Destructor unmapping the frozen model file.
+     */
+    ~FrozenModel()
+    {
+        frozen_close(&frozen);
+    }
+
+    FrozenModel(const FrozenModel &) = delete;
+    FrozenModel &
+    operator=(const FrozenModel &) = delete;
+
+    /**
+     * @brief Returns the frozen model predictions for the provided input.
+     * @param [in] x The input variables.
+     * @param [in] out Optional preallocated array to write the predictions.
+     * @return The prediction array values.
+     */
+    py::array_t<double, py::array::c_style>
+    predict(const py_array x, const py::object &out)
+    {
+        const int n_samples = x.shape(0);
+        const int pa_size = frozen.header->n_actions * frozen.header->y_dim;
+        if (x.ndim() != 2 || x.shape(1) != frozen.header->x_dim) {
+            printf("error: input X does not match the frozen model x_dim\n");
+            exit(EXIT_FAILURE);
+        }
+        py::array_t<double, py::array::c_style> output =
+            output_array(out, n_samples, pa_size);
+        const double *input = x.data();
+        double *pred = output.mutable_data();
+        {
+            py::gil_scoped_release release;
+            frozen_predict(&frozen, input, pred, n_samples);
+        }
+        return output;
+    }
 };
 
 PYBIND11_MODULE(xcsf, m)
 {
     rand_init();
 
-    double (XCS::*fit1)(const py::array_t<double>, const int, const double) =
+    double (XCS::*fit1)(const py_array, const int, const double) = &XCS::fit;
+    double (XCS::*fit2)(const py_array, const py_array, const bool) =
         &XCS::fit;
-    double (XCS::*fit2)(const py::array_t<double>, const py::array_t<double>,
-                        const bool) = &XCS::fit;
-    double (XCS::*fit3)(const py::array_t<double>, const py::array_t<double>,
-                        const py::array_t<double>, const py::array_t<double>,
-                        const bool) = &XCS::fit;
-
-    double (XCS::*score1)(const py::array_t<double> test_X,
-                          const py::array_t<double> test_Y) = &XCS::score;
-    double (XCS::*score2)(const py::array_t<double> test_X,
-                          const py::array_t<double> test_Y, const int N) =
+    double (XCS::*fit3)(const py_array, const py_array, const py_array,
+                        const py_array, const bool) = &XCS::fit;
+
+    double (XCS::*score1)(const py_array test_X, const py_array test_Y) =
         &XCS::score;
+    double (XCS::*score2)(const py_array test_X, const py_array test_Y,
+                          const int N) = &XCS::score;
 
     double (XCS::*error1)(void) = &XCS::error;
     double (XCS::*error2)(const double, const bool, const double) = &XCS::error;
@@ -1419,13 +2178,38 @@ PYBIND11_MODULE(xcsf, m)
         .def("fit", fit1)
         .def("fit", fit2)
         .def("fit", fit3)
+        .def("fit_stream", &XCS::fit_stream, py::arg("fname_x"),
+             py::arg("fname_y"), py::arg("shuffle") = true,
+             py::arg("buffer_size") = 10000)
         .def("score", score1)
         .def("score", score2)
         .def("error", error1)
         .def("error", error2)
-        .def("predict", &XCS::predict)
+        .def("predict", &XCS::predict, py::arg("X"),
+             py::arg("out") = py::none())
+        .def("predict_published", &XCS::predict_published, py::arg("X"),
+             py::arg("out") = py::none())
         .def("save", &XCS::save)
         .def("load", &XCS::load)
+        .def("merge", &XCS::merge)
+        .def("checkpoint", &XCS::checkpoint)
+        .def("publish", &XCS::publish)
+        .def("profile", &XCS::profile)
+        .def("profile_reset", &XCS::profile_reset)
+        .def("trace_save", &XCS::trace_save)
+        .def("to_bytes", &XCS::to_bytes)
+        .def_static("from_bytes", &XCS::from_bytes)
+        .def(py::pickle(
+            [](const XCS &x) { return py::make_tuple(x.to_bytes()); },
+            [](const py::tuple &t) {
+                if (t.size() != 1) {
+                    printf("error: invalid XCS pickle state\n");
+                    exit(EXIT_FAILURE);
+                }
+                return XCS::from_bytes(t[0].cast<py::bytes>());
+            }))
+        .def("export_frozen", &XCS::export_frozen)
+        .def("export_c", &XCS::export_c)
         .def("store", &XCS::store)
         .def("retrieve", &XCS::retrieve)
         .def("version_major", &XCS::version_major)
@@ -1437,14 +2221,35 @@ PYBIND11_MODULE(xcsf, m)
         .def("end_step", &XCS::end_step)
         .def("decision", &XCS::decision)
         .def("update", &XCS::update)
+        .def("fit_batch", &XCS::fit_batch, py::arg("states"),
+             py::arg("actions"), py::arg("rewards"), py::arg("next_states"),
+             py::arg("dones"))
+        .def("decision_batch", &XCS::decision_batch, py::arg("states"),
+             py::arg("explore"))
         .def_property("OMP_NUM_THREADS", &XCS::get_omp_num_threads,
                       &XCS::set_omp_num_threads)
         .def_property("POP_INIT", &XCS::get_pop_init, &XCS::set_pop_init)
         .def_property("MAX_TRIALS", &XCS::get_max_trials, &XCS::set_max_trials)
         .def_property("PERF_TRIALS", &XCS::get_perf_trials,
                       &XCS::set_perf_trials)
+        .def_property("CHECKPOINT_TRIALS", &XCS::get_checkpoint_trials,
+                      &XCS::set_checkpoint_trials)
+        .def_property("PUBLISH_TRIALS", &XCS::get_publish_trials,
+                      &XCS::set_publish_trials)
+        .def_property("PROFILE", &XCS::get_profile, &XCS::set_profile)
+        .def_property("PROFILE_HW", &XCS::get_profile_hw,
+                      &XCS::set_profile_hw)
+        .def_property("TRACE_SIZE", &XCS::get_trace_size,
+                      &XCS::set_trace_size)
         .def_property("POP_SIZE", &XCS::get_pop_max_size,
                       &XCS::set_pop_max_size)
+        .def_property("POP_MEM_SIZE", &XCS::get_pop_mem_size,
+                      &XCS::set_pop_mem_size)
+        .def_property("ISLANDS", &XCS::get_islands, &XCS::set_islands)
+        .def_property("MIGRATION_TRIALS", &XCS::get_migration_trials,
+                      &XCS::set_migration_trials)
+        .def_property("MIGRATION_SIZE", &XCS::get_migration_size,
+                      &XCS::set_migration_size)
         .def_property("LOSS_FUNC", &XCS::get_loss_func, &XCS::set_loss_func)
         .def_property("HUBER_DELTA", &XCS::get_huber_delta,
                       &XCS::set_huber_delta)
@@ -1466,6 +2271,11 @@ PYBIND11_MODULE(xcsf, m)
                       &XCS::set_set_subsumption)
         .def_property("TELETRANSPORTATION", &XCS::get_teletransportation,
                       &XCS::set_teletransportation)
+        .def_property("REPLAY_SIZE", &XCS::get_replay_size,
+                      &XCS::set_replay_size)
+        .def_property("REPLAY_BATCH", &XCS::get_replay_batch,
+                      &XCS::set_replay_batch)
+        .def_property("N_ENVS", &XCS::get_n_envs, &XCS::set_n_envs)
         .def_property("GAMMA", &XCS::get_gamma, &XCS::set_gamma)
         .def_property("P_EXPLORE", &XCS::get_p_explore, &XCS::set_p_explore)
         .def_property("EA_SELECT_TYPE", &XCS::get_ea_select_type,
@@ -1482,6 +2292,7 @@ PYBIND11_MODULE(xcsf, m)
                       &XCS::set_ea_subsumption)
         .def_property("EA_PRED_RESET", &XCS::get_ea_pred_reset,
                       &XCS::set_ea_pred_reset)
+        .def_property("EA_ASYNC", &XCS::get_ea_async, &XCS::set_ea_async)
         .def("time", &XCS::get_time)
         .def("x_dim", &XCS::get_x_dim)
         .def("y_dim", &XCS::get_y_dim)
@@ -1497,6 +2308,7 @@ PYBIND11_MODULE(xcsf, m)
         .def("pset_mean_cond_neurons", &XCS::get_pset_mean_cond_neurons)
         .def("pset_mean_cond_layers", &XCS::get_pset_mean_cond_layers)
         .def("pset_mean_cond_connections", &XCS::get_pset_mean_cond_connections)
+        .def("pset_mem_size", &XCS::get_pset_mem_size)
         .def("mset_size", &XCS::get_mset_size)
         .def("aset_size", &XCS::get_aset_size)
         .def("mfrac", &XCS::get_mfrac)
@@ -1504,4 +2316,9 @@ PYBIND11_MODULE(xcsf, m)
         .def("print_params", &XCS::print_params)
         .def("pred_expand", &XCS::pred_expand)
         .def("ae_to_classifier", &XCS::ae_to_classifier);
+
+    py::class_<FrozenModel>(m, "FrozenModel")
+        .def(py::init<const char *>())
+        .def("predict", &FrozenModel::predict, py::arg("X"),
+             py::arg("out") = py::none());
 }
@@ -0,0 +1,89 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file replay.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Experience replay buffer for reinforcement learning.
+ */
+
+#include "replay.h"
+
+/**
+ * @brief Initialises an empty replay buffer.
+ * @param [in] replay The replay buffer to initialise.
+ * @param [in] x_dim The number of state variables.
+ * @param [in] capacity The maximum number of transitions to store.
+ */
+void
+replay_init(struct Replay *replay, const int x_dim, const int capacity)
+{
+    replay->x_dim = x_dim;
+    replay->capacity = capacity;
+    replay->size = 0;
+    replay->pos = 0;
+    replay->state = malloc(sizeof(double) * capacity * x_dim);
+    replay->next_state = malloc(sizeof(double) * capacity * x_dim);
+    replay->reward = malloc(sizeof(double) * capacity);
+    replay->action = malloc(sizeof(int) * capacity);
+    replay->done = malloc(sizeof(bool) * capacity);
+}
+
+/**
+ * @brief Frees the memory used by a replay buffer.
+ * @param [in] replay The replay buffer to free.
+ */
+void
+replay_free(struct Replay *replay)
+{
+    free(replay->state);
+    free(replay->next_state);
+    free(replay->reward);
+    free(replay->action);
+    free(replay->done);
+    replay->size = 0;
+    replay->capacity = 0;
+}
+
+/**
+ * @brief Stores a transition, overwriting the oldest if the buffer is full.
+ * @param [in] replay The replay buffer.
+ * @param [in] state The state.
+ * @param [in] action The action performed.
+ * @param [in] reward The reward received.
+ * @param [in] next_state The resulting state.
+ * @param [in] done Whether the resulting state is terminal.
+ */
+void
+replay_add(struct Replay *replay, const double *state, const int action,
+           const double reward, const double *next_state, const bool done)
+{
+    if (replay->capacity < 1) {
+        return;
+    }
+    const int i = replay->pos;
+    const size_t bytes = sizeof(double) * replay->x_dim;
+    memcpy(&replay->state[i * replay->x_dim], state, bytes);
+    memcpy(&replay->next_state[i * replay->x_dim], next_state, bytes);
+    replay->reward[i] = reward;
+    replay->action[i] = action;
+    replay->done[i] = done;
+    replay->pos = (i + 1) % replay->capacity;
+    if (replay->size < replay->capacity) {
+        ++(replay->size);
+    }
+}
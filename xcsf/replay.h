@@ -0,0 +1,52 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file replay.h
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Experience replay buffer for reinforcement learning.
+ */
+
+#pragma once
+
+#include "xcsf.h"
+
+/**
+ * @brief Circular buffer of (state, action, reward, next_state, done)
+ * transitions; the oldest transition is overwritten when full.
+ */
+struct Replay {
+    double *state; //!< States (capacity * x_dim)
+    double *next_state; //!< Resulting states (capacity * x_dim)
+    double *reward; //!< Rewards received
+    int *action; //!< Actions performed
+    bool *done; //!< Whether each resulting state is terminal
+    int x_dim; //!< Number of state variables
+    int capacity; //!< Maximum number of transitions stored
+    int size; //!< Number of transitions stored
+    int pos; //!< Index at which the next transition is stored
+};
+
+void
+replay_add(struct Replay *replay, const double *state, const int action,
+           const double reward, const double *next_state, const bool done);
+
+void
+replay_free(struct Replay *replay);
+
+void
+replay_init(struct Replay *replay, const int x_dim, const int capacity);
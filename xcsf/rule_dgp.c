@@ -146,11 +146,20 @@ rule_dgp_cond_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
 {
     struct RuleDGP *new = malloc(sizeof(struct RuleDGP));
     size_t s = graph_load(&new->dgp, fp);
+    new->dgp.n_inputs = xcsf->cond->dargs->n_inputs;
     new->n_outputs = (int) fmax(1, ceil(log2(xcsf->n_actions)));
     c->cond = new;
     return s;
 }
 
+size_t
+rule_dgp_cond_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct RuleDGP *cond = c->cond;
+    return sizeof(struct RuleDGP) + graph_mem_size(&cond->dgp);
+}
+
 /* ACTION FUNCTIONS */
 
 void
@@ -266,3 +275,11 @@ rule_dgp_act_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     (void) fp;
     return 0;
 }
+
+size_t
+rule_dgp_act_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    (void) c;
+    return 0; // the graph is owned by the condition
+}
@@ -81,6 +81,9 @@ rule_dgp_cond_save(const struct XCSF *xcsf, const struct Cl *c, FILE *fp);
 size_t
 rule_dgp_cond_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
 
+size_t
+rule_dgp_cond_mem_size(const struct XCSF *xcsf, const struct Cl *c);
+
 /**
  * @brief Dynamical GP rule condition implemented functions.
  */
@@ -89,7 +92,7 @@ static struct CondVtbl const rule_dgp_cond_vtbl = {
     &rule_dgp_cond_mutate,    &rule_dgp_cond_copy,    &rule_dgp_cond_cover,
     &rule_dgp_cond_free,      &rule_dgp_cond_init,    &rule_dgp_cond_print,
     &rule_dgp_cond_update,    &rule_dgp_cond_size,    &rule_dgp_cond_save,
-    &rule_dgp_cond_load
+    &rule_dgp_cond_load,      &rule_dgp_cond_mem_size
 };
 
 bool
@@ -134,6 +137,9 @@ rule_dgp_act_save(const struct XCSF *xcsf, const struct Cl *c, FILE *fp);
 size_t
 rule_dgp_act_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp);
 
+size_t
+rule_dgp_act_mem_size(const struct XCSF *xcsf, const struct Cl *c);
+
 /**
  * @brief Dynamical GP rule action implemented functions.
  */
@@ -141,5 +147,6 @@ static struct ActVtbl const rule_dgp_act_vtbl = {
     &rule_dgp_act_general, &rule_dgp_act_crossover, &rule_dgp_act_mutate,
     &rule_dgp_act_compute, &rule_dgp_act_copy,      &rule_dgp_act_cover,
     &rule_dgp_act_free,    &rule_dgp_act_init,      &rule_dgp_act_print,
-    &rule_dgp_act_update,  &rule_dgp_act_save,      &rule_dgp_act_load
+    &rule_dgp_act_update,  &rule_dgp_act_save,      &rule_dgp_act_load,
+    &rule_dgp_act_mem_size
 };
@@ -160,6 +160,14 @@ rule_neural_cond_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     return s;
 }
 
+size_t
+rule_neural_cond_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    const struct RuleNeural *cond = c->cond;
+    return sizeof(struct RuleNeural) + neural_mem_size(&cond->net);
+}
+
 /* ACTION FUNCTIONS */
 
 void
@@ -275,3 +283,11 @@ rule_neural_act_load(const struct XCSF *xcsf, struct Cl *c, FILE *fp)
     (void) fp;
     return 0;
 }
+
+size_t
+rule_neural_act_mem_size(const struct XCSF *xcsf, const struct Cl *c)
+{
+    (void) xcsf;
+    (void) c;
+    return 0; // the network is owned by the condition
+}
@@ -0,0 +1,302 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file serve.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Resident inference server for frozen models.
+ * @details The model is loaded once and requests are answered with the
+ * read-only frozen model path. On connection the server writes three int32
+ * values: x_dim, y_dim and n_actions. Each request is an int32 number of
+ * samples followed by that many rows of x_dim doubles, and the response is
+ * n_actions * y_dim doubles per sample. A request with no samples, or the end
+ * of the input, closes the connection. All values are in the native byte
+ * order. Requests are served on stdin/stdout, with the blocks of each batch
+ * predicted in parallel, or on a Unix domain socket by a pool of threads that
+ * each serve one connection at a time.
+ */
+
+#include "serve.h"
+#include "param.h"
+#include "utils.h"
+
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <signal.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#else
+    #include <fcntl.h>
+    #include <io.h>
+    #define read _read //!< POSIX read on Windows
+    #define write _write //!< POSIX write on Windows
+#endif
+
+/**
+ * @brief Reads a number of bytes from a file descriptor.
+ * @param [in] fd The file descriptor.
+ * @param [out] buf The buffer to read into.
+ * @param [in] len The number of bytes to read.
+ * @return Whether all bytes were read.
+ */
+static bool
+serve_read(const int fd, void *buf, const size_t len)
+{
+    char *p = buf;
+    size_t done = 0;
+    while (done < len) {
+        const long r = read(fd, p + done, len - done);
+        if (r <= 0) {
+            if (r < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        done += (size_t) r;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a number of bytes to a file descriptor.
+ * @param [in] fd The file descriptor.
+ * @param [in] buf The buffer to write.
+ * @param [in] len The number of bytes to write.
+ * @return Whether all bytes were written.
+ */
+static bool
+serve_write(const int fd, const void *buf, const size_t len)
+{
+    const char *p = buf;
+    size_t done = 0;
+    while (done < len) {
+        const long w = write(fd, p + done, len - done);
+        if (w <= 0) {
+            if (w < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        done += (size_t) w;
+    }
+    return true;
+}
+
+/**
+ * @brief Calculates the predictions for a batch of samples.
+ * @param [in] frozen The frozen model.
+ * @param [in] x The input feature variables.
+ * @param [out] pred The calculated predictions.
+ * @param [in] n_samples The number of instances.
+ * @param [in] parallel Whether to predict the blocks of the batch in parallel.
+ */
+static void
+serve_predict(const struct Frozen *frozen, const double *x, double *pred,
+              const int n_samples, const bool parallel)
+{
+    const int n_blocks = (n_samples + FROZEN_BLOCK - 1) / FROZEN_BLOCK;
+    if (!parallel || n_blocks < 2) {
+        frozen_predict(frozen, x, pred, n_samples);
+        return;
+    }
+    const int x_dim = frozen->header->x_dim;
+    const int pa_size = frozen->header->n_actions * frozen->header->y_dim;
+#ifdef PARALLEL_PRED
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < n_blocks; ++i) {
+        const int start = i * FROZEN_BLOCK;
+        const int rows = clamp_int(n_samples - start, 0, FROZEN_BLOCK);
+        frozen_predict(frozen, &x[start * x_dim], &pred[start * pa_size],
+                       rows);
+    }
+}
+
+/**
+ * @brief Answers the requests of a connection until it is closed.
+ * @param [in] frozen The frozen model.
+ * @param [in] in The file descriptor to read requests from.
+ * @param [in] out The file descriptor to write responses to.
+ * @param [in] parallel Whether to predict the blocks of a batch in parallel.
+ */
+static void
+serve_connection(const struct Frozen *frozen, const int in, const int out,
+                 const bool parallel)
+{
+    const struct FrozenHeader *h = frozen->header;
+    const int32_t dims[3] = { h->x_dim, h->y_dim, h->n_actions };
+    if (!serve_write(out, dims, sizeof(dims))) {
+        return;
+    }
+    const int pa_size = h->n_actions * h->y_dim;
+    double *x = NULL;
+    double *pred = NULL;
+    int32_t capacity = 0;
+    int32_t n = 0;
+    while (serve_read(in, &n, sizeof(int32_t)) && n > 0 &&
+           n <= SERVE_MAX_SAMPLES) {
+        if (n > capacity) {
+            capacity = n;
+            x = realloc(x, sizeof(double) * capacity * h->x_dim);
+            pred = realloc(pred, sizeof(double) * capacity * pa_size);
+        }
+        if (!serve_read(in, x, sizeof(double) * n * h->x_dim)) {
+            break;
+        }
+        serve_predict(frozen, x, pred, n, parallel);
+        if (!serve_write(out, pred, sizeof(double) * n * pa_size)) {
+            break;
+        }
+    }
+    free(x);
+    free(pred);
+}
+
+/**
+ * @brief Loads a model to serve.
+ * @details The file may be a frozen model, which is memory-mapped, or a saved
+ * XCSF state, which is frozen in memory.
+ * @param [out] frozen The frozen model.
+ * @param [in] filename The name of the model file.
+ */
+void
+serve_load(struct Frozen *frozen, const char *filename)
+{
+    char magic[sizeof(FROZEN_MAGIC)] = { 0 };
+    FILE *fp = fopen(filename, "rb");
+    if (fp == 0) {
+        printf("Error loading file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    const size_t s = fread(magic, 1, sizeof(magic), fp);
+    fclose(fp);
+    if (s == sizeof(magic) && memcmp(magic, FROZEN_MAGIC, s) == 0) {
+        frozen_open(frozen, filename);
+        return;
+    }
+    struct XCSF xcsf;
+    param_init(&xcsf, 1, 1, 1);
+    xcsf_init(&xcsf);
+    xcsf_load(&xcsf, filename);
+    frozen_init(frozen, &xcsf);
+    xcsf_free(&xcsf);
+    param_free(&xcsf);
+}
+
+/**
+ * @brief Answers requests on stdin/stdout until the end of the input.
+ * @param [in] frozen The frozen model.
+ * @param [in] n_threads The number of threads to predict each batch.
+ */
+void
+serve_stdio(const struct Frozen *frozen, const int n_threads)
+{
+#ifdef PARALLEL
+    omp_set_num_threads(n_threads);
+#else
+    (void) n_threads;
+#endif
+#ifdef _WIN32
+    _setmode(0, _O_BINARY);
+    _setmode(1, _O_BINARY);
+#endif
+    serve_connection(frozen, 0, 1, true);
+}
+
+#ifndef _WIN32
+/**
+ * @brief Accepts and serves connections on a listening socket.
+ * @param [in] arg The server worker.
+ * @return NULL.
+ */
+static void *
+serve_worker(void *arg)
+{
+    const struct ServeWorker *worker = arg;
+    while (true) {
+        const int fd = accept(worker->fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            printf("serve_worker(): %s\n", strerror(errno));
+            return NULL;
+        }
+        serve_connection(worker->frozen, fd, fd, false);
+        close(fd);
+    }
+}
+#endif
+
+/**
+ * @brief Answers requests on a Unix domain socket until terminated.
+ * @details Any existing file at the socket path is replaced.
+ * @param [in] frozen The frozen model.
+ * @param [in] path The path of the socket.
+ * @param [in] n_threads The number of connections served concurrently.
+ */
+void
+serve_socket(const struct Frozen *frozen, const char *path,
+             const int n_threads)
+{
+#ifdef _WIN32
+    (void) frozen;
+    (void) path;
+    (void) n_threads;
+    printf("serve_socket(): Unix domain sockets are not supported\n");
+    exit(EXIT_FAILURE);
+#else
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(struct sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        printf("serve_socket(): socket path too long: %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    signal(SIGPIPE, SIG_IGN);
+    unlink(path);
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 ||
+        bind(fd, (const struct sockaddr *) &addr, sizeof(addr)) != 0 ||
+        listen(fd, SOMAXCONN) != 0) {
+        printf("Error serving socket: %s. %s.\n", path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    struct ServeWorker worker = { frozen, fd };
+    pthread_t *threads = malloc(sizeof(pthread_t) * n_threads);
+    for (int i = 0; i < n_threads; ++i) {
+        if (pthread_create(&threads[i], NULL, serve_worker, &worker) != 0) {
+            printf("serve_socket(): failed to create worker thread\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    printf("Serving %s with %d threads\n", path, n_threads);
+    fflush(stdout);
+    for (int i = 0; i < n_threads; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    close(fd);
+    unlink(path);
+#endif
+}
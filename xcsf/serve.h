@@ -0,0 +1,47 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file serve.h
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Resident inference server for frozen models.
+ */
+
+#pragma once
+
+#include "frozen.h"
+
+#define SERVE_THREADS (4) //!< Default number of server threads
+#define SERVE_MAX_SAMPLES (65536) //!< Maximum number of samples per request
+
+/**
+ * @brief Server worker thread data structure.
+ */
+struct ServeWorker {
+    const struct Frozen *frozen; //!< The frozen model to serve
+    int fd; //!< Listening socket file descriptor
+};
+
+void
+serve_load(struct Frozen *frozen, const char *filename);
+
+void
+serve_socket(const struct Frozen *frozen, const char *path,
+             const int n_threads);
+
+void
+serve_stdio(const struct Frozen *frozen, const int n_threads);
@@ -0,0 +1,327 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file stream.c
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Out-of-core streaming input data with a shuffle buffer.
+ */
+
+#include "stream.h"
+#include "utils.h"
+#include <ctype.h>
+
+/**
+ * @brief Returns the number of dimensions in a csv file.
+ * @details Counts the non-empty comma separated fields on the first line.
+ * @param [in] fp The csv file.
+ * @return The number of dimensions.
+ */
+static int
+stream_csv_dim(FILE *fp)
+{
+    int n_dim = 0;
+    bool token = false;
+    int ch = 0;
+    while ((ch = fgetc(fp)) != EOF && ch != '\n') {
+        if (ch == ',') {
+            n_dim += token ? 1 : 0;
+            token = false;
+        } else if (!isspace(ch)) {
+            token = true;
+        }
+    }
+    n_dim += token ? 1 : 0;
+    rewind(fp);
+    return n_dim;
+}
+
+/**
+ * @brief Opens a streaming input file.
+ * @param [in] filename The name of the file to open.
+ * @param [in] type The file format.
+ * @return Pointer to the opened file.
+ */
+static FILE *
+stream_open(const char *filename, const int type)
+{
+    FILE *fp = fopen(filename, (type == STREAM_BINARY) ? "rb" : "rt");
+    if (fp == 0) {
+        printf("Error opening file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    return fp;
+}
+
+/**
+ * @brief Reads a single row of values from a file.
+ * @param [in] stream The streaming input data structure.
+ * @param [in] fp The file to read.
+ * @param [out] row The values read.
+ * @param [in] dim The number of values in a row.
+ * @return Whether a complete row was read.
+ */
+static bool
+stream_read_row(const struct Stream *stream, FILE *fp, double *row,
+                const int dim)
+{
+    if (stream->type == STREAM_BINARY) {
+        return fread(row, sizeof(double), dim, fp) == (size_t) dim;
+    }
+    for (int i = 0; i < dim; ++i) {
+        if (fscanf(fp, " %lf%*[, \t]", &row[i]) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the next chunk of samples from the input files.
+ * @details If looping, the files are rewound when the end is reached.
+ * @param [in] stream The streaming input data structure.
+ * @param [out] chunk The chunk to fill.
+ * @return The number of samples read.
+ */
+static int
+stream_read_chunk(const struct Stream *stream, struct StreamChunk *chunk)
+{
+    bool rewound = false;
+    chunk->n = 0;
+    while (chunk->n < stream->chunk_size) {
+        double *x = &chunk->x[chunk->n * stream->x_dim];
+        double *y = &chunk->y[chunk->n * stream->y_dim];
+        if (stream_read_row(stream, stream->fp_x, x, stream->x_dim) &&
+            stream_read_row(stream, stream->fp_y, y, stream->y_dim)) {
+            ++(chunk->n);
+            rewound = false;
+        } else if (stream->loop && !rewound) {
+            rewind(stream->fp_x);
+            rewind(stream->fp_y);
+            rewound = true;
+        } else {
+            break;
+        }
+    }
+    return chunk->n;
+}
+
+/**
+ * @brief Background thread that reads chunks ahead of the consumer.
+ * @details Fills the back chunk whenever the consumer has taken the previous
+ * one. An empty chunk signals the end of the data and terminates the thread.
+ * @param [in] arg The streaming input data structure.
+ * @return NULL.
+ */
+static void *
+stream_reader(void *arg)
+{
+    struct Stream *stream = arg;
+    pthread_mutex_lock(&stream->lock);
+    while (!stream->stop) {
+        if (stream->ready) {
+            pthread_cond_wait(&stream->cond, &stream->lock);
+            continue;
+        }
+        struct StreamChunk *back = &stream->chunk[1 - stream->front];
+        pthread_mutex_unlock(&stream->lock);
+        const int n = stream_read_chunk(stream, back);
+        pthread_mutex_lock(&stream->lock);
+        stream->ready = true;
+        pthread_cond_broadcast(&stream->cond);
+        if (n == 0) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stream->lock);
+    return NULL;
+}
+
+/**
+ * @brief Copies the next sample from the chunks read from disk.
+ * @param [in] stream The streaming input data structure.
+ * @param [out] x The feature variables of the sample.
+ * @param [out] y The target variables of the sample.
+ * @return Whether a sample was available.
+ */
+static bool
+stream_fetch(struct Stream *stream, double *x, double *y)
+{
+    if (stream->pos >= stream->chunk[stream->front].n) {
+        if (stream->eof) {
+            return false;
+        }
+        pthread_mutex_lock(&stream->lock);
+        while (!stream->ready) {
+            pthread_cond_wait(&stream->cond, &stream->lock);
+        }
+        stream->front = 1 - stream->front;
+        stream->pos = 0;
+        stream->ready = false;
+        stream->eof = (stream->chunk[stream->front].n == 0);
+        pthread_cond_broadcast(&stream->cond);
+        pthread_mutex_unlock(&stream->lock);
+        if (stream->eof) {
+            return false;
+        }
+    }
+    const struct StreamChunk *chunk = &stream->chunk[stream->front];
+    memcpy(x, &chunk->x[stream->pos * stream->x_dim],
+           sizeof(double) * stream->x_dim);
+    memcpy(y, &chunk->y[stream->pos * stream->y_dim],
+           sizeof(double) * stream->y_dim);
+    ++(stream->pos);
+    return true;
+}
+
+/**
+ * @brief Initialises a streaming input source and starts the reader thread.
+ * @details For csv files the dimensions are read from the first line of each
+ * file; for binary files they must be specified.
+ * @param [in] stream The streaming input data structure to initialise.
+ * @param [in] fname_x The name of the feature variables file.
+ * @param [in] fname_y The name of the target variables file.
+ * @param [in] type The file format: STREAM_CSV or STREAM_BINARY.
+ * @param [in] x_dim The number of feature variables (binary files).
+ * @param [in] y_dim The number of target variables (binary files).
+ * @param [in] buffer_size The number of samples held in the shuffle buffer.
+ * @param [in] chunk_size The number of samples to read from disk at a time.
+ * @param [in] shuffle Whether to draw samples randomly from the buffer.
+ * @param [in] loop Whether to restart from the beginning at the end of files.
+ */
+void
+stream_init(struct Stream *stream, const char *fname_x, const char *fname_y,
+            const int type, const int x_dim, const int y_dim,
+            const int buffer_size, const int chunk_size, const bool shuffle,
+            const bool loop)
+{
+    if (buffer_size < 1 || chunk_size < 1) {
+        printf("stream_init(): buffer and chunk sizes must be positive\n");
+        exit(EXIT_FAILURE);
+    }
+    stream->type = type;
+    stream->fp_x = stream_open(fname_x, type);
+    stream->fp_y = stream_open(fname_y, type);
+    if (type == STREAM_CSV) {
+        stream->x_dim = stream_csv_dim(stream->fp_x);
+        stream->y_dim = stream_csv_dim(stream->fp_y);
+    } else {
+        stream->x_dim = x_dim;
+        stream->y_dim = y_dim;
+    }
+    if (stream->x_dim < 1 || stream->y_dim < 1) {
+        printf("stream_init(): invalid dimensions: x_dim=%d, y_dim=%d\n",
+               stream->x_dim, stream->y_dim);
+        exit(EXIT_FAILURE);
+    }
+    stream->chunk_size = chunk_size;
+    stream->buffer_size = buffer_size;
+    stream->shuffle = shuffle;
+    stream->loop = loop;
+    stream->buf_x = malloc(sizeof(double) * buffer_size * stream->x_dim);
+    stream->buf_y = malloc(sizeof(double) * buffer_size * stream->y_dim);
+    stream->n_buf = 0;
+    stream->x = malloc(sizeof(double) * stream->x_dim);
+    stream->y = malloc(sizeof(double) * stream->y_dim);
+    for (int i = 0; i < 2; ++i) {
+        struct StreamChunk *chunk = &stream->chunk[i];
+        chunk->x = malloc(sizeof(double) * chunk_size * stream->x_dim);
+        chunk->y = malloc(sizeof(double) * chunk_size * stream->y_dim);
+        chunk->n = 0;
+    }
+    stream->front = 0;
+    stream->pos = 0;
+    stream->ready = false;
+    stream->stop = false;
+    stream->eof = false;
+    pthread_mutex_init(&stream->lock, NULL);
+    pthread_cond_init(&stream->cond, NULL);
+    if (pthread_create(&stream->thread, NULL, stream_reader, stream) != 0) {
+        printf("stream_init(): failed to create reader thread\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Returns the next sample from the stream.
+ * @details When shuffling, a sample is drawn at random from the buffer and its
+ * slot refilled with the next sample read from disk.
+ * @param [in] stream The streaming input data structure.
+ * @param [out] x The feature variables (valid until the next call).
+ * @param [out] y The target variables (valid until the next call).
+ * @return Whether a sample was returned; false at the end of the data.
+ */
+bool
+stream_next(struct Stream *stream, const double **x, const double **y)
+{
+    const int x_dim = stream->x_dim;
+    const int y_dim = stream->y_dim;
+    if (!stream->shuffle) {
+        if (!stream_fetch(stream, stream->x, stream->y)) {
+            return false;
+        }
+    } else {
+        while (stream->n_buf < stream->buffer_size &&
+               stream_fetch(stream, &stream->buf_x[stream->n_buf * x_dim],
+                            &stream->buf_y[stream->n_buf * y_dim])) {
+            ++(stream->n_buf);
+        }
+        if (stream->n_buf < 1) {
+            return false;
+        }
+        const int i = rand_uniform_int(0, stream->n_buf);
+        double *bx = &stream->buf_x[i * x_dim];
+        double *by = &stream->buf_y[i * y_dim];
+        memcpy(stream->x, bx, sizeof(double) * x_dim);
+        memcpy(stream->y, by, sizeof(double) * y_dim);
+        if (!stream_fetch(stream, bx, by)) { // end of data: shrink buffer
+            --(stream->n_buf);
+            const int last = stream->n_buf;
+            memcpy(bx, &stream->buf_x[last * x_dim], sizeof(double) * x_dim);
+            memcpy(by, &stream->buf_y[last * y_dim], sizeof(double) * y_dim);
+        }
+    }
+    *x = stream->x;
+    *y = stream->y;
+    return true;
+}
+
+/**
+ * @brief Stops the reader thread and frees the streaming input source.
+ * @param [in] stream The streaming input data structure to free.
+ */
+void
+stream_free(struct Stream *stream)
+{
+    pthread_mutex_lock(&stream->lock);
+    stream->stop = true;
+    pthread_cond_broadcast(&stream->cond);
+    pthread_mutex_unlock(&stream->lock);
+    pthread_join(stream->thread, NULL);
+    pthread_mutex_destroy(&stream->lock);
+    pthread_cond_destroy(&stream->cond);
+    fclose(stream->fp_x);
+    fclose(stream->fp_y);
+    for (int i = 0; i < 2; ++i) {
+        free(stream->chunk[i].x);
+        free(stream->chunk[i].y);
+    }
+    free(stream->buf_x);
+    free(stream->buf_y);
+    free(stream->x);
+    free(stream->y);
+}
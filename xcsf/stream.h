@@ -0,0 +1,84 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file stream.h
+ * @author Richard Preen <rpreen@gmail.com>
+ * @copyright The Authors.
+ * @date 2020.
+ * @brief Out-of-core streaming input data with a shuffle buffer.
+ */
+
+#pragma once
+
+#include "xcsf.h"
+#include <pthread.h>
+
+#define STREAM_CSV (0) //!< Comma separated values text files
+#define STREAM_BINARY (1) //!< Raw row-major native-endian float64 files
+
+/**
+ * @brief A chunk of samples read from the input files.
+ */
+struct StreamChunk {
+    double *x; //!< Feature variables
+    double *y; //!< Target variables
+    int n; //!< Number of samples in the chunk
+};
+
+/**
+ * @brief Streaming input data structure.
+ * @details Samples are read from disk in chunks by a background thread while
+ * the previous chunk is being consumed. If shuffling is enabled, samples pass
+ * through a fixed-size buffer from which they are drawn at random, so that
+ * memory use is bounded by the buffer and chunk sizes, not the file size.
+ */
+struct Stream {
+    FILE *fp_x; //!< Feature variables file
+    FILE *fp_y; //!< Target variables file
+    int type; //!< File format: CSV or binary
+    int x_dim; //!< Number of feature variables
+    int y_dim; //!< Number of target variables
+    int chunk_size; //!< Number of samples to read per chunk
+    int buffer_size; //!< Number of samples held in the shuffle buffer
+    bool shuffle; //!< Whether to draw samples randomly from the buffer
+    bool loop; //!< Whether to rewind the files when the end is reached
+    double *buf_x; //!< Shuffle buffer feature variables
+    double *buf_y; //!< Shuffle buffer target variables
+    int n_buf; //!< Number of samples currently in the shuffle buffer
+    double *x; //!< Feature variables of the current sample
+    double *y; //!< Target variables of the current sample
+    struct StreamChunk chunk[2]; //!< Front (consumed) and back (read) chunks
+    int front; //!< Index of the chunk being consumed
+    int pos; //!< Position of the next sample within the front chunk
+    bool ready; //!< Whether the back chunk has been filled
+    bool stop; //!< Whether the reader thread has been asked to stop
+    bool eof; //!< Whether the end of the data has been reached
+    pthread_t thread; //!< Background reader thread
+    pthread_mutex_t lock; //!< Lock protecting the chunk hand-over
+    pthread_cond_t cond; //!< Condition signalling chunk hand-over
+};
+
+bool
+stream_next(struct Stream *stream, const double **x, const double **y);
+
+void
+stream_free(struct Stream *stream);
+
+void
+stream_init(struct Stream *stream, const char *fname_x, const char *fname_y,
+            const int type, const int x_dim, const int y_dim,
+            const int buffer_size, const int chunk_size, const bool shuffle,
+            const bool loop);
@@ -19,16 +19,52 @@
  * @copyright The Authors.
  * @date 2015--2020.
  * @brief Utility functions for random number handling, etc.
+ * @details Each thread has its own pseudo-random number generator state, which
+ * is seeded on first use unless seeded explicitly. The streams of OpenMP
+ * worker threads are derived from a seed drawn by the thread starting the
+ * parallel region, see rand_init_worker().
  */
 
 #include "utils.h"
 #include "../lib/dSFMT/dSFMT.h"
 #include <limits.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
 
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
+
+static _Thread_local dsfmt_t rand_dsfmt; //!< Generator state of this thread
+static _Thread_local bool rand_seeded = false; //!< Whether state is seeded
+static _Thread_local bool rand_pending = false; //!< Worker seed is pending
+static _Thread_local uint32_t rand_worker_seed = 0; //!< Seed of this worker
+static _Thread_local double normal_z1 = 0; //!< Second Box-Muller Gaussian
+static _Thread_local bool normal_generate = false; //!< Whether to make a pair
+
+/**
+ * @brief Returns the pseudo-random number generator state of this thread.
+ * @return The generator state, seeded with any pending worker seed, or
+ * otherwise from the clock, if not yet seeded.
+ */
+static inline dsfmt_t *
+rand_dsfmt_state(void)
+{
+    if (!rand_seeded) {
+        if (rand_pending) {
+            rand_init_seed(rand_worker_seed);
+        } else {
+            rand_init();
+        }
+    }
+    return &rand_dsfmt;
+}
+
 /**
- * @brief Initialises the pseudo-random number generator.
+ * @brief Initialises the pseudo-random number generator of this thread.
+ * @details The seed is derived from the clock and the address of the thread's
+ * state so that threads started at the same time use different streams.
  */
 void
 rand_init(void)
@@ -39,7 +75,48 @@ rand_init(void)
     for (size_t i = 0; i < sizeof(now); ++i) {
         seed = (seed * (UCHAR_MAX + 2U)) + p[i];
     }
-    dsfmt_gv_init_gen_rand(seed);
+    seed ^= (uint32_t) ((uintptr_t) &rand_dsfmt >> 4);
+    rand_init_seed(seed);
+}
+
+/**
+ * @brief Initialises the pseudo-random number generator of this thread with a
+ * fixed seed.
+ * @param [in] seed The seed.
+ */
+void
+rand_init_seed(const uint32_t seed)
+{
+    dsfmt_init_gen_rand(&rand_dsfmt, seed);
+    rand_seeded = true;
+    rand_pending = false;
+    normal_generate = false;
+}
+
+/**
+ * @brief Derives the stream of an OpenMP worker thread from a seed.
+ * @details Called by every thread at the start of a parallel region with a
+ * seed drawn from the stream of the thread starting the region. That thread
+ * (thread 0) continues its own stream; each other thread is seeded from the
+ * seed and its thread number, so that the numbers drawn within the region are
+ * reproducible for a given number of threads with static scheduling. The
+ * worker is only seeded if it draws a number.
+ * @param [in] seed The seed drawn by the thread starting the region.
+ */
+void
+rand_init_worker(const uint32_t seed)
+{
+#ifdef PARALLEL
+    const int tid = omp_get_thread_num();
+    if (tid > 0) {
+        rand_worker_seed = seed + ((uint32_t) tid * 0x9E3779B9U);
+        rand_pending = true;
+        rand_seeded = false;
+        normal_generate = false;
+    }
+#else
+    (void) seed;
+#endif
 }
 
 /**
@@ -51,7 +128,7 @@ rand_init(void)
 double
 rand_uniform(const double min, const double max)
 {
-    return min + (dsfmt_gv_genrand_open_open() * (max - min));
+    return min + (dsfmt_genrand_open_open(rand_dsfmt_state()) * (max - min));
 }
 
 /**
@@ -77,15 +154,54 @@ double
 rand_normal(const double mu, const double sigma)
 {
     static const double two_pi = 2 * M_PI;
-    static double z1;
-    static bool generate;
-    generate = !generate;
-    if (!generate) {
-        return z1 * sigma + mu;
+    normal_generate = !normal_generate;
+    if (!normal_generate) {
+        return normal_z1 * sigma + mu;
     }
-    const double u1 = dsfmt_gv_genrand_open_open();
-    const double u2 = dsfmt_gv_genrand_open_open();
+    dsfmt_t *dsfmt = rand_dsfmt_state();
+    const double u1 = dsfmt_genrand_open_open(dsfmt);
+    const double u2 = dsfmt_genrand_open_open(dsfmt);
     const double z0 = sqrt(-2 * log(u1)) * cos(two_pi * u2);
-    z1 = sqrt(-2 * log(u1)) * sin(two_pi * u2);
+    normal_z1 = sqrt(-2 * log(u1)) * sin(two_pi * u2);
     return z0 * sigma + mu;
 }
+
+/**
+ * @brief Returns the size of the pseudo-random number generator state.
+ * @return The size of the state in bytes.
+ */
+size_t
+rand_state_size(void)
+{
+    return sizeof(dsfmt_t) + sizeof(double) + sizeof(bool);
+}
+
+/**
+ * @brief Copies the pseudo-random number generator state of this thread.
+ * @param [out] state The copied state (rand_state_size() bytes).
+ */
+void
+rand_state_get(unsigned char *state)
+{
+    memcpy(state, rand_dsfmt_state(), sizeof(dsfmt_t));
+    state += sizeof(dsfmt_t);
+    memcpy(state, &normal_z1, sizeof(double));
+    state += sizeof(double);
+    memcpy(state, &normal_generate, sizeof(bool));
+}
+
+/**
+ * @brief Restores the pseudo-random number generator state of this thread.
+ * @param [in] state The state to restore (rand_state_size() bytes).
+ */
+void
+rand_state_set(const unsigned char *state)
+{
+    memcpy(&rand_dsfmt, state, sizeof(dsfmt_t));
+    rand_seeded = true;
+    rand_pending = false;
+    state += sizeof(dsfmt_t);
+    memcpy(&normal_z1, state, sizeof(double));
+    state += sizeof(double);
+    memcpy(&normal_generate, state, sizeof(bool));
+}
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -39,6 +40,21 @@ rand_uniform_int(const int min, const int max);
 void
 rand_init(void);
 
+void
+rand_init_seed(const uint32_t seed);
+
+void
+rand_init_worker(const uint32_t seed);
+
+size_t
+rand_state_size(void);
+
+void
+rand_state_get(unsigned char *state);
+
+void
+rand_state_set(const unsigned char *state);
+
 /**
  * @brief Returns a float clamped within the specified range.
  * @param [in] a The value to be clamped.
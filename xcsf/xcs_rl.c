@@ -23,24 +23,269 @@
  */
 
 #include "xcs_rl.h"
+#include "checkpoint.h"
 #include "clset.h"
+#include "condition.h"
 #include "ea.h"
 #include "env.h"
 #include "pa.h"
 #include "param.h"
 #include "perf.h"
+#include "publish.h"
+#include "replay.h"
 #include "utils.h"
 
+/**
+ * @brief Updates the action set for a (state, action) pair towards a target.
+ * @details The match and action sets are created and freed within the call
+ * and the EA is run. Deleted classifiers are added to the kill set, which
+ * must be freed by the caller.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] state The input state to match.
+ * @param [in] action The selected action.
+ * @param [in] target The target payoff for having performed the action.
+ * @return The prediction error.
+ */
+static double
+xcs_rl_learn(struct XCSF *xcsf, const double *state, const int action,
+             const double target)
+{
+    param_set_explore(xcsf, true); // ensure EA is executed
+    clset_init(&xcsf->mset);
+    clset_init(&xcsf->aset);
+    clset_match(xcsf, state);
+    pa_build(xcsf, state);
+    const double prediction = pa_val(xcsf, action);
+    const double error = (xcsf->loss_ptr)(xcsf, &prediction, &target);
+    clset_action(xcsf, action);
+    clset_validate(&xcsf->aset);
+    clset_update(xcsf, &xcsf->aset, state, &target, true);
+    ea(xcsf, &xcsf->aset);
+    clset_free(&xcsf->mset);
+    clset_free(&xcsf->aset);
+    xcsf->error += (error - xcsf->error) * xcsf->BETA;
+    return error;
+}
+
+/**
+ * @brief Builds the match set of each of a batch of states in turn.
+ * @details The match sets are built in a single pass over the population if
+ * clset_match_batchable(); otherwise each state is matched just before its
+ * match set is used. In index order, each match set is completed, made the
+ * current match set, and passed to the function, which must free it. If cover
+ * is set, the states are counted in the classifiers' match statistics and
+ * covering is performed as with clset_match().
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] states The input states (n * x_dim).
+ * @param [in] n The number of states.
+ * @param [in] cover Whether to perform covering and update the statistics.
+ * @param [in] func The function called with the index of each state.
+ * @param [in] args The arguments passed to the function.
+ */
+static void
+xcs_rl_match_each(struct XCSF *xcsf, const double *states, const int n,
+                  const bool cover,
+                  void (*func)(struct XCSF *xcsf, const double *state,
+                               const int i, void *args),
+                  void *args)
+{
+    if (n < 1) {
+        return;
+    }
+    struct Set *msets = malloc(sizeof(struct Set) * n);
+    const bool batch = clset_match_batchable(xcsf);
+    if (batch) {
+        clset_match_batch(xcsf, states, n, msets, cover);
+    }
+    for (int i = 0; i < n; ++i) {
+        const double *state = &states[i * xcsf->x_dim];
+        if (batch) {
+            xcsf->mset = msets[i];
+            clset_match_complete(xcsf, state, cover);
+        } else if (cover) {
+            clset_init(&xcsf->mset);
+            clset_match(xcsf, state);
+        } else {
+            clset_match_batch(xcsf, state, 1, &xcsf->mset, false);
+            clset_match_complete(xcsf, state, false);
+        }
+        func(xcsf, state, i, args);
+    }
+    free(msets);
+}
+
+/**
+ * @brief Stores the maximum payoff predicted by the current match set.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] state The input state of the match set.
+ * @param [in] i The index of the state.
+ * @param [out] args The best action value of each state.
+ */
+static void
+xcs_rl_best_val(struct XCSF *xcsf, const double *state, const int i,
+                void *args)
+{
+    double *vals = args;
+    pa_build(xcsf, state);
+    vals[i] = pa_best_val(xcsf);
+    clset_free(&xcsf->mset);
+}
+
+/**
+ * @brief Returns the maximum payoff predicted for each of a batch of states.
+ * @details The match sets are built without covering and without counting the
+ * states in the classifiers' match statistics, so that the population is
+ * unchanged. Actions without any matching classifiers are predicted 0.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] states The input states (n * x_dim).
+ * @param [in] n The number of states.
+ * @param [out] vals The best action value of each state (n).
+ */
+static void
+xcs_rl_best_vals(struct XCSF *xcsf, const double *states, const int n,
+                 double *vals)
+{
+    const struct Set mset = xcsf->mset;
+    xcs_rl_match_each(xcsf, states, n, false, xcs_rl_best_val, vals);
+    xcsf->mset = mset;
+}
+
+/**
+ * @brief Computes the Q-learning targets of a batch of transitions.
+ * @details Each target is the reward plus, if the resulting state is not
+ * terminal, the discounted maximum payoff predicted for the resulting state.
+ * All of the targets are computed from the current population and only the
+ * resulting states that are not terminal are matched.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] rewards The rewards received (n).
+ * @param [in] next_states The resulting states (n * x_dim).
+ * @param [in] dones Whether each resulting state is terminal (n).
+ * @param [in] n The number of transitions.
+ * @param [out] targets The target payoffs (n).
+ */
+static void
+xcs_rl_targets(struct XCSF *xcsf, const double *rewards,
+               const double *next_states, const bool *dones, const int n,
+               double *targets)
+{
+    double *states = malloc(sizeof(double) * n * xcsf->x_dim);
+    int n_live = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!dones[i]) {
+            memcpy(&states[n_live * xcsf->x_dim],
+                   &next_states[i * xcsf->x_dim],
+                   sizeof(double) * xcsf->x_dim);
+            ++n_live;
+        }
+    }
+    xcs_rl_best_vals(xcsf, states, n_live, targets);
+    for (int i = n - 1; i >= 0; --i) { // values are packed at the front
+        const double best = dones[i] ? 0 : targets[--n_live];
+        targets[i] = rewards[i] + (xcsf->GAMMA * best);
+    }
+    free(states);
+}
+
+/**
+ * @brief Minibatch of transitions replayed from the replay buffer.
+ */
+struct RLReplayBatch {
+    const int *actions; //!< Actions performed
+    const double *targets; //!< Target payoffs
+};
+
+/**
+ * @brief Updates the action set of a replayed transition within the current
+ * match set towards its target.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] state The input state of the match set.
+ * @param [in] i The index of the transition.
+ * @param [in] args The replayed minibatch.
+ */
+static void
+xcs_rl_replay_update(struct XCSF *xcsf, const double *state, const int i,
+                     void *args)
+{
+    const struct RLReplayBatch *batch = args;
+    struct Set aset;
+    clset_init(&aset);
+    const struct Clist *iter = xcsf->mset.list;
+    while (iter != NULL) {
+        if (iter->cl->action == batch->actions[i]) {
+            clset_add(&aset, iter->cl);
+        }
+        iter = iter->next;
+    }
+    if (aset.size > 0) {
+        clset_update(xcsf, &aset, state, &batch->targets[i], false);
+    }
+    clset_free(&aset);
+    clset_free(&xcsf->mset);
+}
+
+/**
+ * @brief Replays a minibatch of transitions sampled from the replay buffer.
+ * @details The targets of the minibatch are computed from the current
+ * population and the action sets of the replayed states are then updated
+ * towards them; the match sets of the replayed states are built in a single
+ * pass over the population. Replay neither covers nor runs the EA and is
+ * excluded from the system error, set size, match, and EA timing statistics,
+ * which therefore continue to reflect the environment.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] replay The replay buffer.
+ */
+static void
+xcs_rl_replay(struct XCSF *xcsf, const struct Replay *replay)
+{
+    const int n = xcsf->REPLAY_BATCH;
+    if (replay->size < 1 || n < 1) {
+        return;
+    }
+    const int x_dim = replay->x_dim;
+    double *states = malloc(sizeof(double) * n * x_dim);
+    double *next_states = malloc(sizeof(double) * n * x_dim);
+    double *rewards = malloc(sizeof(double) * n);
+    double *targets = malloc(sizeof(double) * n);
+    int *actions = malloc(sizeof(int) * n);
+    bool *dones = malloc(sizeof(bool) * n);
+    for (int i = 0; i < n; ++i) {
+        const int j = rand_uniform_int(0, replay->size);
+        memcpy(&states[i * x_dim], &replay->state[j * x_dim],
+               sizeof(double) * x_dim);
+        memcpy(&next_states[i * x_dim], &replay->next_state[j * x_dim],
+               sizeof(double) * x_dim);
+        rewards[i] = replay->reward[j];
+        actions[i] = replay->action[j];
+        dones[i] = replay->done[j];
+    }
+    xcs_rl_targets(xcsf, rewards, next_states, dones, n, targets);
+    const struct Set mset = xcsf->mset;
+    struct RLReplayBatch batch = { actions, targets };
+    xcs_rl_match_each(xcsf, states, n, false, xcs_rl_replay_update, &batch);
+    xcsf->mset = mset;
+    free(states);
+    free(next_states);
+    free(rewards);
+    free(targets);
+    free(actions);
+    free(dones);
+}
+
 /**
  * @brief Executes a reinforcement learning trial using a built-in environment.
+ * @details On exploration trials, if experience replay is enabled, each
+ * transition is stored in the replay buffer and a minibatch of stored
+ * transitions is replayed after every step.
  * @param [in] xcsf The XCSF data structure.
+ * @param [in] replay The experience replay buffer.
  * @param [out] error The mean system prediction error.
  * @param [in] explore Whether this is an exploration or exploitation trial.
  * @return Returns the accuracy for single-step problems and the number of
  * steps taken to reach the goal for multi-step problems.
  */
-static double
-xcs_rl_trial(struct XCSF *xcsf, double *error, const bool explore)
+double
+xcs_rl_trial(struct XCSF *xcsf, struct Replay *replay, double *error,
+             const bool explore)
 {
     env_reset(xcsf);
     param_set_explore(xcsf, explore);
@@ -59,6 +304,12 @@ xcs_rl_trial(struct XCSF *xcsf, double *error, const bool explore)
         *error +=
             xcs_rl_error(xcsf, action, reward, done, env_max_payoff(xcsf));
         xcs_rl_end_step(xcsf, state, action, reward);
+        if (explore && replay->capacity > 0) {
+            replay_add(replay, xcsf->prev_state, action, reward,
+                       env_get_state(xcsf), done);
+            xcs_rl_replay(xcsf, replay);
+            param_set_explore(xcsf, explore);
+        }
         ++steps;
     }
     xcs_rl_end_trial(xcsf);
@@ -69,26 +320,254 @@ xcs_rl_trial(struct XCSF *xcsf, double *error, const bool explore)
     return steps;
 }
 
+/**
+ * @brief Selects an action from the prediction array.
+ * @details A random action is selected with probability P_EXPLORE when
+ * exploring; otherwise the action with the highest prediction.
+ * @param [in] xcsf The XCSF data structure.
+ * @return The selected action.
+ */
+static int
+xcs_rl_select(const struct XCSF *xcsf)
+{
+    if (xcsf->explore && rand_uniform(0, 1) < xcsf->P_EXPLORE) {
+        return pa_rand_action(xcsf);
+    }
+    return pa_best_action(xcsf);
+}
+
+/**
+ * @brief Makes the trial state of an environment instance current.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] trial The environment instance trial state.
+ */
+static void
+xcs_rl_trial_load(struct XCSF *xcsf, const struct RLTrial *trial)
+{
+    xcsf->env = trial->env;
+    xcsf->prev_aset = trial->prev_aset;
+    xcsf->prev_state = trial->prev_state;
+    xcsf->prev_reward = trial->prev_reward;
+    xcsf->prev_pred = trial->prev_pred;
+}
+
+/**
+ * @brief Stores the current trial state of an environment instance.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [out] trial The environment instance trial state.
+ */
+static void
+xcs_rl_trial_store(const struct XCSF *xcsf, struct RLTrial *trial)
+{
+    trial->prev_aset = xcsf->prev_aset;
+    trial->prev_state = xcsf->prev_state;
+    trial->prev_reward = xcsf->prev_reward;
+    trial->prev_pred = xcsf->prev_pred;
+}
+
+/**
+ * @brief Environment instances being stepped in lockstep.
+ */
+struct RLVecStep {
+    struct RLTrial *trials; //!< Environment instance trial states
+    const int *active; //!< Indices of the unfinished instances
+    struct Replay *replay; //!< Experience replay buffer
+    bool explore; //!< Whether this is an exploration trial
+};
+
+/**
+ * @brief Performs one step of an unfinished environment instance using the
+ * current match set.
+ * @details An action is selected and performed, the previous and current
+ * action sets updated, and the EA run.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] state The current state of the instance.
+ * @param [in] i The index of the instance among the unfinished instances.
+ * @param [in] args The environment instances being stepped.
+ */
+static void
+xcs_rl_vec_step_env(struct XCSF *xcsf, const double *state, const int i,
+                    void *args)
+{
+    const struct RLVecStep *step = args;
+    struct RLTrial *trial = &step->trials[step->active[i]];
+    xcs_rl_trial_load(xcsf, trial);
+    clset_init(&xcsf->aset);
+    pa_build(xcsf, state);
+    const int action = xcs_rl_select(xcsf);
+    const double reward = env_execute(xcsf, action);
+    const bool done = env_is_done(xcsf);
+    xcs_rl_update(xcsf, state, action, reward, done);
+    trial->error +=
+        xcs_rl_error(xcsf, action, reward, done, env_max_payoff(xcsf));
+    xcs_rl_end_step(xcsf, state, action, reward);
+    if (step->explore && step->replay->capacity > 0) {
+        replay_add(step->replay, xcsf->prev_state, action, reward,
+                   env_get_state(xcsf), done);
+        xcs_rl_replay(xcsf, step->replay);
+        param_set_explore(xcsf, step->explore);
+    }
+    xcs_rl_trial_store(xcsf, trial);
+    trial->reward = reward;
+    ++(trial->steps);
+    trial->done = done || trial->steps >= xcsf->TELETRANSPORTATION;
+}
+
+/**
+ * @brief Performs one step of all unfinished environment instances.
+ * @details The match sets for the current states of all instances are built
+ * in a single pass over the population, except for rules, which are matched
+ * as each instance is processed. The instances are processed in index order
+ * so that the results are deterministic for a given random seed regardless
+ * of the number of threads.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] trials The environment instance trial states.
+ * @param [in] n The number of environment instances.
+ * @param [in] replay The experience replay buffer.
+ */
+static void
+xcs_rl_vec_step(struct XCSF *xcsf, struct RLTrial *trials, const int n,
+                struct Replay *replay)
+{
+    double *states = malloc(sizeof(double) * xcsf->x_dim * n);
+    int *active = malloc(sizeof(int) * n);
+    int n_active = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!trials[i].done) {
+            xcsf->env = trials[i].env;
+            memcpy(&states[n_active * xcsf->x_dim], env_get_state(xcsf),
+                   sizeof(double) * xcsf->x_dim);
+            active[n_active] = i;
+            ++n_active;
+        }
+    }
+    struct RLVecStep step = { trials, active, replay, xcsf->explore };
+    xcs_rl_match_each(xcsf, states, n_active, true, xcs_rl_vec_step_env,
+                      &step);
+    free(states);
+    free(active);
+}
+
+/**
+ * @brief Executes a reinforcement learning trial in each of several
+ * environment instances stepped in lockstep.
+ * @details Deleted classifiers are retained in the kill set until all of the
+ * instances have finished since they may be referenced by any previous
+ * action set.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] trials The environment instance trial states.
+ * @param [in] n The number of environment instances.
+ * @param [in] replay The experience replay buffer.
+ * @param [out] error The mean system prediction error.
+ * @param [in] explore Whether this is an exploration or exploitation trial.
+ * @return Returns the mean accuracy for single-step problems and the mean
+ * number of steps taken to reach the goal for multi-step problems.
+ */
+double
+xcs_rl_vec_trial(struct XCSF *xcsf, struct RLTrial *trials, const int n,
+                 struct Replay *replay, double *error, const bool explore)
+{
+    void *env = xcsf->env;
+    param_set_explore(xcsf, explore);
+    clset_init(&xcsf->kset);
+    for (int i = 0; i < n; ++i) {
+        xcsf->env = trials[i].env;
+        env_reset(xcsf);
+        clset_init(&trials[i].prev_aset);
+        trials[i].prev_state = malloc(sizeof(double) * xcsf->x_dim);
+        trials[i].prev_reward = 0;
+        trials[i].prev_pred = 0;
+        trials[i].reward = 0;
+        trials[i].error = 0;
+        trials[i].steps = 0;
+        trials[i].done = (xcsf->TELETRANSPORTATION < 1);
+    }
+    bool done = false;
+    while (!done) {
+        xcs_rl_vec_step(xcsf, trials, n, replay);
+        done = true;
+        for (int i = 0; i < n; ++i) {
+            done = done && trials[i].done;
+        }
+    }
+    xcsf->env = env;
+    const bool multistep = env_multistep(xcsf);
+    double perf = 0;
+    *error = 0;
+    for (int i = 0; i < n; ++i) {
+        if (trials[i].steps > 0) {
+            *error += trials[i].error / trials[i].steps;
+        }
+        if (multistep) {
+            perf += trials[i].steps;
+        } else if (trials[i].reward > 0) {
+            perf += 1;
+        }
+        clset_free(&trials[i].prev_aset);
+        free(trials[i].prev_state);
+    }
+    clset_kill(xcsf, &xcsf->kset);
+    *error /= n;
+    return perf / n;
+}
+
 /**
  * @brief Executes a reinforcement learning experiment.
+ * @details If N_ENVS is greater than one, each trial is performed in N_ENVS
+ * independent instances of the environment stepped in lockstep. Stateful DGP
+ * graphs cannot retain a separate state for each instance, so are rejected.
  * @param [in] xcsf The XCSF data structure.
  * @return The mean number of steps to goal.
  */
 double
 xcs_rl_exp(struct XCSF *xcsf)
 {
+    publish_check(xcsf);
     double error = 0; // prediction error: individual trial
     double werr = 0; // prediction error: windowed total
     double tperf = 0; // steps to goal: total over all trials
     double wperf = 0; // steps to goal: windowed total
-    for (int cnt = 0; cnt < xcsf->MAX_TRIALS; ++cnt) {
-        xcs_rl_trial(xcsf, &error, true); // explore
-        const double perf = xcs_rl_trial(xcsf, &error, false); // exploit
+    struct Replay replay;
+    replay_init(&replay, xcsf->x_dim, xcsf->REPLAY_SIZE);
+    const int n_envs = xcsf->N_ENVS;
+    if (n_envs > 1 && xcsf->STATEFUL &&
+        (xcsf->cond->type == COND_TYPE_DGP ||
+         xcsf->cond->type == RULE_TYPE_DGP)) {
+        printf("xcs_rl_exp(): N_ENVS > 1 requires STATEFUL=false with DGP\n");
+        exit(EXIT_FAILURE);
+    }
+    struct RLTrial *trials = malloc(sizeof(struct RLTrial) * n_envs);
+    trials[0].env = xcsf->env;
+    for (int i = 1; i < n_envs; ++i) {
+        trials[i].env = env_copy(xcsf);
+    }
+    int cnt = checkpoint_resume(xcsf, &tperf, &wperf, &werr);
+    for (; cnt < xcsf->MAX_TRIALS; ++cnt) {
+        double perf = 0;
+        if (n_envs > 1) {
+            xcs_rl_vec_trial(xcsf, trials, n_envs, &replay, &error, true);
+            perf = xcs_rl_vec_trial(xcsf, trials, n_envs, &replay, &error,
+                                    false);
+        } else {
+            xcs_rl_trial(xcsf, &replay, &error, true); // explore
+            perf = xcs_rl_trial(xcsf, &replay, &error, false); // exploit
+        }
         wperf += perf;
         tperf += perf;
         werr += error;
         perf_print(xcsf, &wperf, &werr, cnt);
+        checkpoint_trial(xcsf, cnt, tperf, wperf, werr);
+        publish_trial(xcsf, cnt);
     }
+    checkpoint_wait(xcsf);
+    ea_async_flush(xcsf);
+    for (int i = 1; i < n_envs; ++i) {
+        xcsf->env = trials[i].env;
+        env_free(xcsf);
+    }
+    xcsf->env = trials[0].env;
+    free(trials);
+    replay_free(&replay);
     return tperf / xcsf->MAX_TRIALS;
 }
 
@@ -104,20 +583,95 @@ double
 xcs_rl_fit(struct XCSF *xcsf, const double *state, const int action,
            const double reward)
 {
-    xcs_rl_init_trial(xcsf);
-    xcs_rl_init_step(xcsf);
-    clset_match(xcsf, state);
-    pa_build(xcsf, state);
-    const double prediction = pa_val(xcsf, action);
-    const double error = (xcsf->loss_ptr)(xcsf, &prediction, &reward);
-    param_set_explore(xcsf, true); // ensure EA is executed
-    xcs_rl_update(xcsf, state, action, reward, true);
-    xcs_rl_end_step(xcsf, state, action, reward);
-    xcs_rl_end_trial(xcsf);
-    xcsf->error += (error - xcsf->error) * xcsf->BETA;
+    clset_init(&xcsf->kset);
+    const double error = xcs_rl_learn(xcsf, state, action, reward);
+    clset_kill(xcsf, &xcsf->kset);
+    ea_async_flush(xcsf);
     return error;
 }
 
+/**
+ * @brief Updates the action sets for a batch of transitions.
+ * @details Each transition is a (state, action, reward, next_state, done)
+ * tuple, such as those sampled from a replay buffer. The action set of each
+ * state is updated towards the Q-learning target: the reward plus, if the
+ * next state is not terminal, the discounted maximum payoff predicted for
+ * the next state. The targets of all of the transitions are computed from the
+ * population before any are learned, and the transitions are then learned in
+ * the order supplied.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] states The input states (n * x_dim).
+ * @param [in] actions The actions performed (n).
+ * @param [in] rewards The rewards received (n).
+ * @param [in] next_states The resulting states (n * x_dim).
+ * @param [in] dones Whether each resulting state is terminal (n).
+ * @param [in] n The number of transitions.
+ * @return The mean prediction error.
+ */
+double
+xcs_rl_fit_batch(struct XCSF *xcsf, const double *states, const int *actions,
+                 const double *rewards, const double *next_states,
+                 const bool *dones, const int n)
+{
+    for (int i = 0; i < n; ++i) {
+        if (actions[i] < 0 || actions[i] >= xcsf->n_actions) {
+            printf("xcs_rl_fit_batch(): invalid action: %d\n", actions[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    double *targets = malloc(sizeof(double) * n);
+    xcs_rl_targets(xcsf, rewards, next_states, dones, n, targets);
+    double error = 0;
+    clset_init(&xcsf->kset);
+    for (int i = 0; i < n; ++i) {
+        error += xcs_rl_learn(xcsf, &states[i * xcsf->x_dim], actions[i],
+                              targets[i]);
+    }
+    clset_kill(xcsf, &xcsf->kset);
+    free(targets);
+    ea_async_flush(xcsf);
+    return (n > 0) ? error / n : 0;
+}
+
+/**
+ * @brief Selects actions to perform for a batch of states.
+ * @details Exploration is performed as in xcs_rl_decision() if the current
+ * explore flag is set. The match and kill sets of any ongoing trial are
+ * preserved; rules deleted by covering are freed on return unless the
+ * trial's sets may still reference them, in which case they are freed when
+ * the trial ends.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] states The input states (n * x_dim).
+ * @param [out] actions The selected actions (n).
+ * @param [in] n The number of states.
+ */
+void
+xcs_rl_decision_batch(struct XCSF *xcsf, const double *states, int *actions,
+                      const int n)
+{
+    const struct Set mset = xcsf->mset;
+    struct Set kset = xcsf->kset;
+    clset_init(&xcsf->kset);
+    for (int i = 0; i < n; ++i) {
+        const double *state = &states[i * xcsf->x_dim];
+        clset_init(&xcsf->mset);
+        actions[i] = xcs_rl_decision(xcsf, state);
+        clset_free(&xcsf->mset);
+    }
+    xcsf->mset = mset;
+    if (mset.list != NULL || xcsf->prev_aset.list != NULL) {
+        const struct Clist *iter = xcsf->kset.list;
+        while (iter != NULL) {
+            clset_add(&kset, iter->cl);
+            iter = iter->next;
+        }
+        clset_free(&xcsf->kset);
+    } else {
+        clset_kill(xcsf, &xcsf->kset);
+    }
+    xcsf->kset = kset;
+}
+
 /**
  * @brief Initialises a reinforcement learning trial.
  * @param [in] xcsf The XCSF data structure.
@@ -147,6 +701,7 @@ xcs_rl_end_trial(struct XCSF *xcsf)
     clset_free(&xcsf->prev_aset);
     clset_kill(xcsf, &xcsf->kset);
     free(xcsf->prev_state);
+    ea_async_flush(xcsf);
 }
 
 /**
@@ -248,8 +803,5 @@ xcs_rl_decision(struct XCSF *xcsf, const double *state)
 {
     clset_match(xcsf, state);
     pa_build(xcsf, state);
-    if (xcsf->explore && rand_uniform(0, 1) < xcsf->P_EXPLORE) {
-        return pa_rand_action(xcsf);
-    }
-    return pa_best_action(xcsf);
+    return xcs_rl_select(xcsf);
 }
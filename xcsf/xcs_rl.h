@@ -23,8 +23,25 @@
 
 #pragma once
 
+#include "replay.h"
 #include "xcsf.h"
 
+/**
+ * @brief Trial state of one of several environment instances that are
+ * stepped in lockstep while sharing the same population.
+ */
+struct RLTrial {
+    void *env; //!< Environment instance
+    struct Set prev_aset; //!< Previous action set
+    double *prev_state; //!< Previous environment state
+    double prev_reward; //!< Previous reward
+    double prev_pred; //!< Previous prediction
+    double reward; //!< Most recent reward
+    double error; //!< Sum of the prediction errors over the steps taken
+    int steps; //!< Number of steps taken
+    bool done; //!< Whether the trial has finished
+};
+
 double
 xcs_rl_error(struct XCSF *xcsf, const int action, const double reward,
              const bool reset, const double max_p);
@@ -32,9 +49,21 @@ xcs_rl_error(struct XCSF *xcsf, const int action, const double reward,
 double
 xcs_rl_exp(struct XCSF *xcsf);
 
+double
+xcs_rl_trial(struct XCSF *xcsf, struct Replay *replay, double *error,
+             const bool explore);
+
+double
+xcs_rl_vec_trial(struct XCSF *xcsf, struct RLTrial *trials, const int n,
+                 struct Replay *replay, double *error, const bool explore);
+
 int
 xcs_rl_decision(struct XCSF *xcsf, const double *state);
 
+void
+xcs_rl_decision_batch(struct XCSF *xcsf, const double *states, int *actions,
+                      const int n);
+
 void
 xcs_rl_end_step(struct XCSF *xcsf, const double *state, const int action,
                 const double reward);
@@ -55,3 +84,8 @@ xcs_rl_update(struct XCSF *xcsf, const double *state, const int action,
 double
 xcs_rl_fit(struct XCSF *xcsf, const double *state, const int action,
            const double reward);
+
+double
+xcs_rl_fit_batch(struct XCSF *xcsf, const double *states, const int *actions,
+                 const double *rewards, const double *next_states,
+                 const bool *dones, const int n);
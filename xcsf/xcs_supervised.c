@@ -22,12 +22,15 @@
  */
 
 #include "xcs_supervised.h"
+#include "checkpoint.h"
 #include "clset.h"
 #include "ea.h"
+#include "island.h"
 #include "loss.h"
 #include "pa.h"
 #include "param.h"
 #include "perf.h"
+#include "publish.h"
 #include "utils.h"
 
 /**
@@ -68,9 +71,123 @@ xcs_supervised_trial(struct XCSF *xcsf, const double *x, const double *y)
     clset_free(&xcsf->mset);
 }
 
+/**
+ * @brief Executes a single XCSF learning trial on a training sample.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] x The feature variables.
+ * @param [in] y The labelled variables.
+ * @return The XCSF training error using the loss function.
+ */
+static double
+xcs_supervised_learn(struct XCSF *xcsf, const double *x, const double *y)
+{
+    param_set_explore(xcsf, true);
+    xcs_supervised_trial(xcsf, x, y);
+    const double error = (xcsf->loss_ptr)(xcsf, xcsf->pa, y);
+    xcsf->error += (error - xcsf->error) * xcsf->BETA;
+    return error;
+}
+
+/**
+ * @brief Executes a single XCSF test trial on a sample from the test data.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] test_data The input data to use for testing.
+ * @param [in] cnt The current sequence counter.
+ * @param [in] shuffle Whether to select the sample randomly.
+ * @return The XCSF testing error using the loss function.
+ */
+static double
+xcs_supervised_test(struct XCSF *xcsf, const struct Input *test_data,
+                    const int cnt, const bool shuffle)
+{
+    if (test_data == NULL) {
+        return 0;
+    }
+    const int row = xcs_supervised_sample(test_data, cnt, shuffle);
+    const double *x = &test_data->x[row * test_data->x_dim];
+    const double *y = &test_data->y[row * test_data->y_dim];
+    param_set_explore(xcsf, false);
+    xcs_supervised_trial(xcsf, x, y);
+    return (xcsf->loss_ptr)(xcsf, xcsf->pa, y);
+}
+
+/**
+ * @brief Executes MAX_TRIALS number of learning iterations on each of ISLANDS
+ * populations in parallel, migrating classifiers every MIGRATION_TRIALS.
+ * @details Each island processes the same sequence of training samples, or
+ * its own random samples if shuffled. Performance is reported as the average
+ * over the islands. On completion the island populations are merged into the
+ * population of XCSF. Checkpointing is not performed and, if publishing is
+ * enabled, a snapshot is only published once the islands are merged.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] train_data The input data to use for training.
+ * @param [in] test_data The input data to use for testing.
+ * @param [in] shuffle Whether to randomise the instances during training.
+ * @return The average XCSF training error using the loss function.
+ */
+static double
+xcs_supervised_fit_islands(struct XCSF *xcsf, const struct Input *train_data,
+                           const struct Input *test_data, const bool shuffle)
+{
+    struct Islands isl;
+    island_init(xcsf, &isl);
+    unsigned char *state = malloc(rand_state_size());
+    rand_state_get(state);
+    const int n = isl.n;
+    const int m = xcsf->MIGRATION_TRIALS;
+    double *error = malloc(sizeof(double) * n * m);
+    double *terror = malloc(sizeof(double) * n * m);
+    double err = 0; // training error: total over all trials
+    double werr = 0; // training error: windowed total
+    double wterr = 0; // testing error: windowed total
+    for (int start = 0; start < xcsf->MAX_TRIALS; start += m) {
+        const int end =
+            (start + m < xcsf->MAX_TRIALS) ? start + m : xcsf->MAX_TRIALS;
+#ifdef PARALLEL
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < n; ++i) {
+            struct XCSF *x = &isl.xcsf[i];
+            island_rand_enter(&isl, i);
+            for (int cnt = start; cnt < end; ++cnt) {
+                const int row = xcs_supervised_sample(train_data, cnt, shuffle);
+                const double *tx = &train_data->x[row * train_data->x_dim];
+                const double *ty = &train_data->y[row * train_data->y_dim];
+                error[i * m + cnt - start] = xcs_supervised_learn(x, tx, ty);
+                terror[i * m + cnt - start] =
+                    xcs_supervised_test(x, test_data, cnt, shuffle);
+            }
+            island_rand_leave(&isl, i);
+        }
+        if (end < xcsf->MAX_TRIALS) {
+            island_migrate(&isl);
+        }
+        struct XCSF view = *xcsf; // reports the size of all islands
+        view.pset.size = island_pset_size(&isl);
+        for (int cnt = start; cnt < end; ++cnt) {
+            for (int i = 0; i < n; ++i) {
+                werr += error[i * m + cnt - start] / n;
+                err += error[i * m + cnt - start] / n;
+                wterr += terror[i * m + cnt - start] / n;
+            }
+            perf_print(&view, &werr, &wterr, cnt);
+        }
+    }
+    rand_state_set(state);
+    island_merge(xcsf, &isl);
+    if (xcsf->PUBLISH_TRIALS > 0) {
+        publish_snapshot(xcsf);
+    }
+    free(state);
+    free(error);
+    free(terror);
+    return err / xcsf->MAX_TRIALS;
+}
+
 /**
  * @brief Executes MAX_TRIALS number of XCSF learning iterations using the
  * training data and test iterations using the test data.
+ * @details If ISLANDS is greater than one, the island model is used.
  * @param [in] xcsf The XCSF data structure.
  * @param [in] train_data The input data to use for training.
  * @param [in] test_data The input data to use for testing.
@@ -81,34 +198,68 @@ double
 xcs_supervised_fit(struct XCSF *xcsf, const struct Input *train_data,
                    const struct Input *test_data, const bool shuffle)
 {
+    publish_check(xcsf);
+    if (xcsf->ISLANDS > 1) {
+        return xcs_supervised_fit_islands(xcsf, train_data, test_data, shuffle);
+    }
     double err = 0; // training error: total over all trials
     double werr = 0; // training error: windowed total
     double wterr = 0; // testing error: windowed total
-    for (int cnt = 0; cnt < xcsf->MAX_TRIALS; ++cnt) {
-        // training sample
-        int row = xcs_supervised_sample(train_data, cnt, shuffle);
+    int cnt = checkpoint_resume(xcsf, &err, &werr, &wterr);
+    for (; cnt < xcsf->MAX_TRIALS; ++cnt) {
+        const int row = xcs_supervised_sample(train_data, cnt, shuffle);
         const double *x = &train_data->x[row * train_data->x_dim];
         const double *y = &train_data->y[row * train_data->y_dim];
-        param_set_explore(xcsf, true);
-        xcs_supervised_trial(xcsf, x, y);
-        const double error = (xcsf->loss_ptr)(xcsf, xcsf->pa, y);
+        const double error = xcs_supervised_learn(xcsf, x, y);
         werr += error;
         err += error;
-        xcsf->error += (error - xcsf->error) * xcsf->BETA;
-        // test sample
-        if (test_data != NULL) {
-            row = xcs_supervised_sample(test_data, cnt, shuffle);
-            x = &test_data->x[row * test_data->x_dim];
-            y = &test_data->y[row * test_data->y_dim];
-            param_set_explore(xcsf, false);
-            xcs_supervised_trial(xcsf, x, y);
-            wterr += (xcsf->loss_ptr)(xcsf, xcsf->pa, y);
-        }
+        wterr += xcs_supervised_test(xcsf, test_data, cnt, shuffle);
         perf_print(xcsf, &werr, &wterr, cnt);
+        checkpoint_trial(xcsf, cnt, err, werr, wterr);
+        publish_trial(xcsf, cnt);
     }
+    checkpoint_wait(xcsf);
+    ea_async_flush(xcsf);
     return err / xcsf->MAX_TRIALS;
 }
 
+/**
+ * @brief Executes up to MAX_TRIALS number of XCSF learning iterations using
+ * training data streamed from disk and test iterations using the test data.
+ * @details Training stops early if the stream reaches the end of its data.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] train_data The streaming input data to use for training.
+ * @param [in] test_data The input data to use for testing.
+ * @return The average XCSF training error using the loss function.
+ */
+double
+xcs_supervised_fit_stream(struct XCSF *xcsf, struct Stream *train_data,
+                          const struct Input *test_data)
+{
+    if (train_data->x_dim != xcsf->x_dim || train_data->y_dim != xcsf->y_dim) {
+        printf("xcs_supervised_fit_stream(): stream dimensions mismatch\n");
+        exit(EXIT_FAILURE);
+    }
+    publish_check(xcsf);
+    double err = 0; // training error: total over all trials
+    double werr = 0; // training error: windowed total
+    double wterr = 0; // testing error: windowed total
+    const double *x = NULL;
+    const double *y = NULL;
+    int cnt = 0;
+    while (cnt < xcsf->MAX_TRIALS && stream_next(train_data, &x, &y)) {
+        const double error = xcs_supervised_learn(xcsf, x, y);
+        werr += error;
+        err += error;
+        wterr += xcs_supervised_test(xcsf, test_data, cnt, train_data->shuffle);
+        perf_print(xcsf, &werr, &wterr, cnt);
+        publish_trial(xcsf, cnt);
+        ++cnt;
+    }
+    ea_async_flush(xcsf);
+    return (cnt > 0) ? err / cnt : 0;
+}
+
 /**
  * @brief Calculates the XCSF predictions for the provided input.
  * @param [in] xcsf The XCSF data structure.
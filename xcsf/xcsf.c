@@ -21,13 +21,19 @@
  * @brief System-level functions for initialising, saving, loading, etc.
  */
 
+#include "action.h"
+#include "checkpoint.h"
 #include "cl.h"
 #include "clset.h"
 #include "cond_neural.h"
+#include "condition.h"
+#include "ea.h"
 #include "loss.h"
 #include "pa.h"
 #include "param.h"
 #include "pred_neural.h"
+#include "prof.h"
+#include "publish.h"
 
 /**
  * @brief Initialises XCSF with an empty population.
@@ -41,8 +47,13 @@ xcsf_init(struct XCSF *xcsf)
     xcsf->mset_size = 0;
     xcsf->aset_size = 0;
     xcsf->mfrac = 0;
+    xcsf->checkpoint = NULL;
+    xcsf->ea_async = NULL;
+    prof_init(xcsf);
+    publish_init(xcsf);
     clset_init(&xcsf->pset);
     clset_init(&xcsf->prev_pset);
+    xcsf->pset_mem = 0;
 }
 
 /**
@@ -57,8 +68,13 @@ xcsf_free(struct XCSF *xcsf)
     xcsf->mset_size = 0;
     xcsf->aset_size = 0;
     xcsf->mfrac = 0;
+    checkpoint_free(xcsf);
+    ea_async_free(xcsf);
+    prof_free(xcsf);
+    publish_free(xcsf);
     clset_kill(xcsf, &xcsf->pset);
     clset_kill(xcsf, &xcsf->prev_pset);
+    xcsf->pset_mem = 0;
 }
 
 /**
@@ -75,8 +91,249 @@ xcsf_print_pset(const struct XCSF *xcsf, const bool print_cond,
     clset_print(xcsf, &xcsf->pset, print_cond, print_act, print_pred);
 }
 
+/**
+ * @brief Opens a stream that writes to a growable in-memory buffer.
+ * @param [out] buf The buffer; valid after the stream is closed.
+ * @param [out] len The length of the buffer; valid after the stream is closed.
+ * @return Pointer to the opened stream.
+ */
+FILE *
+xcsf_mem_open_write(char **buf, size_t *len)
+{
+#ifdef _WIN32
+    (void) buf;
+    (void) len;
+    FILE *fp = tmpfile();
+#else
+    FILE *fp = open_memstream(buf, len);
+#endif
+    if (fp == NULL) {
+        printf("xcsf_mem_open_write(): %s.\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    return fp;
+}
+
+/**
+ * @brief Closes an in-memory write stream and returns its contents.
+ * @param [in] fp The stream to close.
+ * @param [out] buf The buffer written (to be freed by the caller).
+ * @param [out] len The number of bytes written.
+ */
+void
+xcsf_mem_close_write(FILE *fp, char **buf, size_t *len)
+{
+#ifdef _WIN32
+    *len = (size_t) ftell(fp);
+    *buf = malloc(*len);
+    rewind(fp);
+    if (fread(*buf, 1, *len, fp) != *len) {
+        printf("xcsf_mem_close_write(): failed to read buffer\n");
+        exit(EXIT_FAILURE);
+    }
+#else
+    (void) buf;
+    (void) len;
+#endif
+    fclose(fp);
+}
+
+/**
+ * @brief Opens a stream that reads from an in-memory buffer.
+ * @param [in] buf The buffer to read.
+ * @param [in] len The length of the buffer.
+ * @return Pointer to the opened stream.
+ */
+FILE *
+xcsf_mem_open_read(const char *buf, const size_t len)
+{
+#ifdef _WIN32
+    FILE *fp = tmpfile();
+    if (fp != NULL) {
+        fwrite(buf, 1, len, fp);
+        rewind(fp);
+    }
+#else
+    FILE *fp = fmemopen((void *) (uintptr_t) buf, len, "rb");
+#endif
+    if (fp == NULL) {
+        printf("xcsf_mem_open_read(): %s.\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    return fp;
+}
+
+/**
+ * @brief Writes a size-prefixed section to a stream.
+ * @details The section is written in place and its size is filled in
+ * afterwards, so that the contents are only copied once.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the stream to write the section.
+ * @param [in] save The function that writes the section contents.
+ * @return The total number of elements written.
+ */
+static size_t
+xcsf_section_save(const struct XCSF *xcsf, FILE *fp,
+                  size_t (*save)(const struct XCSF *, FILE *))
+{
+    const long start = ftell(fp);
+    uint64_t size = 0;
+    size_t s = fwrite(&size, sizeof(uint64_t), 1, fp);
+    s += save(xcsf, fp);
+    const long stop = ftell(fp);
+    size = (uint64_t) (stop - start) - sizeof(uint64_t);
+    fseek(fp, start, SEEK_SET);
+    fwrite(&size, sizeof(uint64_t), 1, fp);
+    fseek(fp, stop, SEEK_SET);
+    return s;
+}
+
+/**
+ * @brief Reads a size-prefixed section from a stream.
+ * @details Exits if the section is truncated or if the number of bytes
+ * consumed by the loader differs from the recorded section size.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the stream positioned at the section.
+ * @param [in] len The length of the whole stream in bytes.
+ * @param [in] load The function that reads the section contents.
+ * @return The total number of elements read.
+ */
+static size_t
+xcsf_section_load(struct XCSF *xcsf, FILE *fp, const size_t len,
+                  size_t (*load)(struct XCSF *, FILE *))
+{
+    uint64_t size = 0;
+    if (fread(&size, sizeof(uint64_t), 1, fp) != 1) {
+        printf("xcsf_section_load(): truncated data\n");
+        exit(EXIT_FAILURE);
+    }
+    const long start = ftell(fp);
+    if (size == 0 || size > (uint64_t) (len - (size_t) start)) {
+        printf("xcsf_section_load(): invalid section size: %" PRIu64 "\n",
+               size);
+        exit(EXIT_FAILURE);
+    }
+    size_t s = load(xcsf, fp);
+    s += 1;
+    const uint64_t read = (uint64_t) (ftell(fp) - start);
+    if (feof(fp) || ferror(fp) || read != size) {
+        printf("xcsf_section_load(): read %" PRIu64 " of %" PRIu64
+               " bytes\n",
+               read, size);
+        exit(EXIT_FAILURE);
+    }
+    return s;
+}
+
+/**
+ * @brief Writes the version number and parameter section to a stream.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] fp Pointer to the stream.
+ * @return The total number of elements written.
+ */
+static size_t
+xcsf_serialise_head(const struct XCSF *xcsf, FILE *fp)
+{
+    size_t s = 0;
+    s += fwrite(&VERSION_MAJOR, sizeof(int), 1, fp);
+    s += fwrite(&VERSION_MINOR, sizeof(int), 1, fp);
+    s += fwrite(&VERSION_BUILD, sizeof(int), 1, fp);
+    s += xcsf_section_save(xcsf, fp, param_save);
+    return s;
+}
+
+/**
+ * @brief Writes the current state of XCSF to a growable in-memory buffer.
+ * @details The buffer contains the version number followed by size-prefixed
+ * parameter and population sections.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [out] buf The serialised state (to be freed by the caller).
+ * @param [out] len The length of the serialised state in bytes.
+ * @return The total number of elements written.
+ */
+size_t
+xcsf_serialise(const struct XCSF *xcsf, char **buf, size_t *len)
+{
+    FILE *fp = xcsf_mem_open_write(buf, len);
+    size_t s = xcsf_serialise_head(xcsf, fp);
+    s += xcsf_section_save(xcsf, fp, clset_pset_save);
+    xcsf_mem_close_write(fp, buf, len);
+    return s;
+}
+
+/**
+ * @brief Writes the version number and parameters of XCSF to a buffer.
+ * @details Followed by the buffer written by xcsf_serialise_pset(), the
+ * result is identical to that of xcsf_serialise().
+ * @param [in] xcsf The XCSF data structure.
+ * @param [out] buf The serialised parameters (to be freed by the caller).
+ * @param [out] len The length of the serialised parameters in bytes.
+ * @return The total number of elements written.
+ */
+size_t
+xcsf_serialise_params(const struct XCSF *xcsf, char **buf, size_t *len)
+{
+    FILE *fp = xcsf_mem_open_write(buf, len);
+    const size_t s = xcsf_serialise_head(xcsf, fp);
+    xcsf_mem_close_write(fp, buf, len);
+    return s;
+}
+
+/**
+ * @brief Writes the population section of XCSF to a buffer.
+ * @details Only the population and the x_dim and y_dim parameters are read.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [out] buf The serialised population (to be freed by the caller).
+ * @param [out] len The length of the serialised population in bytes.
+ * @return The total number of elements written.
+ */
+size_t
+xcsf_serialise_pset(const struct XCSF *xcsf, char **buf, size_t *len)
+{
+    FILE *fp = xcsf_mem_open_write(buf, len);
+    const size_t s = xcsf_section_save(xcsf, fp, clset_pset_save);
+    xcsf_mem_close_write(fp, buf, len);
+    return s;
+}
+
+/**
+ * @brief Reads the state of XCSF from an in-memory buffer.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] buf The serialised state.
+ * @param [in] len The length of the serialised state in bytes.
+ * @return The total number of elements read.
+ */
+size_t
+xcsf_deserialise(struct XCSF *xcsf, const char *buf, const size_t len)
+{
+    if (xcsf->pset.size > 0) {
+        clset_kill(xcsf, &xcsf->pset);
+        clset_init(&xcsf->pset);
+    }
+    int version[3] = { 0, 0, 0 };
+    if (len < sizeof(version)) {
+        printf("xcsf_deserialise(): truncated data\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(version, buf, sizeof(version));
+    if (version[0] != VERSION_MAJOR || version[1] != VERSION_MINOR) {
+        printf("Error loading XCSF: Version mismatch. ");
+        printf("This version: %d.%d\n", VERSION_MAJOR, VERSION_MINOR);
+        printf("Loaded version: %d.%d\n", version[0], version[1]);
+        exit(EXIT_FAILURE);
+    }
+    FILE *fp = xcsf_mem_open_read(buf, len);
+    fseek(fp, sizeof(version), SEEK_SET);
+    size_t s = 3;
+    s += xcsf_section_load(xcsf, fp, len, param_load);
+    s += xcsf_section_load(xcsf, fp, len, clset_pset_load);
+    fclose(fp);
+    return s;
+}
+
 /**
  * @brief Writes the current state of XCSF to a file.
+ * @details The state is serialised in memory and written with a single call.
  * @param [in] xcsf The XCSF data structure.
  * @param [in] filename The name of the output file.
  * @return The total number of elements written.
@@ -89,18 +346,21 @@ xcsf_save(const struct XCSF *xcsf, const char *filename)
         printf("Error saving file: %s. %s.\n", filename, strerror(errno));
         exit(EXIT_FAILURE);
     }
-    size_t s = 0;
-    s += fwrite(&VERSION_MAJOR, sizeof(int), 1, fp);
-    s += fwrite(&VERSION_MINOR, sizeof(int), 1, fp);
-    s += fwrite(&VERSION_BUILD, sizeof(int), 1, fp);
-    s += param_save(xcsf, fp);
-    s += clset_pset_save(xcsf, fp);
+    char *buf = NULL;
+    size_t len = 0;
+    const size_t s = xcsf_serialise(xcsf, &buf, &len);
+    if (fwrite(buf, 1, len, fp) != len) {
+        printf("Error saving file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    free(buf);
     fclose(fp);
     return s;
 }
 
 /**
  * @brief Reads the state of XCSF from a file.
+ * @details The whole file is read with a single call and parsed from memory.
  * @param [in] xcsf The XCSF data structure.
  * @param [in] filename The name of the input file.
  * @return The total number of elements read.
@@ -108,45 +368,240 @@ xcsf_save(const struct XCSF *xcsf, const char *filename)
 size_t
 xcsf_load(struct XCSF *xcsf, const char *filename)
 {
-    if (xcsf->pset.size > 0) {
-        clset_kill(xcsf, &xcsf->pset);
-        clset_init(&xcsf->pset);
-    }
     FILE *fp = fopen(filename, "rb");
     if (fp == 0) {
         printf("Error loading file: %s. %s.\n", filename, strerror(errno));
         exit(EXIT_FAILURE);
     }
-    size_t s = 0;
-    int major = 0;
-    int minor = 0;
-    int build = 0;
-    s += fread(&major, sizeof(int), 1, fp);
-    s += fread(&minor, sizeof(int), 1, fp);
-    s += fread(&build, sizeof(int), 1, fp);
-    if (major != VERSION_MAJOR || minor != VERSION_MINOR) {
-        printf("Error loading file: %s. Version mismatch. ", filename);
-        printf("This version: %d.%d\n", VERSION_MAJOR, VERSION_MINOR);
-        printf("Loaded version: %d.%d\n", major, minor);
-        fclose(fp);
+    fseek(fp, 0, SEEK_END);
+    const long len = ftell(fp);
+    rewind(fp);
+    if (len < 0) {
+        printf("Error loading file: %s. %s.\n", filename, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    char *buf = malloc(len);
+    if (fread(buf, 1, len, fp) != (size_t) len) {
+        printf("Error loading file: %s. Failed to read.\n", filename);
         exit(EXIT_FAILURE);
     }
-    s += param_load(xcsf, fp);
-    s += clset_pset_load(xcsf, fp);
     fclose(fp);
+    const size_t s = xcsf_deserialise(xcsf, buf, len);
+    free(buf);
     return s;
 }
 
+/**
+ * @brief Genotype of a classifier used to detect duplicates when merging.
+ */
+struct MergeKey {
+    struct Cl *cl; //!< The classifier
+    char *buf; //!< Serialised condition and action
+    size_t len; //!< Length of the serialised condition and action
+    uint64_t hash; //!< FNV-1a hash of the serialised condition and action
+    int index; //!< Position of the classifier in the population
+};
+
+/**
+ * @brief Orders merge keys so that identical genotypes are adjacent.
+ * @param [in] a Pointer to the first merge key.
+ * @param [in] b Pointer to the second merge key.
+ * @return Negative, zero, or positive as the first key orders before, equal
+ * to, or after the second.
+ */
+static int
+xcsf_merge_cmp(const void *a, const void *b)
+{
+    const struct MergeKey *ka = a;
+    const struct MergeKey *kb = b;
+    if (ka->hash != kb->hash) {
+        return (ka->hash < kb->hash) ? -1 : 1;
+    }
+    if (ka->len != kb->len) {
+        return (ka->len < kb->len) ? -1 : 1;
+    }
+    const int c = memcmp(ka->buf, kb->buf, ka->len);
+    if (c != 0) {
+        return c;
+    }
+    return ka->index - kb->index;
+}
+
+/**
+ * @brief Returns whether two merge keys have identical genotypes.
+ * @param [in] a The first merge key.
+ * @param [in] b The second merge key.
+ * @return Whether the serialised conditions and actions are identical.
+ */
+static bool
+xcsf_merge_equal(const struct MergeKey *a, const struct MergeKey *b)
+{
+    return a->hash == b->hash && a->len == b->len &&
+        memcmp(a->buf, b->buf, a->len) == 0;
+}
+
+/**
+ * @brief Merges classifiers with identical conditions and actions.
+ * @details The most experienced classifier of each group of duplicates
+ * survives and receives the summed numerosity and fitness of the group.
+ * Conditions and actions are compared in their serialised form and must
+ * therefore also have identical self-adaptive mutation rates.
+ * @param [in] xcsf The XCSF data structure.
+ */
+static void
+xcsf_merge_duplicates(struct XCSF *xcsf)
+{
+    const int size = xcsf->pset.size;
+    if (size < 2) {
+        return;
+    }
+    struct MergeKey *keys = malloc(sizeof(struct MergeKey) * size);
+    const struct Clist *iter = xcsf->pset.list;
+    for (int i = 0; i < size; ++i) {
+        struct MergeKey *k = &keys[i];
+        k->cl = iter->cl;
+        k->index = i;
+        k->buf = NULL;
+        k->len = 0;
+        FILE *fp = xcsf_mem_open_write(&k->buf, &k->len);
+        cond_save(xcsf, k->cl, fp);
+        act_save(xcsf, k->cl, fp);
+        xcsf_mem_close_write(fp, &k->buf, &k->len);
+        k->hash = 14695981039346656037ULL;
+        for (size_t j = 0; j < k->len; ++j) {
+            k->hash ^= (unsigned char) k->buf[j];
+            k->hash *= 1099511628211ULL;
+        }
+        iter = iter->next;
+    }
+    qsort(keys, size, sizeof(struct MergeKey), xcsf_merge_cmp);
+    int start = 0;
+    while (start < size) {
+        int end = start + 1;
+        int best = start;
+        while (end < size && xcsf_merge_equal(&keys[start], &keys[end])) {
+            if (keys[end].cl->exp > keys[best].cl->exp) {
+                best = end;
+            }
+            ++end;
+        }
+        struct Cl *survivor = keys[best].cl;
+        for (int i = start; i < end; ++i) {
+            if (i != best) {
+                survivor->num += keys[i].cl->num;
+                survivor->fit += keys[i].cl->fit;
+                keys[i].cl->num = 0;
+            }
+        }
+        start = end;
+    }
+    for (int i = 0; i < size; ++i) {
+        free(keys[i].buf);
+    }
+    free(keys);
+    struct Clist *it = xcsf->pset.list;
+    while (it != NULL) {
+        if (it->cl->num == 0) {
+            cl_free(xcsf, it->cl);
+            it->cl = NULL;
+        }
+        it = it->next;
+    }
+    clset_validate(&xcsf->pset);
+}
+
+/**
+ * @brief Combines the duplicate rules of a merged population and enforces the
+ * population size limit.
+ * @param [in] xcsf The XCSF data structure.
+ */
+void
+xcsf_merge_reduce(struct XCSF *xcsf)
+{
+    xcsf_merge_duplicates(xcsf);
+    clset_pset_mem_reset(xcsf);
+    clset_init(&xcsf->kset);
+    clset_pset_enforce_limit(xcsf);
+    clset_kill(xcsf, &xcsf->kset);
+}
+
+/**
+ * @brief Checks that a loaded XCSF can be merged into another.
+ * @param [in] xcsf The XCSF data structure receiving the population.
+ * @param [in] x The loaded XCSF data structure.
+ * @param [in] filename The name of the file that was loaded.
+ */
+static void
+xcsf_merge_check(const struct XCSF *xcsf, const struct XCSF *x,
+                 const char *filename)
+{
+    if (x->x_dim != xcsf->x_dim || x->y_dim != xcsf->y_dim ||
+        x->n_actions != xcsf->n_actions || x->cond->type != xcsf->cond->type ||
+        x->pred->type != xcsf->pred->type || x->act->type != xcsf->act->type) {
+        printf("Error merging file: %s. Incompatible population.\n",
+               filename);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Merges the populations saved in several files into the current one.
+ * @details The saved parameters must share the problem dimensions and the
+ * condition, prediction, and action types of the current XCSF. Fitnesses are
+ * divided by the number of merged populations (including the current one if
+ * it is not empty) so that they remain comparable with those of a single
+ * population. Duplicate rules are then combined and the population size limit
+ * is enforced with xcsf_merge_reduce(). Tree GP conditions are evaluated with the constants of
+ * the current XCSF.
+ * @param [in] xcsf The XCSF data structure.
+ * @param [in] filenames The names of the files to merge.
+ * @param [in] n The number of files.
+ */
+void
+xcsf_merge(struct XCSF *xcsf, const char **filenames, const int n)
+{
+    const int n_pops = n + ((xcsf->pset.size > 0) ? 1 : 0);
+    if (n_pops < 1) {
+        return;
+    }
+    const double scale = 1. / n_pops;
+    const struct Clist *iter = xcsf->pset.list;
+    while (iter != NULL) {
+        iter->cl->fit *= scale;
+        iter = iter->next;
+    }
+    for (int i = 0; i < n; ++i) {
+        struct XCSF *x = malloc(sizeof(struct XCSF));
+        param_init(x, 1, 1, 1);
+        xcsf_init(x);
+        xcsf_load(x, filenames[i]);
+        xcsf_merge_check(xcsf, x, filenames[i]);
+        iter = x->pset.list;
+        while (iter != NULL) {
+            iter->cl->fit *= scale;
+            clset_add(&xcsf->pset, iter->cl);
+            iter = iter->next;
+        }
+        clset_free(&x->pset);
+        clset_init(&x->pset);
+        xcsf_free(x);
+        param_free(x);
+        free(x);
+    }
+    xcsf_merge_reduce(xcsf);
+}
+
 /**
  * @brief Inserts a new hidden layer before the output layer within all
  * prediction neural networks in the population.
  * @param [in] xcsf The XCSF data structure.
  */
 void
-xcsf_pred_expand(const struct XCSF *xcsf)
+xcsf_pred_expand(struct XCSF *xcsf)
 {
     const struct Clist *iter = xcsf->pset.list;
     while (iter != NULL) {
+        cl_unshare(xcsf, iter->cl);
         pred_neural_expand(xcsf, iter->cl);
         iter->cl->fit = xcsf->INIT_FITNESS;
         iter->cl->err = xcsf->INIT_ERROR;
@@ -154,6 +609,7 @@ xcsf_pred_expand(const struct XCSF *xcsf)
         iter->cl->time = xcsf->time;
         iter = iter->next;
     }
+    clset_pset_mem_reset(xcsf);
 }
 
 /**
@@ -173,6 +629,7 @@ xcsf_ae_to_classifier(struct XCSF *xcsf, const int y_dim, const int n_del)
     while (iter != NULL) {
         free(iter->cl->prediction);
         iter->cl->prediction = calloc(xcsf->y_dim, sizeof(double));
+        cl_unshare(xcsf, iter->cl);
         pred_neural_ae_to_classifier(xcsf, iter->cl, n_del);
         iter->cl->fit = xcsf->INIT_FITNESS;
         iter->cl->err = xcsf->INIT_ERROR;
@@ -180,24 +637,21 @@ xcsf_ae_to_classifier(struct XCSF *xcsf, const int y_dim, const int n_del)
         iter->cl->time = xcsf->time;
         iter = iter->next;
     }
+    clset_pset_mem_reset(xcsf);
 }
 
 /**
  * @brief Stores the current population.
+ * @details The stored classifiers share their conditions, actions, and
+ * predictions with the current population; these are only copied when a
+ * current classifier is subsequently updated.
  * @param [in] xcsf The XCSF data structure.
  */
 void
 xcsf_store_pset(struct XCSF *xcsf)
 {
     clset_kill(xcsf, &xcsf->prev_pset);
-    const struct Clist *iter = xcsf->pset.list;
-    while (iter != NULL) {
-        struct Cl *new = malloc(sizeof(struct Cl));
-        const struct Cl *src = iter->cl;
-        cl_init_copy(xcsf, new, src);
-        clset_add(&xcsf->prev_pset, new);
-        iter = iter->next;
-    }
+    clset_share(xcsf, &xcsf->prev_pset, &xcsf->pset);
 }
 
 /**
@@ -214,4 +668,5 @@ xcsf_retrieve_pset(struct XCSF *xcsf)
     clset_kill(xcsf, &xcsf->pset);
     xcsf->pset = xcsf->prev_pset;
     clset_init(&xcsf->prev_pset);
+    clset_pset_mem_reset(xcsf);
 }
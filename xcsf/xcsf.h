@@ -35,7 +35,7 @@
 #include <string.h>
 
 static const int VERSION_MAJOR = 1; //!< XCSF major version number
-static const int VERSION_MINOR = 2; //!< XCSF minor version number
+static const int VERSION_MINOR = 3; //!< XCSF minor version number
 static const int VERSION_BUILD = 0; //!< XCSF build version number
 
 /**
@@ -59,6 +59,8 @@ struct Cl {
     int action; //!< Current classifier action
     int age; //!< Total number of times match testing been performed
     int mtotal; //!< Total number of times actually matched an input
+    struct Cl *twin; //!< Stored classifier sharing structures copy-on-write
+    bool pinned; //!< Whether shared structures are being read by a writer
 };
 
 /**
@@ -94,6 +96,11 @@ struct XCSF {
     struct ArgsEA *ea; //!< EA parameters
     struct EnvVtbl const *env_vptr; //!< Functions acting on environments
     void *env; //!< Environment structure (for built-in problems)
+    struct Checkpoint *checkpoint; //!< Periodic checkpointing state
+    struct EaAsync *ea_async; //!< Asynchronous EA state
+    struct Publish *publish; //!< Published population snapshots
+    struct Prof *prof; //!< Per-phase timers and event counters
+    size_t pset_mem; //!< Bytes of memory used by the population set
     double error; //!< Average system error
     double mset_size; //!< Average match set size
     double aset_size; //!< Average action set size
@@ -124,9 +131,19 @@ struct XCSF {
     int OMP_NUM_THREADS; //!< Number of threads for parallel processing
     int MAX_TRIALS; //!< Number of problem instances to run in one experiment
     int PERF_TRIALS; //!< Number of problem instances to avg performance output
+    int CHECKPOINT_TRIALS; //!< Number of trials between checkpoints (0=off)
+    int PUBLISH_TRIALS; //!< Number of trials between published snapshots
+    int TRACE_SIZE; //!< Number of spans in the trace ring buffer (0=off)
     int POP_SIZE; //!< Maximum number of micro-classifiers in the population
+    int POP_MEM_SIZE; //!< Maximum population memory in kilobytes (0=off)
+    int ISLANDS; //!< Number of populations trained in parallel
+    int MIGRATION_TRIALS; //!< Number of trials between island migrations
+    int MIGRATION_SIZE; //!< Number of classifiers each island emigrates
     int LOSS_FUNC; //!< Which loss/error function to apply
     int TELETRANSPORTATION; //!< Maximum steps for a multi-step problem
+    int REPLAY_SIZE; //!< Number of transitions in the replay buffer (0=off)
+    int REPLAY_BATCH; //!< Number of transitions replayed per step
+    int N_ENVS; //!< Number of environment instances stepped in lockstep
     int THETA_DEL; //!< Min experience before fitness used during deletion
     int M_PROBATION; //!< Trials since creation a cl must match at least 1 input
     int THETA_SUB; //!< Minimum experience of a classifier to become a subsumer
@@ -134,6 +151,8 @@ struct XCSF {
     bool SET_SUBSUMPTION; //!< Whether to perform match set subsumption
     bool STATEFUL; //!< Whether classifiers should retain state across trials
     bool COMPACTION; //!< if sys err < E0: largest of 2 roulette spins deleted
+    bool PROFILE; //!< Whether to record per-phase timers and event counters
+    bool PROFILE_HW; //!< Whether to also sample hardware performance counters
 };
 
 /**
@@ -153,6 +172,33 @@ xcsf_load(struct XCSF *xcsf, const char *filename);
 size_t
 xcsf_save(const struct XCSF *xcsf, const char *filename);
 
+void
+xcsf_merge(struct XCSF *xcsf, const char **filenames, const int n);
+
+void
+xcsf_merge_reduce(struct XCSF *xcsf);
+
+size_t
+xcsf_deserialise(struct XCSF *xcsf, const char *buf, const size_t len);
+
+FILE *
+xcsf_mem_open_write(char **buf, size_t *len);
+
+void
+xcsf_mem_close_write(FILE *fp, char **buf, size_t *len);
+
+FILE *
+xcsf_mem_open_read(const char *buf, const size_t len);
+
+size_t
+xcsf_serialise(const struct XCSF *xcsf, char **buf, size_t *len);
+
+size_t
+xcsf_serialise_params(const struct XCSF *xcsf, char **buf, size_t *len);
+
+size_t
+xcsf_serialise_pset(const struct XCSF *xcsf, char **buf, size_t *len);
+
 void
 xcsf_free(struct XCSF *xcsf);
 
@@ -167,7 +213,7 @@ void
 xcsf_ae_to_classifier(struct XCSF *xcsf, const int y_dim, const int n_del);
 
 void
-xcsf_pred_expand(const struct XCSF *xcsf);
+xcsf_pred_expand(struct XCSF *xcsf);
 
 void
 xcsf_retrieve_pset(struct XCSF *xcsf);